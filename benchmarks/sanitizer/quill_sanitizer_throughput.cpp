@@ -0,0 +1,56 @@
+#include "quill/Fmt.h"
+#include "quill/Sanitizer.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static constexpr size_t total_iterations = 4'000'000;
+
+/**
+ * Measures the throughput of the sanitizer on typical formatted log messages
+ */
+void run_benchmark(char const* name, std::vector<std::string> const& records)
+{
+  quill::SanitizerConfig cfg;
+  cfg.set_redacted_digit_run(13);
+  cfg.add_redacted_literal("sk_live_");
+  quill::Sanitizer sanitizer{cfg};
+
+  std::vector<quill::fmt_buffer_t> buffers(records.size());
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    buffers[i].append(records[i].data(), records[i].data() + records[i].size());
+  }
+
+  size_t total_bytes{0};
+  size_t checksum{0};
+
+  auto const start_time = std::chrono::steady_clock::now();
+  for (size_t iteration = 0; iteration < total_iterations; ++iteration)
+  {
+    quill::fmt_buffer_t const& buffer = buffers[iteration % buffers.size()];
+    total_bytes += buffer.size();
+    checksum += sanitizer.sanitize(buffer).size();
+  }
+  auto const end_time = std::chrono::steady_clock::now();
+
+  auto const delta_d = std::chrono::duration_cast<std::chrono::duration<double>>(end_time - start_time).count();
+
+  std::cout << fmtquill::format("{:<20} {:.2f} million msgs/sec, {:.2f} GB/sec (checksum {})\n", name,
+                                total_iterations / delta_d / 1e6, total_bytes / delta_d / 1e9, checksum);
+}
+
+int main()
+{
+  std::string const prefix{"12:03:37.123456789 [140736] main.cpp:42                LOG_INFO      root "};
+
+  run_benchmark("clean", {prefix + "Processing order for customer account with status ok and no issues\n",
+                          prefix + "Request completed successfully, returning the cached response to the client\n"});
+
+  run_benchmark("control characters", {prefix + "User supplied value: first line\nsecond line\r\n",
+                                       prefix + "Terminal escape \x1b[31mred\x1b[0m text in the input\n"});
+
+  run_benchmark("redaction", {prefix + "Charging card 4111 1111 1111 1111 with key sk_live_abcdef\n",
+                              prefix + "Payment token 5500-0000-0000-0004 accepted for the order\n"});
+}
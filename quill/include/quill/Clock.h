@@ -51,6 +51,7 @@ public:
   using rep = duration::rep;
   using period = duration::period;
   using time_point = std::chrono::time_point<Clock, duration>;
+  using DriftStats = detail::RdtscClock::DriftStats;
   static constexpr bool is_steady = false;
 
   /**
@@ -90,5 +91,16 @@ public:
     return time_point{std::chrono::nanoseconds{
       detail::LogManagerSingleton::instance().log_manager().time_since_epoch(rdtsc.value())}};
   }
+
+  /**
+   * Returns the drift between the TSC derived time and the system wall clock observed by the
+   * backend logging thread each time it resyncs the TSC clock
+   * @warning all the values are `0` when TimestampClockType::Tsc is not enabled in Config.h
+   * @return the drift statistics
+   */
+  QUILL_NODISCARD static DriftStats drift_stats() noexcept
+  {
+    return detail::LogManagerSingleton::instance().log_manager().rdtsc_drift_stats();
+  }
 };
 } // namespace quill
\ No newline at end of file
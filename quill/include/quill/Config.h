@@ -166,7 +166,7 @@ struct Config
 
   /**
    * Sets the clock type that will be used to obtain the timestamp.
-   * Options: rdtsc or system clock.
+   * Options: rdtsc, system or coarse clock.
    *
    * - rdtsc mode:
    *   TSC clock provides better performance on the caller thread.
@@ -181,9 +181,16 @@ struct Config
    * - system mode:
    *   `std::chrono::system_clock::now()` is used to obtain the timestamp.
    *
+   * - coarse mode:
+   *   `CLOCK_REALTIME_COARSE` is used to obtain the timestamp on linux. It is cheaper than the
+   *   system clock and requires no calibration, but the precision is limited to the kernel tick,
+   *   typically 1-4 milliseconds. On other platforms it falls back to the system clock.
+   *
    * By default, rdtsc mode is enabled.
    *
-   * @note You need to have an invariant TSC for this mode to work correctly. Otherwise, use `TimestampClockType::System`.
+   * @note You need to have an invariant TSC for this mode to work correctly. When the TSC is not
+   * reliable on the running machine, loggers requesting `TimestampClockType::Tsc` fall back to
+   * `TimestampClockType::System`.
    */
   TimestampClockType default_timestamp_clock_type = TimestampClockType::Tsc;
 
@@ -215,6 +222,30 @@ struct Config
    */
   std::chrono::milliseconds rdtsc_resync_interval = std::chrono::milliseconds{500};
 
+  /**
+   * This option is only applicable if the RDTSC clock is enabled.
+   *
+   * The TSC frequency is read from the CPU when available. Otherwise, it is calibrated by spinning
+   * for about 130ms the first time the RDTSC clock is used.
+   *
+   * When a path is set here, the calibration result is stored in this file and reused on the next
+   * run after a quick validation, avoiding the full calibration on startup.
+   * The file is recalibrated and overwritten when the validation fails.
+   */
+  std::string rdtsc_calibration_cache_path;
+
+  /**
+   * This option is only applicable if the RDTSC clock is enabled.
+   *
+   * When set to a non-zero value, the backend thread measures how far the TSC derived time drifted
+   * from the system wall clock on each resync and adapts the resync interval to keep the drift
+   * within this target. `rdtsc_resync_interval` is then used as the initial and the maximum interval.
+   * The observed drift is available via `quill::Clock::drift_stats()`.
+   *
+   * When zero, the resync interval is fixed to `rdtsc_resync_interval`.
+   */
+  std::chrono::nanoseconds rdtsc_accuracy_target = std::chrono::nanoseconds{0};
+
   /**
    * Quill uses an unbounded/bounded SPSC queue per spawned thread to forward the log messages to
    * the backend thread. During high logging activity, if the backend thread cannot consume logs
@@ -243,5 +274,71 @@ struct Config
    * @note This option is only supported on Linux.
    */
   bool enable_huge_pages_hot_path{false};
+
+  /**
+   * The size of the huge pages arena in bytes, used when enable_huge_pages_hot_path is true.
+   *
+   * By default each queue maps its own huge pages, which wastes most of a 2 MiB page for a
+   * small queue and can fail whenever a new thread logs. When this is not zero the huge pages
+   * are reserved once in quill::start() and the queues are carved from them, quill::start()
+   * throws if they are not available. Queues that do not fit use normal pages.
+   *
+   * Each thread needs twice the default_queue_capacity, e.g. 8 threads with the default capacity
+   * need 2 MiB.
+   */
+  size_t huge_pages_arena_size{0};
+
+  /**
+   * The number of thread contexts of exited threads that are kept for new threads.
+   *
+   * Each thread that logs gets a thread context with its own queue. When a thread exits and its
+   * queue is empty the backend thread puts the context in a pool, the next new thread takes it
+   * from there instead of allocating and pre-faulting a new queue. This makes thread pools that
+   * recycle their workers cheap. Contexts whose unbounded queue grew are released instead.
+   *
+   * Set to 0 to disable the pool.
+   */
+  uint32_t thread_context_pool_capacity{8};
+
+  /**
+   * A limit in bytes for the memory of all the logging buffers of the process: the unbounded
+   * queues of the caller threads, the transit event buffers and the backtrace storage.
+   *
+   * The first queue of each thread is always allocated, the limit applies when a queue grows.
+   * What happens to a message that does not fit is set by memory_budget_policy. The backend
+   * thread never waits, when the limit is reached it stops reading a queue until its transit
+   * buffer is drained and keeps fewer backtrace messages.
+   *
+   * The current usage is available via quill::memory_usage(). Set to 0 for no limit.
+   *
+   * @note Only used with the unbounded queues, the bounded queues never grow
+   */
+  size_t memory_budget{0};
+
+  /**
+   * What happens to a message when its queue is full and the memory_budget does not allow the
+   * queue to grow. Dropped messages are reported via the backend_thread_notification_handler.
+   */
+  MemoryBudgetPolicy memory_budget_policy{MemoryBudgetPolicy::Block};
+
+  /**
+   * Drops low value log messages on the caller threads when the backend thread falls behind.
+   *
+   * After each log message and before dropping one the caller thread checks the occupancy of
+   * its queue. Above
+   * load_shedding_debug_watermark the TraceL3 to Debug messages of that thread are dropped and
+   * above load_shedding_info_watermark also the Info messages. The level is restored once the
+   * occupancy falls load_shedding_hysteresis below the watermark. The dropped messages are
+   * reported via the backend_thread_notification_handler.
+   *
+   * The watermarks are in percent of the capacity of the queue, for the unbounded queues of
+   * the capacity of the current queue, which grows when it is full.
+   * They must satisfy load_shedding_hysteresis <= load_shedding_debug_watermark <=
+   * load_shedding_info_watermark <= 100.
+   */
+  bool enable_load_shedding{false};
+  uint32_t load_shedding_debug_watermark{50};
+  uint32_t load_shedding_info_watermark{75};
+  uint32_t load_shedding_hysteresis{20};
 };
 } // namespace quill
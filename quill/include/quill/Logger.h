@@ -16,12 +16,15 @@
 #include "quill/detail/Serialize.h"
 #include "quill/detail/ThreadContext.h"
 #include "quill/detail/ThreadContextCollection.h"
+#include "quill/detail/misc/CoarseClock.h"
+#include "quill/detail/misc/MemoryBudget.h"
 #include "quill/detail/misc/Rdtsc.h"
 #include "quill/detail/misc/TypeTraitsCopyable.h"
 #include "quill/detail/misc/Utilities.h"
 #include <atomic>
 #include <cstdint>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace quill
@@ -88,7 +91,19 @@ public:
       return false;
     }
 
-    return log_statement_level >= log_level();
+    if (log_statement_level < log_level())
+    {
+      return false;
+    }
+
+    if constexpr (log_statement_level <= LogLevel::Info)
+    {
+      return _is_above_min_log_level(log_statement_level);
+    }
+    else
+    {
+      return true;
+    }
   }
 
   /**
@@ -106,7 +121,12 @@ public:
       }
     }
 
-    return log_statement_level >= log_level();
+    if (log_statement_level < log_level())
+    {
+      return false;
+    }
+
+    return (log_statement_level > LogLevel::Info) || _is_above_min_log_level(log_statement_level);
   }
 
   /**
@@ -120,6 +140,113 @@ public:
    */
   template <typename TMacroMetadata, typename TFormatString, typename... FmtArgs>
   QUILL_ALWAYS_INLINE_HOT void log(LogLevel dynamic_log_level, TFormatString format_string, FmtArgs&&... fmt_args)
+  {
+    this->template _log<RuntimeClockPolicy, TMacroMetadata>(dynamic_log_level, format_string,
+                                                            std::forward<FmtArgs>(fmt_args)...);
+  }
+
+  /**
+   * Init a backtrace for this logger.
+   * Stores messages logged with LOG_BACKTRACE in a ring buffer messages and displays them later on demand.
+   * @param capacity The max number of messages to store in the backtrace
+   * @param backtrace_flush_level If this loggers logs any message higher or equal to this severity level the backtrace will also get flushed.
+   * Default level is None meaning the user has to call flush_backtrace explicitly
+   */
+  void init_backtrace(uint32_t capacity, LogLevel backtrace_flush_level = LogLevel::None)
+  {
+    assert(!_is_invalidated.load(std::memory_order_acquire) &&
+           "Invalidated loggers can not be used");
+
+    // we do not care about the other fields, except quill::MacroMetadata::Event::InitBacktrace
+    struct
+    {
+      constexpr quill::MacroMetadata operator()() const noexcept
+      {
+        return quill::MacroMetadata{
+          "",    "",   "", "", "{}", LogLevel::Critical, quill::MacroMetadata::Event::InitBacktrace,
+          false, false};
+      }
+    } anonymous_log_message_info;
+
+    // we pass this message to the queue and also pass capacity as arg
+    this->template log<decltype(anonymous_log_message_info)>(quill::LogLevel::None,
+                                                             QUILL_FMT_STRING("{}"), capacity);
+
+    // Also store the desired flush log level
+    _logger_details.set_backtrace_flush_level(backtrace_flush_level);
+  }
+
+  /**
+   * Dump any stored backtrace messages
+   */
+  void flush_backtrace()
+  {
+    assert(!_is_invalidated.load(std::memory_order_acquire) &&
+           "Invalidated loggers can not be used");
+
+    // we do not care about the other fields, except quill::MacroMetadata::Event::Flush
+    struct
+    {
+      constexpr quill::MacroMetadata operator()() const noexcept
+      {
+        return quill::MacroMetadata{
+          "",    "",   "", "", "", LogLevel::Critical, quill::MacroMetadata::Event::FlushBacktrace,
+          false, false};
+      }
+    } anonymous_log_message_info;
+
+    // we pass this message to the queue
+    this->template log<decltype(anonymous_log_message_info)>(quill::LogLevel::None, QUILL_FMT_STRING(""));
+  }
+
+  /**
+   * @return the timestamp clock type of this logger
+   */
+  QUILL_NODISCARD TimestampClockType timestamp_clock_type() const noexcept
+  {
+    return _logger_details.timestamp_clock_type();
+  }
+
+protected:
+  /**
+   * Marker clock policy, the clock is selected at runtime based on the timestamp clock type
+   */
+  struct RuntimeClockPolicy
+  {
+  };
+
+  /**
+   * @return the current timestamp using the given clock policy
+   */
+  template <typename TClockPolicy>
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT uint64_t _timestamp() const
+  {
+    if constexpr (std::is_same_v<TClockPolicy, RuntimeClockPolicy>)
+    {
+      return (_logger_details.timestamp_clock_type() == TimestampClockType::Tsc) ? quill::detail::rdtsc()
+        : (_logger_details.timestamp_clock_type() == TimestampClockType::System)
+        ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count())
+        : (_logger_details.timestamp_clock_type() == TimestampClockType::Coarse)
+        ? quill::detail::coarse_time_since_epoch()
+        : _custom_timestamp_clock->now();
+    }
+    else
+    {
+      return TClockPolicy::now();
+    }
+  }
+
+  /**
+   * Push a log message to the spsc queue to be logged by the backend thread.
+   * @tparam TClockPolicy the clock policy used to obtain the timestamp, RuntimeClockPolicy to
+   * select the clock based on the logger's timestamp clock type
+   * @param format_string format
+   * @param fmt_args arguments
+   */
+  template <typename TClockPolicy, typename TMacroMetadata, typename TFormatString, typename... FmtArgs>
+  QUILL_ALWAYS_INLINE_HOT void _log(LogLevel dynamic_log_level, TFormatString format_string, FmtArgs&&... fmt_args)
   {
     assert(!_is_invalidated.load(std::memory_order_acquire) && "Invalidated loggers can not log");
 
@@ -186,8 +313,18 @@ public:
     }
 
     // request this size from the queue
-    std::byte* write_buffer =
-      thread_context->spsc_queue<QUILL_QUEUE_TYPE>().prepare_write(static_cast<uint32_t>(total_size));
+    bool memory_budget_exceeded;
+    std::byte* write_buffer = _prepare_write(
+      thread_context->spsc_queue<QUILL_QUEUE_TYPE>(), static_cast<uint32_t>(total_size),
+      (macro_metadata.level() == quill::LogLevel::Dynamic) ? dynamic_log_level : macro_metadata.level(),
+      memory_budget_exceeded);
+
+    if (QUILL_UNLIKELY(memory_budget_exceeded))
+    {
+      // the queue is full and can not grow, the message is dropped
+      detail::MemoryBudget::instance().increment_dropped_messages();
+      return;
+    }
 
     if constexpr (QUILL_QUEUE_TYPE == detail::QueueType::UnboundedNoMaxLimit)
     {
@@ -224,6 +361,13 @@ public:
       }
     }
 
+    if (_thread_context_collection.config().enable_load_shedding)
+    {
+      // checked by should_log() on the next log statement of this thread
+      thread_context->update_min_log_level(thread_context->spsc_queue<QUILL_QUEUE_TYPE>(),
+                                           _thread_context_collection.config());
+    }
+
     // we have enough space in this buffer, and we will write to the buffer
 
     // Then write the pointer to the LogDataNode. The LogDataNode has all details on how to
@@ -238,13 +382,7 @@ public:
 
     new (write_buffer) detail::Header(
       detail::get_metadata_and_format_fn<is_printf_format, TMacroMetadata, FmtArgs...>,
-      std::addressof(_logger_details),
-      (_logger_details.timestamp_clock_type() == TimestampClockType::Tsc) ? quill::detail::rdtsc()
-        : (_logger_details.timestamp_clock_type() == TimestampClockType::System)
-        ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
-                                  std::chrono::system_clock::now().time_since_epoch())
-                                  .count())
-        : _custom_timestamp_clock->now());
+      std::addressof(_logger_details), _timestamp<TClockPolicy>());
 
     write_buffer += sizeof(detail::Header);
 
@@ -267,63 +405,71 @@ public:
   }
 
   /**
-   * Init a backtrace for this logger.
-   * Stores messages logged with LOG_BACKTRACE in a ring buffer messages and displays them later on demand.
-   * @param capacity The max number of messages to store in the backtrace
-   * @param backtrace_flush_level If this loggers logs any message higher or equal to this severity level the backtrace will also get flushed.
-   * Default level is None meaning the user has to call flush_backtrace explicitly
+   * Requests space from the queue of the caller thread. The unbounded queues also get the log
+   * level, it decides if the queue may grow when a memory budget is set
+   * @param queue the queue of the caller thread
+   * @param nbytes number of bytes
+   * @param log_level the log level of the message
+   * @param memory_budget_exceeded set to true when the queue is full and could not grow
+   * @return the write position or nullptr
    */
-  void init_backtrace(uint32_t capacity, LogLevel backtrace_flush_level = LogLevel::None)
+  template <typename TQueue>
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT static std::byte* _prepare_write(TQueue& queue, uint32_t nbytes, LogLevel log_level,
+                                                                    bool& memory_budget_exceeded)
   {
-    assert(!_is_invalidated.load(std::memory_order_acquire) &&
-           "Invalidated loggers can not be used");
-
-    // we do not care about the other fields, except quill::MacroMetadata::Event::InitBacktrace
-    struct
+    if constexpr (std::is_same_v<TQueue, detail::UnboundedQueue>)
     {
-      constexpr quill::MacroMetadata operator()() const noexcept
-      {
-        return quill::MacroMetadata{
-          "",    "",   "", "", "{}", LogLevel::Critical, quill::MacroMetadata::Event::InitBacktrace,
-          false, false};
-      }
-    } anonymous_log_message_info;
-
-    // we pass this message to the queue and also pass capacity as arg
-    this->template log<decltype(anonymous_log_message_info)>(quill::LogLevel::None,
-                                                             QUILL_FMT_STRING("{}"), capacity);
-
-    // Also store the desired flush log level
-    _logger_details.set_backtrace_flush_level(backtrace_flush_level);
+      std::byte* write_buffer = queue.prepare_write(nbytes, log_level);
+      memory_budget_exceeded = (write_buffer == nullptr) && queue.memory_budget_exceeded();
+      return write_buffer;
+    }
+    else
+    {
+      (void)log_level;
+      memory_budget_exceeded = false;
+      return queue.prepare_write(nbytes);
+    }
   }
 
   /**
-   * Dump any stored backtrace messages
+   * Checks the minimum log level of the caller thread when load shedding is enabled
+   * @param log_statement_level The log level of the log statement to be logged
+   * @return false when the log statement is dropped
    */
-  void flush_backtrace()
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT bool _is_above_min_log_level(LogLevel log_statement_level) const noexcept
   {
-    assert(!_is_invalidated.load(std::memory_order_acquire) &&
-           "Invalidated loggers can not be used");
+    if (!_thread_context_collection.config().enable_load_shedding)
+    {
+      return true;
+    }
 
-    // we do not care about the other fields, except quill::MacroMetadata::Event::Flush
-    struct
+    detail::ThreadContext* const thread_context =
+      _thread_context_collection.local_thread_context<QUILL_QUEUE_TYPE>();
+
+    if (QUILL_LIKELY(log_statement_level >= thread_context->min_log_level()))
     {
-      constexpr quill::MacroMetadata operator()() const noexcept
-      {
-        return quill::MacroMetadata{
-          "",    "",   "", "", "", LogLevel::Critical, quill::MacroMetadata::Event::FlushBacktrace,
-          false, false};
-      }
-    } anonymous_log_message_info;
+      return true;
+    }
 
-    // we pass this message to the queue
-    this->template log<decltype(anonymous_log_message_info)>(quill::LogLevel::None, QUILL_FMT_STRING(""));
+    // the level is otherwise only updated when a message is pushed, a thread logging only below
+    // the raised level has to recheck the occupancy to see that the backend drained its queue
+    thread_context->update_min_log_level(thread_context->spsc_queue<QUILL_QUEUE_TYPE>(),
+                                         _thread_context_collection.config());
+
+    if (log_statement_level >= thread_context->min_log_level())
+    {
+      return true;
+    }
+
+    thread_context->increment_shed_message_counter();
+    return false;
   }
 
 private:
   friend class detail::LoggerCollection;
   friend class detail::LogManager;
 
+protected:
   /**
    * Constructs new logger object
    * @param name the name of the logger
@@ -364,6 +510,7 @@ private:
     }
   }
 
+private:
   void invalidate() { _is_invalidated.store(true, std::memory_order_release); }
 
   QUILL_NODISCARD bool is_invalidated() const noexcept
@@ -384,4 +531,83 @@ private:
   std::atomic<bool> _is_invalidated{false};
 };
 
+/**
+ * Thread safe logger with the clock selected at compile time.
+ *
+ * Logger selects the clock at runtime on each log statement based on its TimestampClockType and
+ * calls the custom TimestampClock via a virtual call. LoggerT inlines the clock read of the given
+ * clock policy instead. A clock policy is any type providing :
+ * - static constexpr TimestampClockType clock_type
+ * - static uint64_t now() noexcept
+ * See quill/clock/ClockPolicy.h for the built-in policies.
+ *
+ * LoggerT must be obtained from quill::create_logger<TClockPolicy>(...), it can also be used as
+ * a Logger* in which case the clock is selected at runtime.
+ *
+ * LoggerT adds no state to Logger, it is owned and destroyed as a Logger so that Logger needs no
+ * virtual destructor.
+ */
+template <typename TClockPolicy>
+class LoggerT : public Logger
+{
+public:
+  /**
+   * Push a log message to the spsc queue to be logged by the backend thread, obtaining the
+   * timestamp from TClockPolicy
+   * @note This function is thread-safe.
+   * @param format_string format
+   * @param fmt_args arguments
+   */
+  template <typename TMacroMetadata, typename TFormatString, typename... FmtArgs>
+  QUILL_ALWAYS_INLINE_HOT void log(LogLevel dynamic_log_level, TFormatString format_string, FmtArgs&&... fmt_args)
+  {
+    this->template _log<TClockPolicy, TMacroMetadata>(dynamic_log_level, format_string,
+                                                      std::forward<FmtArgs>(fmt_args)...);
+  }
+
+private:
+  friend class detail::LoggerCollection;
+
+  /**
+   * Adapts the clock policy to a TimestampClock, used when the clock is selected at runtime for
+   * custom clock policies
+   */
+  class PolicyTimestampClock : public TimestampClock
+  {
+  public:
+    QUILL_NODISCARD uint64_t now() const override { return TClockPolicy::now(); }
+  };
+
+  /**
+   * Constructs a new logger object with multiple handlers
+   */
+  LoggerT(std::string const& name, std::vector<std::shared_ptr<Handler>> const& handlers,
+          detail::ThreadContextCollection& thread_context_collection)
+    : Logger(name, handlers, TClockPolicy::clock_type, _policy_timestamp_clock(), thread_context_collection)
+  {
+    _check_clock_policy();
+  }
+
+  /**
+   * The tsc clock type of a Logger falls back to the system clock when the tsc is not reliable,
+   * the clock of a LoggerT can not fall back
+   * @throws when TClockPolicy can not be used on this machine
+   */
+  static void _check_clock_policy()
+  {
+    if constexpr (TClockPolicy::clock_type == TimestampClockType::Tsc)
+    {
+      if (!detail::RdtscClock::is_tsc_reliable())
+      {
+        QUILL_THROW(QuillError{"The tsc is not reliable on this machine, use a different clock policy"});
+      }
+    }
+  }
+
+  QUILL_NODISCARD static TimestampClock* _policy_timestamp_clock()
+  {
+    static PolicyTimestampClock policy_timestamp_clock;
+    return &policy_timestamp_clock;
+  }
+};
 } // namespace quill
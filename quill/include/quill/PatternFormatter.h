@@ -97,7 +97,17 @@ public:
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT fmt_buffer_t const& format(
     std::chrono::nanoseconds timestamp, std::string_view thread_id, std::string_view thread_name,
     std::string_view process_id, std::string_view logger_name, std::string_view log_level,
-    MacroMetadata const& macro_metadata, transit_event_fmt_buffer_t const& log_msg);
+    MacroMetadata const& macro_metadata, fmtquill::detail::buffer<char> const& log_msg);
+
+  /**
+   * Formats the log message appending it to the given buffer instead of the internal one.
+   * Used by handlers that own their write buffer to avoid copying each formatted message.
+   */
+  QUILL_ATTRIBUTE_HOT void format_to(fmtquill::detail::buffer<char>& out, std::chrono::nanoseconds timestamp,
+                                     std::string_view thread_id, std::string_view thread_name,
+                                     std::string_view process_id, std::string_view logger_name,
+                                     std::string_view log_level, MacroMetadata const& macro_metadata,
+                                     fmtquill::detail::buffer<char> const& log_msg);
 
   QUILL_ATTRIBUTE_HOT std::string_view format_timestamp(std::chrono::nanoseconds timestamp);
 
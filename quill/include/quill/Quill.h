@@ -8,15 +8,22 @@
 #include "quill/TweakMe.h"
 
 #include "quill/Config.h"
+#include "quill/clock/ClockPolicy.h"
 #include "quill/clock/TimestampClock.h"
 #include "quill/detail/LogMacros.h"
 #include "quill/detail/LogManager.h"            // for LogManager
 #include "quill/detail/backend/BackendWorker.h" // for backend_worker_error_h...
 #include "quill/detail/misc/Attributes.h"       // for QUILL_ATTRIBUTE_COLD
 #include "quill/detail/misc/Common.h"           // for Timezone
+#include "quill/handlers/AsyncFileHandler.h"     // for AsyncFileHandler
+#include "quill/handlers/AsyncHandler.h"         // for AsyncHandler
+#include "quill/handlers/BufferedFileHandler.h"  // for BufferedFileHandler
 #include "quill/handlers/FileHandler.h"         // for FilenameAppend, Filena...
+#include "quill/handlers/FlightRecorderHandler.h" // for FlightRecorderHandler
 #include "quill/handlers/JsonFileHandler.h"     // for JsonFileHandler
+#include "quill/handlers/MmapFileHandler.h"     // for MmapFileHandler
 #include "quill/handlers/RotatingFileHandler.h" // for RotatingFileHandler
+#include "quill/handlers/SocketHandler.h"       // for SocketHandler
 #include <cassert>
 #include <chrono>           // for hours, minutes, nanose...
 #include <cstddef>          // for size_t
@@ -182,6 +189,63 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> rotating_file_hand
   fs::path const& base_filename, RotatingFileHandlerConfig const& config = RotatingFileHandlerConfig{},
   FileEventNotifier file_event_notifier = FileEventNotifier{});
 
+/**
+ * Creates a new instance of the AsyncFileHandler.
+ * If the file is already opened the existing handler for this file is returned instead.
+ *
+ * The file is written via io_uring when available or via a dedicated writer thread otherwise,
+ * so that a slow disk does not stall the backend logging thread.
+ *
+ * @note It is possible to remove the file handler and close the associated file by removing all the loggers
+ * associated with this handler with `quill::remove_logger()`
+ *
+ * @param filename the name of the file
+ * @param config configuration for the async file handler
+ * @param file_event_notifier a FileEventNotifier to get callbacks to file events such as before_open, after_open etc
+ * @return a pointer to an async file handler
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> async_file_handler(
+  fs::path const& filename, AsyncFileHandlerConfig const& config = AsyncFileHandlerConfig{},
+  FileEventNotifier file_event_notifier = FileEventNotifier{});
+
+/**
+ * Creates a new instance of the BufferedFileHandler.
+ * If the file is already opened the existing handler for this file is returned instead.
+ *
+ * The log messages are formatted directly into a large user space buffer that is written to
+ * the file with raw write(2) calls, bypassing stdio.
+ *
+ * @note It is possible to remove the file handler and close the associated file by removing all the loggers
+ * associated with this handler with `quill::remove_logger()`
+ *
+ * @param filename the name of the file
+ * @param config configuration for the buffered file handler
+ * @param file_event_notifier a FileEventNotifier to get callbacks to file events such as before_open, after_open etc
+ * @return a pointer to a buffered file handler
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> buffered_file_handler(
+  fs::path const& filename, BufferedFileHandlerConfig const& config = BufferedFileHandlerConfig{},
+  FileEventNotifier file_event_notifier = FileEventNotifier{});
+
+/**
+ * Creates a new instance of the MmapFileHandler.
+ * If the file is already opened the existing handler for this file is returned instead.
+ *
+ * The file is preallocated in chunks and memory mapped, the log messages are copied straight
+ * into the mapping. The size and time based rotation of the RotatingFileHandler is supported.
+ *
+ * @note It is possible to remove the file handler and close the associated file by removing all the loggers
+ * associated with this handler with `quill::remove_logger()`
+ *
+ * @param base_filename the base file name
+ * @param config configuration for the mmap file handler
+ * @param file_event_notifier a FileEventNotifier to get callbacks to file events such as before_open, after_open etc
+ * @return a pointer to a mmap file handler
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> mmap_file_handler(
+  fs::path const& base_filename, MmapFileHandlerConfig const& config = MmapFileHandlerConfig{},
+  FileEventNotifier file_event_notifier = FileEventNotifier{});
+
 /**
  * Creates a new instance of the JsonFileHandler.
  * If the file is already opened the existing handler for this file is returned instead.
@@ -201,6 +265,52 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> json_file_handler(
   fs::path const& filename, JsonFileHandlerConfig const& config = JsonFileHandlerConfig{},
   FileEventNotifier file_event_notifier = FileEventNotifier{});
 
+/**
+ * Creates a new instance of the FlightRecorderHandler.
+ * If the file is already opened the existing handler for this file is returned instead.
+ *
+ * The most recent log messages are kept in a fixed size ring inside a shared memory mapped file
+ * that survives a process crash and can be read with `FlightRecorderHandler::read`.
+ *
+ * @param filename the name of the file
+ * @param config configuration for the flight recorder handler, e.g. the ring capacity
+ * @return a pointer to a flight recorder handler
+ * @throws on windows
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> flight_recorder_handler(
+  fs::path const& filename, FlightRecorderHandlerConfig const& config = FlightRecorderHandlerConfig{});
+
+/**
+ * Creates a new instance of the SocketHandler.
+ * If a handler with the same name already exists the existing handler is returned instead.
+ *
+ * The log messages are sent to a local collector via a unix stream, unix datagram or udp socket.
+ * The messages are packed into frames and sent in batches without blocking the backend thread.
+ *
+ * @param handler_name the name of the handler
+ * @param config configuration for the socket handler, e.g. the socket type and address
+ * @return a pointer to a socket handler
+ * @throws on windows
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> socket_handler(std::string const& handler_name,
+                                                                             SocketHandlerConfig const& config);
+
+/**
+ * Creates a new instance of the AsyncHandler that writes to the given handler on a dedicated
+ * thread, isolating the backend logging thread and the other handlers from a slow handler.
+ *
+ * The log messages are formatted by the backend thread, set the pattern, filters and sanitizer on
+ * the returned handler. Cast it to AsyncHandler to read the dropped and blocked message counts.
+ *
+ * @param handler the handler to write to
+ * @param capacity the size of the ring between the backend thread and the writer thread in bytes
+ * @param overflow_policy whether a log message is dropped or the backend thread waits when the ring is full
+ * @return a pointer to an async handler
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> async_handler(
+  std::shared_ptr<Handler> handler, size_t capacity = 4u * 1024u * 1024u,
+  AsyncHandler::OverflowPolicy overflow_policy = AsyncHandler::OverflowPolicy::Block);
+
 /**
  * Creates a new instance of a NullHandler. The null handler does not do any formatting or output.
  */
@@ -215,7 +325,11 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> null_handler();
  * It is safe calling create_logger("my_logger) and get_logger("my_logger") in different threads but the user has
  * to make sure that the call to create_logger has returned in thread A before calling get_logger in thread B
  *
- * @note: for efficiency prefer storing the returned Logger* when get_logger("...") is used. Multiple calls to ``get_logger(name)`` will slow your code down since it will first use a lock mutex lock and then perform a look up. The advise is to store a ``quill::Logger*`` and use that pointer directly, at least in code hot paths.
+ * @note: for efficiency prefer storing the returned Logger* when get_logger("...") is used. Multiple calls to ``get_logger(name)`` will slow your code down since each call hashes the name and performs a look up. The advise is to store a ``quill::Logger*`` and use that pointer directly, at least in code hot paths.
+ *
+ * @note: the lookup does not lock, so every distinct logger name ever created is retained for the lifetime of the
+ * logging library, also after its logger is removed. Creating a logger with the same name again reuses it, but
+ * creating loggers with ever new names e.g. one per request keeps growing the memory used.
  *
  * @note: safe to call even before even calling `quill:start()` unlike using `get_root_logger()`
  *
@@ -314,6 +428,57 @@ QUILL_NODISCARD Logger* create_logger(std::string const& logger_name,
                                       std::optional<TimestampClockType> timestamp_clock_type = std::nullopt,
                                       std::optional<TimestampClock*> timestamp_clock = std::nullopt);
 
+/**
+ * Creates a new Logger with the clock selected at compile time, using the existing root
+ * logger's handler and formatter pattern.
+ *
+ * The clock read of the returned logger is inlined on the hot path instead of being selected at
+ * runtime. See quill/clock/ClockPolicy.h
+ *
+ * e.g. quill::LoggerT<quill::TscClockPolicy>* logger = quill::create_logger<quill::TscClockPolicy>("logger");
+ *
+ * @tparam TClockPolicy the clock policy, e.g. TscClockPolicy, SystemClockPolicy or a user defined one
+ * @param logger_name The name of the logger to add
+ * @return A pointer to a thread-safe LoggerT object
+ * @throws when the tsc clock policy is used but the tsc is not reliable on this machine
+ */
+template <typename TClockPolicy>
+QUILL_NODISCARD LoggerT<TClockPolicy>* create_logger(std::string const& logger_name)
+{
+  return detail::LogManagerSingleton::instance().log_manager().logger_collection().template create_logger<TClockPolicy>(
+    logger_name, std::vector<std::shared_ptr<Handler>>{});
+}
+
+/**
+ * Creates a new Logger with the clock selected at compile time, using the custom given handler.
+ * @tparam TClockPolicy the clock policy, e.g. TscClockPolicy, SystemClockPolicy or a user defined one
+ * @param logger_name The name of the logger to add
+ * @param handler A pointer the a handler for this logger
+ * @return A pointer to a thread-safe LoggerT object
+ */
+template <typename TClockPolicy>
+QUILL_NODISCARD LoggerT<TClockPolicy>* create_logger(std::string const& logger_name,
+                                                     std::shared_ptr<Handler>&& handler)
+{
+  return detail::LogManagerSingleton::instance().log_manager().logger_collection().template create_logger<TClockPolicy>(
+    logger_name, std::vector<std::shared_ptr<Handler>>{std::move(handler)});
+}
+
+/**
+ * Creates a new Logger with the clock selected at compile time, using the custom given handlers.
+ * @tparam TClockPolicy the clock policy, e.g. TscClockPolicy, SystemClockPolicy or a user defined one
+ * @param logger_name The name of the logger to add
+ * @param handlers A vector of pointers to handlers for this logger
+ * @return A pointer to a thread-safe LoggerT object
+ */
+template <typename TClockPolicy>
+QUILL_NODISCARD LoggerT<TClockPolicy>* create_logger(std::string const& logger_name,
+                                                     std::vector<std::shared_ptr<Handler>>&& handlers)
+{
+  return detail::LogManagerSingleton::instance().log_manager().logger_collection().template create_logger<TClockPolicy>(
+    logger_name, std::move(handlers));
+}
+
 /**
  * Removes the logger. The logger is async removed by the backend logging thread after
  * all pending messages are processed.
@@ -345,4 +510,11 @@ inline void flush() { detail::LogManagerSingleton::instance().log_manager().flus
  */
 void wake_up_logging_thread();
 
+/**
+ * The memory used by the logging buffers of the process, see Config::memory_budget.
+ * This is thread safe and can be called from any thread.
+ * @return the current usage in bytes
+ */
+QUILL_NODISCARD size_t memory_usage() noexcept;
+
 } // namespace quill
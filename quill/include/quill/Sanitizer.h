@@ -0,0 +1,126 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_NODISCARD, QUILL_ATTRIBUTE_HOT
+#include "quill/detail/misc/Common.h"     // for fmt_buffer_t
+#include <array>                          // for array
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint32_t
+#include <string>                         // for string
+#include <utility>                        // for pair
+#include <vector>                         // for vector
+
+namespace quill
+{
+/**
+ * The SanitizerConfig class holds the configuration options for the Sanitizer
+ */
+class SanitizerConfig
+{
+public:
+  /**
+   * @brief Sets whether the control characters, including newlines inside the log message, are
+   * escaped e.g. as "\n" or "\x1B" to prevent log injection. A newline that terminates the log
+   * message is kept. The default value is true.
+   * @param value True to escape the control characters
+   */
+  QUILL_ATTRIBUTE_COLD void set_escape_control_characters(bool value);
+
+  /**
+   * @brief Adds a literal e.g. an api key that is replaced by the redaction mask wherever it
+   * appears in the log message.
+   * @param literal The literal to redact, must not be empty
+   */
+  QUILL_ATTRIBUTE_COLD void add_redacted_literal(std::string literal);
+
+  /**
+   * @brief Redacts runs of at least this many digits e.g. card numbers. A single space or dash
+   * between two digits does not end a run. Only the log message is sanitized, the timestamp and
+   * the other attributes of the pattern e.g. a %Qepoch_ns time format are never redacted.
+   * The default value is 0 which disables it.
+   * @param value The minimum number of digits of a redacted run
+   */
+  QUILL_ATTRIBUTE_COLD void set_redacted_digit_run(size_t value);
+
+  /**
+   * @brief Sets the text that replaces the redacted data. The default value is "****".
+   * @param value The redaction mask
+   */
+  QUILL_ATTRIBUTE_COLD void set_redaction_mask(std::string value);
+
+  /** Getters **/
+  QUILL_NODISCARD bool escape_control_characters() const noexcept { return _escape_control_characters; }
+  QUILL_NODISCARD std::vector<std::string> const& redacted_literals() const noexcept
+  {
+    return _redacted_literals;
+  }
+  QUILL_NODISCARD size_t redacted_digit_run() const noexcept { return _redacted_digit_run; }
+  QUILL_NODISCARD std::string const& redaction_mask() const noexcept { return _redaction_mask; }
+
+private:
+  std::vector<std::string> _redacted_literals;
+  std::string _redaction_mask{"****"};
+  size_t _redacted_digit_run{0};
+  bool _escape_control_characters{true};
+};
+
+/**
+ * Escapes the control characters and redacts sensitive data in a log message. The backend thread
+ * sanitizes the log message before the pattern formatting, so the rest of the pattern is left as it is.
+ *
+ * The log message is scanned once for bytes that may need work, 32 or 16 bytes at a time with
+ * AVX2 or SSE2 when available. A log message that needs no change is returned as it is without
+ * a copy.
+ */
+class Sanitizer
+{
+public:
+  explicit Sanitizer(SanitizerConfig config);
+
+  /**
+   * Sanitizes a log message
+   * @param log_message input log message
+   * @return log_message itself when nothing was changed, otherwise the sanitized log message that
+   * is valid until the next call
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT fmtquill::detail::buffer<char> const& sanitize(
+    fmtquill::detail::buffer<char> const& log_message);
+
+private:
+  /**
+   * @return the position of the first byte in [begin, end) that may need work, or end
+   */
+  QUILL_NODISCARD size_t _find_candidate(char const* data, size_t begin, size_t end) noexcept;
+
+  /**
+   * @return a bit for each byte of the simd chunk at data that may need work
+   */
+  QUILL_NODISCARD uint32_t _candidate_mask(char const* data) const noexcept;
+
+  /**
+   * @return the length of the redacted literal starting at data[pos], or 0
+   */
+  QUILL_NODISCARD size_t _match_literal(char const* data, size_t pos, size_t end) const noexcept;
+
+  /**
+   * @return the end of the digit run starting at data[pos] and its number of digits
+   */
+  QUILL_NODISCARD std::pair<size_t, size_t> _scan_digit_run(char const* data, size_t pos, size_t end) const noexcept;
+
+  void _append_escaped(unsigned char c);
+
+private:
+  SanitizerConfig _config;
+  fmt_buffer_t _output;
+  std::array<bool, 256> _candidates{}; /** bytes that may need work */
+  std::vector<char> _literal_first_bytes;                 /** of the single byte literals */
+  std::vector<std::pair<char, char>> _literal_prefixes; /** first two bytes of the literals */
+  size_t _chunk_end{0};                                 /** end of the last scanned simd chunk */
+  uint32_t _chunk_mask{0};                              /** candidates of the last simd chunk */
+  bool _has_work{false};
+};
+} // namespace quill
@@ -0,0 +1,63 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h"
+#include "quill/detail/misc/CoarseClock.h"
+#include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/Rdtsc.h"
+#include <chrono>
+#include <cstdint>
+
+namespace quill
+{
+/**
+ * Clock policies to be used with LoggerT, obtained via quill::create_logger<TClockPolicy>(...).
+ * The clock read is inlined on the hot path instead of being selected at runtime.
+ *
+ * A user defined clock policy, e.g. for simulations, must provide the same members and set
+ * clock_type to TimestampClockType::Custom. now() must return nanoseconds since epoch and be
+ * thread-safe.
+ */
+
+/**
+ * Uses the TSC counter, converted to wall time by the backend thread
+ */
+struct TscClockPolicy
+{
+  static constexpr TimestampClockType clock_type{TimestampClockType::Tsc};
+
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT static uint64_t now() noexcept { return detail::rdtsc(); }
+};
+
+/**
+ * Uses std::chrono::system_clock
+ */
+struct SystemClockPolicy
+{
+  static constexpr TimestampClockType clock_type{TimestampClockType::System};
+
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT static uint64_t now() noexcept
+  {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count());
+  }
+};
+
+/**
+ * Uses the coarse realtime clock
+ */
+struct CoarseClockPolicy
+{
+  static constexpr TimestampClockType clock_type{TimestampClockType::Coarse};
+
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT static uint64_t now() noexcept
+  {
+    return detail::coarse_time_since_epoch();
+  }
+};
+} // namespace quill
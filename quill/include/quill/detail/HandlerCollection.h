@@ -9,7 +9,9 @@
 #include "quill/handlers/ConsoleHandler.h" // for ConsoleColours
 #include "quill/handlers/FileHandler.h"    // for FilenameAppend
 #include "quill/handlers/StreamHandler.h"  // for StreamHandler
+#include <atomic>                          // for atomic
 #include <chrono>                          // for hours, minutes
+#include <cstdint>                         // for uint64_t
 #include <cstddef>                         // for size_t
 #include <memory>                          // for allocator, unique_ptr
 #include <memory>
@@ -118,6 +120,13 @@ public:
    */
   QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::shared_ptr<Handler> get_handler(std::string const& handler_name);
 
+  /**
+   * Looks up the name of a handler, used for the notifications of the backend thread
+   * @param handler the handler
+   * @return the name of the handler or an empty string if it was not created by name
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::string handler_name(Handler const* handler) const;
+
   /**
    * Subscribe a handler to the vector of active handlers so that the backend thread can see it
    * Called each time a new Logger instance is created. If the Handler already exists then it is not
@@ -136,6 +145,16 @@ public:
    */
   void active_handlers(std::vector<std::weak_ptr<Handler>>& active_handlers_collection) const;
 
+  /**
+   * The version is incremented each time a handler is added or removed, so the backend thread
+   * only copies the active handlers when the version changed
+   * @return the version of the active handlers collection
+   */
+  QUILL_NODISCARD uint64_t active_handlers_version() const noexcept
+  {
+    return _active_handlers_version.load(std::memory_order_acquire);
+  }
+
   /**
    * Called by the backend worker thread only to remove any handlers that are not longer in use
    */
@@ -156,6 +175,9 @@ private:
    */
   std::vector<std::weak_ptr<Handler>> _active_handlers_collection;
 
+  /** Incremented after each change of _active_handlers_collection **/
+  std::atomic<uint64_t> _active_handlers_version{0};
+
   /**
    * Owns all created handlers. Each handler is identified by name
    * For Streamhandlers the name is the filename, they are stored per unique filename so
@@ -16,6 +16,8 @@
 #include "quill/detail/SignalHandler.h" // for init_signal_handler
 #include "quill/detail/ThreadContextCollection.h"
 #include "quill/detail/backend/BackendWorker.h"
+#include "quill/detail/misc/HugePagesArena.h" // for HugePagesArena
+#include "quill/detail/misc/MemoryBudget.h"   // for MemoryBudget
 #include <cassert>
 #include <cstdlib>
 #include <mutex> // for call_once, once_flag
@@ -168,6 +170,8 @@ public:
       (logger_details->timestamp_clock_type() == TimestampClockType::Tsc) ? quill::detail::rdtsc()
         : (logger_details->timestamp_clock_type() == TimestampClockType::System)
         ? static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count())
+        : (logger_details->timestamp_clock_type() == TimestampClockType::Coarse)
+        ? quill::detail::coarse_time_since_epoch()
         : default_logger->_custom_timestamp_clock->now());
 
     write_buffer += sizeof(detail::Header);
@@ -198,6 +202,14 @@ public:
   QUILL_ATTRIBUTE_COLD void inline start_backend_worker(bool with_signal_handler,
                                                         std::initializer_list<int> const& catchable_signals)
   {
+    MemoryBudget::instance().configure(_config.memory_budget, _config.memory_budget_policy);
+
+    if (_config.enable_huge_pages_hot_path && (_config.huge_pages_arena_size != 0))
+    {
+      // reserve the huge pages for the queues before any thread logs
+      HugePagesArena::instance().reserve(_config.huge_pages_arena_size);
+    }
+
     if (with_signal_handler)
     {
 #if defined(_WIN32)
@@ -257,6 +269,11 @@ public:
     return _backend_worker.time_since_epoch(rdtsc_value);
   }
 
+  QUILL_NODISCARD RdtscClock::DriftStats rdtsc_drift_stats() const noexcept
+  {
+    return _backend_worker.rdtsc_drift_stats();
+  }
+
 private:
   void _configure()
   {
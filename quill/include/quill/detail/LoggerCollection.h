@@ -7,15 +7,20 @@
 
 #include "quill/Config.h"
 #include "quill/Logger.h" // for Logger
+#include "quill/QuillError.h"
 #include "quill/clock/TimestampClock.h"
 #include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD
 #include "quill/detail/misc/Common.h"
+#include <atomic> // for atomic
+#include <cstddef> // for size_t
 #include <functional>
 #include <initializer_list> // for initializer_list
 #include <memory>           // for unique_ptr
 #include <mutex>
 #include <string>        // for string, hash
+#include <string_view>   // for string_view
 #include <unordered_map> // for unordered_map
+#include <vector>        // for vector
 
 namespace quill
 {
@@ -55,7 +60,10 @@ public:
    * Creates a new logger with default log level info or returns an existing logger with it's
    * cached log levels and handlers if the logger already exists
    * @param logger_name The name of the logger or empty for the root logger
-   * @note this function is slow, consider calling it only once and store the pointer to the logger
+   * @note the lookup does not lock, but it still hashes the name. Consider calling it only once
+   * and store the pointer to the logger
+   * @note each distinct logger name is retained for the lifetime of the collection, also after
+   * the logger is removed, and is reused when a logger with the same name is created again
    * @return a Logger object or the root logger is logger_name is empty
    */
   QUILL_NODISCARD Logger* get_logger(char const* logger_name = nullptr) const;
@@ -111,8 +119,52 @@ public:
                                         std::vector<std::shared_ptr<Handler>> handlers,
                                         TimestampClockType timestamp_clock_type, TimestampClock* timestamp_clock);
 
+  /**
+   * Create a new logger with the clock selected at compile time
+   * @param logger_name the name of the logger to add
+   * @param handlers handlers for the logger, the root logger handlers are used when empty
+   * @return a pointer to the logger or the existing logger with the same name and clock
+   * @throws when a logger with the same name but a different clock already exists or when the
+   * clock policy can not be used on this machine
+   */
+  template <typename TClockPolicy>
+  QUILL_NODISCARD LoggerT<TClockPolicy>* create_logger(std::string const& logger_name,
+                                                       std::vector<std::shared_ptr<Handler>> handlers)
+  {
+    static_assert(sizeof(LoggerT<TClockPolicy>) == sizeof(Logger),
+                  "LoggerT must not add state, it is owned and destroyed as a Logger");
+
+    LoggerT<TClockPolicy>::_check_clock_policy();
+
+    std::lock_guard<std::recursive_mutex> const lock{_rmutex};
+
+    if (auto const search = _logger_name_map.find(logger_name); search != _logger_name_map.end())
+    {
+      if (QUILL_UNLIKELY(!_has_clock_policy<TClockPolicy>(*search->second)))
+      {
+        QUILL_THROW(QuillError{std::string{"logger already exists with a different clock. name: "} + logger_name});
+      }
+
+      // an existing logger with the same clock only differs from a LoggerT by its type
+      return static_cast<LoggerT<TClockPolicy>*>(search->second.get());
+    }
+
+    if (handlers.empty())
+    {
+      handlers = _root_logger->_logger_details.handlers();
+    }
+
+    // We can't use make_unique since the constructor is private
+    std::unique_ptr<Logger> logger{new LoggerT<TClockPolicy>(logger_name, handlers, _thread_context_collection)};
+
+    _subscribe_handlers(handlers);
+
+    return static_cast<LoggerT<TClockPolicy>*>(_insert_logger(logger_name, std::move(logger)));
+  }
+
   /**
    * Marks a logger for deletion. The logger will asynchronously be removed by the logging thread
+   * @note the name of the logger stays in the lookup table, see get_logger()
    */
   void remove_logger(Logger* logger);
 
@@ -142,6 +194,95 @@ public:
    */
   QUILL_NODISCARD bool remove_invalidated_loggers(std::function<bool(void)> const& check_queues_empty);
 
+  /**
+   * Called by the backend worker thread
+   * @return true if a logger using TimestampClockType::Coarse was ever created
+   */
+  QUILL_NODISCARD bool has_coarse_clock_loggers() const noexcept
+  {
+    return _has_coarse_clock_loggers.load(std::memory_order_acquire);
+  }
+
+private:
+  /**
+   * A logger name published for get_logger(). There is one entry per distinct logger name, it is
+   * kept as long as the collection so that a lookup never reads a freed entry
+   */
+  struct LoggerEntry
+  {
+    LoggerEntry(std::string name, size_t hash) : name(std::move(name)), hash(hash) {}
+
+    std::string const name;
+    size_t const hash;
+    std::atomic<Logger*> logger{nullptr}; /** nullptr once the logger is removed */
+  };
+
+  /**
+   * Open addressing table of the entries that is at most half full. New entries are stored in
+   * place, when the table is full it is replaced by a copy twice the size. The old tables are
+   * kept as a lookup may still be reading them, they add up to less than the current table.
+   */
+  struct LoggerTable
+  {
+    explicit LoggerTable(size_t capacity)
+      : slots(new std::atomic<LoggerEntry*>[capacity]{}), mask(capacity - 1)
+    {
+    }
+
+    std::unique_ptr<std::atomic<LoggerEntry*>[]> slots;
+    size_t const mask;
+    size_t size{0};
+  };
+
+  /**
+   * Lock free lookup of a logger entry
+   * @return the entry or nullptr
+   */
+  QUILL_NODISCARD LoggerEntry* _find_entry(std::string_view logger_name, size_t hash) const noexcept;
+
+  /**
+   * Makes the logger visible to get_logger(), called with _rmutex held
+   */
+  void _publish_logger(std::string const& logger_name, Logger* logger);
+
+  /**
+   * Hides the logger from get_logger(), called with _rmutex held
+   */
+  void _unpublish_logger(std::string const& logger_name) noexcept;
+
+  /**
+   * @return true if the logger reads the same clock as TClockPolicy. The built-in clock types
+   * identify the clock, a custom clock policy is identified by its TimestampClock adapter
+   */
+  template <typename TClockPolicy>
+  QUILL_NODISCARD static bool _has_clock_policy(Logger const& logger) noexcept
+  {
+    if (logger._logger_details.timestamp_clock_type() != TClockPolicy::clock_type)
+    {
+      return false;
+    }
+
+    if constexpr (TClockPolicy::clock_type == TimestampClockType::Custom)
+    {
+      return logger._custom_timestamp_clock == LoggerT<TClockPolicy>::_policy_timestamp_clock();
+    }
+    else
+    {
+      return true;
+    }
+  }
+
+  /**
+   * Registers the handlers, even if they already exist
+   */
+  void _subscribe_handlers(std::vector<std::shared_ptr<Handler>> const& handlers);
+
+  /**
+   * Places the logger in the map
+   * @return the inserted logger or the existing logger with the same name
+   */
+  QUILL_NODISCARD Logger* _insert_logger(std::string const& logger_name, std::unique_ptr<Logger> logger);
+
 private:
   Config const& _config;
   ThreadContextCollection& _thread_context_collection; /**< We need to pass this to each logger */
@@ -149,7 +290,11 @@ private:
   Logger* _root_logger{nullptr}; /**< A pointer to the root logger to avoid lookup */
   mutable std::recursive_mutex _rmutex; /**< Thread safe access to logger map, Mutable to have a const get_logger() function  */
   std::unordered_map<std::string, std::unique_ptr<Logger>> _logger_name_map; /**< map from logger name to the actual logger */
+  std::vector<std::unique_ptr<LoggerEntry>> _logger_entries; /**< owns the entries of the lookup tables */
+  std::vector<std::unique_ptr<LoggerTable>> _logger_tables; /**< owns the current and the old lookup tables */
+  std::atomic<LoggerTable*> _logger_table{nullptr}; /**< the current lookup table used by get_logger() */
   std::atomic<bool> _has_invalidated_loggers{false};
+  std::atomic<bool> _has_coarse_clock_loggers{false};
 };
 
 } // namespace detail
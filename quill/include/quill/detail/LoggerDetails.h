@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include "quill/LogLevel.h"
 #include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/RdtscClock.h"
 #include "quill/detail/misc/Utilities.h"
 #include <atomic>
 #include <memory>
@@ -30,7 +32,7 @@ public:
    * Constructor
    */
   LoggerDetails(std::string name, std::shared_ptr<Handler> handler, TimestampClockType timestamp_clock_type)
-    : _name(std::move(name)), _timestamp_clock_type(timestamp_clock_type)
+    : _name(std::move(name)), _timestamp_clock_type(_resolve_timestamp_clock_type(timestamp_clock_type))
   {
     _handlers.push_back(std::move(handler));
   }
@@ -39,7 +41,7 @@ public:
    * Constructor
    */
   LoggerDetails(std::string name, std::vector<std::shared_ptr<Handler>> handlers, TimestampClockType timestamp_clock_type)
-    : _name(std::move(name)), _timestamp_clock_type(timestamp_clock_type)
+    : _name(std::move(name)), _timestamp_clock_type(_resolve_timestamp_clock_type(timestamp_clock_type))
   {
     _handlers = std::move(handlers);
   }
@@ -94,6 +96,17 @@ public:
     return _backtrace_flush_level.load(std::memory_order_relaxed);
   }
 
+private:
+  /**
+   * Falls back to the system clock when the tsc clock is requested but the tsc is not reliable
+   */
+  QUILL_NODISCARD static TimestampClockType _resolve_timestamp_clock_type(TimestampClockType timestamp_clock_type) noexcept
+  {
+    return ((timestamp_clock_type == TimestampClockType::Tsc) && !RdtscClock::is_tsc_reliable())
+      ? TimestampClockType::System
+      : timestamp_clock_type;
+  }
+
 private:
   friend class detail::LoggerCollection;
 
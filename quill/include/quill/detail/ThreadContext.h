@@ -7,7 +7,9 @@
 
 #include "quill/TweakMe.h"
 
+#include "quill/Config.h"
 #include "quill/Fmt.h"
+#include "quill/LogLevel.h"
 #include "quill/detail/backend/TransitEventBuffer.h"
 #include "quill/detail/misc/Common.h"
 #include "quill/detail/misc/Os.h"
@@ -47,6 +49,8 @@ public:
     {
       _spsc_queue.emplace<BoundedQueue>(default_queue_capacity, huge_pages);
     }
+
+    _initial_queue_capacity = _queue_capacity();
   }
 
   /**
@@ -151,6 +155,109 @@ public:
    */
   QUILL_NODISCARD bool is_valid() const noexcept { return _valid.load(std::memory_order_relaxed); }
 
+  /**
+   * A context can be reused by a new thread when its queue did not grow
+   * @note Called by the backend thread once the context is invalidated and its queue is empty
+   * @return true if the context can be reused
+   */
+  QUILL_NODISCARD bool is_reusable() const noexcept
+  {
+    return _queue_capacity() == _initial_queue_capacity;
+  }
+
+  /**
+   * Prepares a context of an exited thread for the calling thread. The queue is empty and keeps
+   * its position, the thread information is updated and the counters of the exited thread are
+   * reset so they are not reported for the new thread.
+   * @note Called by the new thread before the context is registered again
+   */
+  void reuse()
+  {
+    _thread_id = fmtquill::format_int(get_thread_id()).str();
+    _thread_name = get_thread_name();
+    _min_log_level = LogLevel::TraceL3;
+    _message_failure_counter.exchange(0, std::memory_order_relaxed);
+    _shed_message_counter.exchange(0, std::memory_order_relaxed);
+    _valid.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * The minimum log level of this thread, raised while its queue is under pressure
+   * @see Config::enable_load_shedding
+   * @note Only used by the caller thread
+   */
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT LogLevel min_log_level() const noexcept
+  {
+    return _min_log_level;
+  }
+
+  /**
+   * Updates the minimum log level from the occupancy of the queue. The level is raised to Info
+   * above the debug watermark and to Warning above the info watermark and it is restored once
+   * the occupancy falls the hysteresis below the watermark.
+   * @note Called by the caller thread after each prepare_write and before dropping a log
+   * statement when load shedding is enabled
+   * @param queue the queue of this thread
+   * @param config the watermarks in percent of the queue capacity
+   */
+  template <typename TQueue>
+  QUILL_ALWAYS_INLINE_HOT void update_min_log_level(TQueue& queue, Config const& config) noexcept
+  {
+    uint64_t const capacity = queue.producer_capacity();
+
+    // the occupancy can only be lower than the cached one, so the reader position is loaded
+    // only when it could change the level
+    uint32_t const refresh_watermark = (_min_log_level == LogLevel::TraceL3)
+      ? config.load_shedding_debug_watermark
+      : (config.load_shedding_debug_watermark - config.load_shedding_hysteresis);
+
+    uint64_t const used = static_cast<uint64_t>(queue.producer_used_bytes(
+                            static_cast<uint32_t>((capacity * refresh_watermark) / 100u))) *
+      100u;
+
+    if (used >= capacity * config.load_shedding_info_watermark)
+    {
+      _min_log_level = LogLevel::Warning;
+    }
+    else if ((used >= capacity * config.load_shedding_debug_watermark) && (_min_log_level < LogLevel::Info))
+    {
+      _min_log_level = LogLevel::Info;
+    }
+
+    if ((_min_log_level == LogLevel::Warning) &&
+        (used < capacity * (config.load_shedding_info_watermark - config.load_shedding_hysteresis)))
+    {
+      _min_log_level = LogLevel::Info;
+    }
+
+    if ((_min_log_level == LogLevel::Info) &&
+        (used < capacity * (config.load_shedding_debug_watermark - config.load_shedding_hysteresis)))
+    {
+      _min_log_level = LogLevel::TraceL3;
+    }
+  }
+
+  /**
+   * Increments the counter of the messages dropped by load shedding
+   */
+  void increment_shed_message_counter() noexcept
+  {
+    _shed_message_counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Called by the backend worker thread
+   * @return the number of messages dropped by load shedding since the last call
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT size_t get_and_reset_shed_message_counter() noexcept
+  {
+    if (QUILL_LIKELY(_shed_message_counter.load(std::memory_order_relaxed) == 0))
+    {
+      return 0;
+    }
+    return _shed_message_counter.exchange(0, std::memory_order_relaxed);
+  }
+
   /**
    * Increments the dropped message counter
    */
@@ -173,12 +280,23 @@ public:
     return _message_failure_counter.exchange(0, std::memory_order_relaxed);
   }
 
+private:
+  QUILL_NODISCARD uint32_t _queue_capacity() const noexcept
+  {
+    return std::holds_alternative<UnboundedQueue>(_spsc_queue)
+      ? std::get<UnboundedQueue>(_spsc_queue).capacity()
+      : std::get<BoundedQueue>(_spsc_queue).capacity();
+  }
+
 private:
   std::variant<std::monostate, UnboundedQueue, BoundedQueue> _spsc_queue; /** queue for this thread, events are pushed here */
   UnboundedTransitEventBuffer _transit_event_buffer;                    /** backend thread buffer */
   std::string _thread_id = fmtquill::format_int(get_thread_id()).str(); /**< cache this thread pid */
   std::string _thread_name = get_thread_name(); /**< cache this thread name */
+  uint32_t _initial_queue_capacity{0}; /**< the queue capacity before any growth */
+  LogLevel _min_log_level{LogLevel::TraceL3}; /**< raised by load shedding, only used by the caller thread */
   std::atomic<bool> _valid{true}; /**< is this context valid, set by the caller, read by the backend worker thread */
   alignas(CACHE_LINE_ALIGNED) std::atomic<size_t> _message_failure_counter{0};
+  std::atomic<size_t> _shed_message_counter{0};
 };
 } // namespace quill::detail
@@ -54,8 +54,8 @@ private:
     ThreadContextWrapper(ThreadContextCollection& thread_context_collection, uint32_t default_queue_capacity,
                          uint32_t initial_transit_event_buffer_capacity, bool huge_pages)
       : _thread_context_collection(thread_context_collection),
-        _thread_context(std::shared_ptr<ThreadContext>(new ThreadContext(
-          queue_type, default_queue_capacity, initial_transit_event_buffer_capacity, huge_pages)))
+        _thread_context(thread_context_collection._acquire_thread_context(
+          queue_type, default_queue_capacity, initial_transit_event_buffer_capacity, huge_pages))
     {
       // We can not use std::make_shared above.
       // Explanation :
@@ -150,6 +150,11 @@ public:
     return thread_context_wrapper.thread_context();
   }
 
+  /**
+   * @return the config the thread contexts are created with
+   */
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT Config const& config() const noexcept { return _config; }
+
   /**
    * Register a newly created thread context.
    * Called by caller threads
@@ -204,6 +209,37 @@ public:
   }
 
 private:
+  /**
+   * Takes a context of an exited thread from the pool or creates a new one
+   * @note Called by the caller threads
+   */
+  QUILL_NODISCARD std::shared_ptr<ThreadContext> _acquire_thread_context(QueueType queue_type, uint32_t default_queue_capacity,
+                                                                         uint32_t initial_transit_event_buffer_capacity,
+                                                                         bool huge_pages)
+  {
+    std::shared_ptr<ThreadContext> thread_context;
+
+    {
+      std::lock_guard<std::mutex> const lock(_mutex);
+
+      if (!_thread_context_pool.empty())
+      {
+        thread_context = std::move(_thread_context_pool.back());
+        _thread_context_pool.pop_back();
+      }
+    }
+
+    if (thread_context)
+    {
+      // only this thread owns the context now
+      thread_context->reuse();
+      return thread_context;
+    }
+
+    return std::shared_ptr<ThreadContext>(
+      new ThreadContext(queue_type, default_queue_capacity, initial_transit_event_buffer_capacity, huge_pages));
+  }
+
   /**
    * Return true if _thread_contexts have changed
    * @note Only accessed by the backend thread
@@ -268,7 +304,7 @@ private:
    * Remove a thread context from our main thread context collection
    * Removing aan invalidated context from the collection will result in ThreadContext as neither
    * the thread or this class will hold the shared pointer anymore
-   * will be using the shared pointer anymore
+   * will be using the shared pointer anymore, unless the context is kept in the pool for reuse
    *
    * @note Only called by the backend thread
    * @param thread_context the pointer to the thread context we are removing
@@ -290,6 +326,13 @@ private:
     assert(thread_context_it->get()->spsc_queue<QUILL_QUEUE_TYPE>().empty() &&
            "Attempting to remove_file a thread context with a non empty queue");
 
+    if ((_thread_context_pool.size() < _config.thread_context_pool_capacity) &&
+        thread_context_it->get()->is_reusable())
+    {
+      // keep the context with its allocated queue for the next new thread
+      _thread_context_pool.push_back(std::move(*thread_context_it));
+    }
+
     _thread_contexts.erase(thread_context_it);
 
     // we don't set changed here as this is called only by the backend thread and it updates
@@ -337,7 +380,8 @@ private:
           // If the thread context is invalid it means the thread that created it has now died.
           // We also want to empty the queue from all LogRecords before removing the thread context
 
-          return !thread_context->is_valid() && thread_context->spsc_queue<QUILL_QUEUE_TYPE>().empty();
+          return !thread_context->is_valid() && thread_context->spsc_queue<QUILL_QUEUE_TYPE>().empty() &&
+            thread_context->transit_event_buffer().empty();
         });
     }
   }
@@ -346,6 +390,7 @@ private:
   Config const& _config;
   std::mutex _mutex; /**< Protect access when register contexts or removing contexts */
   std::vector<std::shared_ptr<ThreadContext>> _thread_contexts; /**< The registered contexts */
+  std::vector<std::shared_ptr<ThreadContext>> _thread_context_pool; /**< Contexts of exited threads for reuse */
 
   /**<
    * A reference to the owned thread contexts that we update when there is any change. We do
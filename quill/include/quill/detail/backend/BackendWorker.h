@@ -18,7 +18,9 @@
 #include "quill/detail/backend/BacktraceStorage.h" // for BacktraceStorage
 #include "quill/detail/backend/TransitEventBuffer.h"
 #include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_HOT
+#include "quill/detail/misc/CoarseClock.h" // for coarse_time_since_epoch
 #include "quill/detail/misc/Common.h"     // for QUILL_LIKELY
+#include "quill/detail/misc/MemoryBudget.h" // for MemoryBudget
 #include "quill/detail/misc/Os.h"         // for set_cpu_affinity, get_thread_id
 #include "quill/detail/misc/RdtscClock.h" // for RdtscClock
 #include "quill/detail/misc/Utilities.h"
@@ -75,6 +77,12 @@ public:
    */
   QUILL_NODISCARD inline uint64_t time_since_epoch(uint64_t rdtsc_value) const;
 
+  /**
+   * Access the rdtsc class drift statistics
+   * @return the drift statistics, all zero when the rdtsc clock is not in use
+   */
+  QUILL_NODISCARD inline RdtscClock::DriftStats rdtsc_drift_stats() const noexcept;
+
   /**
    * Get the backend worker's thread id
    * @return the backend worker's thread id
@@ -121,14 +129,15 @@ private:
    * Deserialize messages from the raw SPSC queue
    * @param thread_context thread context
    * @param ts_now timestamp now
+   * @param coarse_ts_now coarse clock timestamp now, taken together with ts_now
    * @return total events stored in the transit_event_buffer
    */
   template <typename QueueT>
   QUILL_ATTRIBUTE_HOT inline uint32_t _read_queue_messages_and_decode(QueueT& queue, ThreadContext* thread_context,
-                                                                      uint64_t ts_now);
+                                                                      uint64_t ts_now, uint64_t coarse_ts_now);
 
   QUILL_ATTRIBUTE_HOT inline bool _get_transit_event_from_queue(std::byte*& read_pos, ThreadContext* thread_context,
-                                                                uint64_t ts_now);
+                                                                uint64_t ts_now, uint64_t coarse_ts_now);
 
   /**
    * Checks for events in all queues and processes the one with the minimum timestamp
@@ -146,19 +155,36 @@ private:
    */
   QUILL_ATTRIBUTE_HOT inline void _write_transit_event(TransitEvent const& transit_event);
 
+  /**
+   * Reports that a handler became degraded or is no longer degraded
+   * @param handler the handler
+   * @param skipped_messages number of log messages skipped while the handler was degraded
+   */
+  QUILL_ATTRIBUTE_COLD inline void _notify_degradation_change(Handler const* handler, size_t skipped_messages);
+
   /**
    * Process the lowest timestamp from the queues and write it to the log file
    */
   QUILL_ATTRIBUTE_HOT inline bool _process_and_write_single_message(
     ThreadContextCollection::backend_thread_contexts_cache_t const& cached_thread_contexts);
 
+  /**
+   * Copies the active handlers from the handler collection when they changed
+   */
+  QUILL_ATTRIBUTE_HOT inline void _update_active_handlers_cache();
+
   /**
    * Force flush all active Handlers
    */
   QUILL_ATTRIBUTE_HOT inline void _force_flush();
 
   /**
-   * Check for dropped messages - only when bounded queue is used
+   * Flush the active Handlers that have unflushed log messages according to their flush policy
+   */
+  QUILL_ATTRIBUTE_HOT inline void _flush_idle_handlers();
+
+  /**
+   * Check for dropped messages, blocked threads and messages dropped by load shedding
    * @param cached_thread_contexts loaded thread contexts
    */
   QUILL_ATTRIBUTE_HOT inline static void _check_message_failures(
@@ -207,6 +233,7 @@ private:
   std::vector<fmtquill::basic_format_arg<fmtquill::format_context>> _args; /** Format args tmp storage as member to avoid reallocation */
   std::vector<fmtquill::basic_format_arg<fmtquill::printf_context>> _printf_args; /** Format args tmp storage as member to avoid reallocation */
   std::vector<std::weak_ptr<Handler>> _active_handlers_cache;
+  uint64_t _active_handlers_cache_version{0}; /** version of the handler collection in the cache */
 
   BacktraceStorage _backtrace_log_message_storage; /** Stores a vector of backtrace messages per logger name */
   std::unordered_map<std::string, std::pair<std::string, std::vector<std::string>>> _slog_templates; /** Avoid re-formating the same structured template each time */
@@ -252,6 +279,13 @@ QUILL_NODISCARD uint64_t BackendWorker::time_since_epoch(uint64_t rdtsc_value) c
   return rdtsc_clock ? rdtsc_clock->time_since_epoch_safe(rdtsc_value) : 0;
 }
 
+/***/
+RdtscClock::DriftStats BackendWorker::rdtsc_drift_stats() const noexcept
+{
+  RdtscClock const* rdtsc_clock = _rdtsc_clock.load(std::memory_order_acquire);
+  return rdtsc_clock ? rdtsc_clock->drift_stats() : RdtscClock::DriftStats{};
+}
+
 /***/
 void BackendWorker::run()
 {
@@ -352,19 +386,24 @@ std::pair<size_t, size_t> BackendWorker::_populate_transit_event_buffer(
                               .count())
     : 0;
 
+  // the coarse clock lags the system clock by up to a tick, the coarse timestamps are checked against it
+  uint64_t const coarse_ts_now = (_strict_log_timestamp_order && _logger_collection.has_coarse_clock_loggers())
+    ? (coarse_time_since_epoch() / 1'000)
+    : 0;
+
   size_t total_events{0};
   size_t max_events{0};
 
   for (ThreadContext* thread_context : cached_thread_contexts)
   {
     std::visit(
-      [&total_events, &max_events, &thread_context, &ts_now, this](auto& queue)
+      [&total_events, &max_events, &thread_context, &ts_now, &coarse_ts_now, this](auto& queue)
       {
         using T = std::decay_t<decltype(queue)>;
         if constexpr ((std::is_same_v<T, UnboundedQueue>) || (std::is_same_v<T, BoundedQueue>))
         {
           // copy everything from the SPSC queue to the transit event buffer to process it later
-          uint32_t const events = _read_queue_messages_and_decode(queue, thread_context, ts_now);
+          uint32_t const events = _read_queue_messages_and_decode(queue, thread_context, ts_now, coarse_ts_now);
           total_events += events;
 
           if (events > max_events)
@@ -381,7 +420,8 @@ std::pair<size_t, size_t> BackendWorker::_populate_transit_event_buffer(
 
 /***/
 template <typename QueueT>
-uint32_t BackendWorker::_read_queue_messages_and_decode(QueueT& queue, ThreadContext* thread_context, uint64_t ts_now)
+uint32_t BackendWorker::_read_queue_messages_and_decode(QueueT& queue, ThreadContext* thread_context,
+                                                        uint64_t ts_now, uint64_t coarse_ts_now)
 {
   // Note: The producer will commit to this queue when one complete message is written.
   // This means that if we can read something from the queue it will be a full message
@@ -414,7 +454,7 @@ uint32_t BackendWorker::_read_queue_messages_and_decode(QueueT& queue, ThreadCon
 
     std::byte* const read_begin = read_pos;
 
-    bool res = _get_transit_event_from_queue(read_pos, thread_context, ts_now);
+    bool res = _get_transit_event_from_queue(read_pos, thread_context, ts_now, coarse_ts_now);
 
     if (!res)
     {
@@ -448,12 +488,20 @@ uint32_t BackendWorker::_read_queue_messages_and_decode(QueueT& queue, ThreadCon
 }
 
 /***/
-bool BackendWorker::_get_transit_event_from_queue(std::byte*& read_pos, ThreadContext* thread_context, uint64_t ts_now)
+bool BackendWorker::_get_transit_event_from_queue(std::byte*& read_pos, ThreadContext* thread_context,
+                                                  uint64_t ts_now, uint64_t coarse_ts_now)
 {
   // First we want to allocate a new TransitEvent or use an existing one
   // to store the message from the queue
   detail::UnboundedTransitEventBuffer& transit_event_buffer = thread_context->transit_event_buffer();
   TransitEvent* transit_event = transit_event_buffer.back();
+
+  if (QUILL_UNLIKELY(!transit_event))
+  {
+    // the memory budget does not allow the transit buffer to grow, continue once it is drained
+    return false;
+  }
+
   transit_event->thread_id = thread_context->thread_id();
   transit_event->thread_name = thread_context->thread_name();
 
@@ -471,9 +519,11 @@ bool BackendWorker::_get_transit_event_from_queue(std::byte*& read_pos, ThreadCo
     if (!_rdtsc_clock.load(std::memory_order_relaxed))
     {
       // Here we lazy initialise rdtsc clock on the backend thread only if the user decides to use it
-      // Use rdtsc clock based on config. The clock requires a few seconds to init as it is
-      // taking samples first
-      _rdtsc_clock.store(new RdtscClock{_rdtsc_resync_interval}, std::memory_order_release);
+      // Use rdtsc clock based on config. The clock might require some time to init as it is
+      // taking samples first when the tsc frequency is not available from the cpu
+      _rdtsc_clock.store(new RdtscClock{_rdtsc_resync_interval, _config.rdtsc_calibration_cache_path,
+                                        _config.rdtsc_accuracy_target},
+                         std::memory_order_release);
       _last_rdtsc_resync = std::chrono::system_clock::now();
     }
 
@@ -510,6 +560,22 @@ bool BackendWorker::_get_transit_event_from_queue(std::byte*& read_pos, ThreadCo
       return false;
     }
   }
+  else if (transit_event->header.logger_details->timestamp_clock_type() == TimestampClockType::Coarse)
+  {
+    // the coarse timestamps of the current tick are read once the tick has passed
+    if QUILL_UNLIKELY ((coarse_ts_now != 0) && ((transit_event->header.timestamp / 1'000) >= coarse_ts_now))
+    {
+      // We are reading the queues sequentially and to be fair when ordering the messages
+      // we are trying to avoid the situation when we already read the first queue,
+      // and then we missed it when reading the last queue
+
+      // if the message timestamp is greater than our timestamp then we stop reading this queue
+      // for now and we will continue in the next circle
+
+      // we return here and never call transit_event_buffer.push_back();
+      return false;
+    }
+  }
   else if (transit_event->header.logger_details->timestamp_clock_type() == TimestampClockType::Custom)
   {
     // we skip checking against `ts_now`, we can not compare a custom timestamp by
@@ -520,6 +586,17 @@ bool BackendWorker::_get_transit_event_from_queue(std::byte*& read_pos, ThreadCo
   auto const [macro_metadata, format_fns] = transit_event->header.metadata_and_format_fn();
   auto const [format_to_fn, printf_format_to_fn] = format_fns;
 
+  if ((macro_metadata.event() == MacroMetadata::Event::Flush) &&
+      (transit_event->header.logger_details->timestamp_clock_type() != TimestampClockType::Custom))
+  {
+    // a flush also waits for the coarse timestamps of the current tick, so that it is processed
+    // after any coarse log message that was logged before it
+    if QUILL_UNLIKELY ((coarse_ts_now != 0) && ((transit_event->header.timestamp / 1'000) >= coarse_ts_now))
+    {
+      return false;
+    }
+  }
+
   if (macro_metadata.event() != MacroMetadata::Event::Flush)
   {
 #if defined(_WIN32)
@@ -756,7 +833,7 @@ void BackendWorker::_process_transit_event(TransitEvent& transit_event)
     }
     else if (macro_metadata.event() == MacroMetadata::Event::Flush)
     {
-      _handler_collection.active_handlers(_active_handlers_cache);
+      _update_active_handlers_cache();
       _force_flush();
 
       // this is a flush event, so we need to notify the caller to continue now
@@ -787,10 +864,74 @@ void BackendWorker::_write_transit_event(TransitEvent const& transit_event)
 
   for (auto& handler : transit_event.header.logger_details->handlers())
   {
+    if (transit_event.log_level() < handler->get_log_level())
+    {
+      // never written by this handler, it is neither sanitized nor counted as skipped when degraded
+      continue;
+    }
+
+    // only read the clock for handlers with a degradation policy
+    bool const measure_latency = handler->degradation_policy().latency_threshold().count() != 0;
+    std::chrono::steady_clock::time_point write_start{};
+
+    if (QUILL_UNLIKELY(measure_latency))
+    {
+      write_start = std::chrono::steady_clock::now();
+
+      if (handler->is_degraded())
+      {
+        size_t skipped_messages{0};
+
+        if (handler->leave_degraded_mode(write_start, skipped_messages))
+        {
+          _notify_degradation_change(handler.get(), skipped_messages);
+        }
+        else if (handler->skip_degraded_write(transit_event.log_level()))
+        {
+          continue;
+        }
+      }
+    }
+
+    // only the log message is sanitized, the timestamp and the rest of the pattern are left alone
+    Sanitizer* sanitizer = handler->sanitizer();
+    fmtquill::detail::buffer<char> const& log_msg =
+      sanitizer ? sanitizer->sanitize(transit_event.formatted_msg) : transit_event.formatted_msg;
+
+    fmtquill::detail::buffer<char>* direct_write_buffer = handler->direct_write_buffer();
+
+    if (direct_write_buffer && !handler->has_filters())
+    {
+      // the handler owns the write buffer, format straight into it to skip one copy
+      size_t const size_before = direct_write_buffer->size();
+
+      handler->formatter().format_to(
+        *direct_write_buffer, std::chrono::nanoseconds{transit_event.header.timestamp},
+        transit_event.thread_id, transit_event.thread_name, _process_id,
+        transit_event.header.logger_details->name(), transit_event.log_level_as_str(),
+        macro_metadata, log_msg);
+
+      size_t const size = direct_write_buffer->size() - size_before;
+      handler->on_direct_write(transit_event);
+
+      if (handler->record_unflushed_write(size, transit_event.log_level()))
+      {
+        handler->flush_by_backend();
+      }
+
+      if (QUILL_UNLIKELY(measure_latency) &&
+          handler->record_write_latency(write_start, std::chrono::steady_clock::now()))
+      {
+        _notify_degradation_change(handler.get(), 0);
+      }
+
+      continue;
+    }
+
     auto const& formatted_log_message_buffer = handler->formatter().format(
       std::chrono::nanoseconds{transit_event.header.timestamp}, transit_event.thread_id,
       transit_event.thread_name, _process_id, transit_event.header.logger_details->name(),
-      transit_event.log_level_as_str(), macro_metadata, transit_event.formatted_msg);
+      transit_event.log_level_as_str(), macro_metadata, log_msg);
 
     // If all filters are okay we write this message to the file
     if (handler->apply_filters(transit_event.thread_id,
@@ -800,10 +941,60 @@ void BackendWorker::_write_transit_event(TransitEvent const& transit_event)
       // log to the handler, also pass the log_message_timestamp this is only needed in some
       // cases like daily file rotation
       handler->write(formatted_log_message_buffer, transit_event);
+
+      if (handler->record_unflushed_write(formatted_log_message_buffer.size(), transit_event.log_level()))
+      {
+        handler->flush_by_backend();
+      }
+
+      if (QUILL_UNLIKELY(measure_latency) &&
+          handler->record_write_latency(write_start, std::chrono::steady_clock::now()))
+      {
+        _notify_degradation_change(handler.get(), 0);
+      }
     }
   }
 }
 
+/***/
+void BackendWorker::_notify_degradation_change(Handler const* handler, size_t skipped_messages)
+{
+  char ts[24];
+  time_t t = time(nullptr);
+  struct tm p;
+  quill::detail::localtime_rs(std::addressof(t), std::addressof(p));
+  strftime(ts, 24, "%X", std::addressof(p));
+
+  std::string handler_name = _handler_collection.handler_name(handler);
+
+  if (handler_name.empty())
+  {
+    handler_name = "<unnamed>";
+  }
+
+  DegradationPolicy const& degradation_policy = handler->degradation_policy();
+
+  if (handler->is_degraded())
+  {
+    _notification_handler(fmtquill::format(
+      "{} Quill INFO: Handler {} average write latency of {}us exceeded {}us, skipping log messages "
+      "below {} for {}ms",
+      ts, handler_name,
+      std::chrono::duration_cast<std::chrono::microseconds>(handler->write_latency()).count(),
+      degradation_policy.latency_threshold().count(),
+      loglevel_to_string(degradation_policy.min_log_level()),
+      degradation_policy.degraded_duration().count()));
+  }
+  else
+  {
+    _notification_handler(
+      fmtquill::format("{} Quill INFO: Handler {} is no longer degraded, skipped {} log messages "
+                       "below {}",
+                       ts, handler_name, skipped_messages,
+                       loglevel_to_string(degradation_policy.min_log_level())));
+  }
+}
+
 /***/
 bool BackendWorker::_process_and_write_single_message(const ThreadContextCollection::backend_thread_contexts_cache_t& cached_thread_contexts)
 {
@@ -864,7 +1055,7 @@ bool BackendWorker::_process_and_write_single_message(const ThreadContextCollect
 
         std::byte* const read_begin = read_pos;
 
-        _get_transit_event_from_queue(read_pos, tc, 0);
+        _get_transit_event_from_queue(read_pos, tc, 0, 0);
 
         // Finish reading
         assert((read_pos >= read_begin) && "read_buffer should be greater or equal to read_begin");
@@ -888,7 +1079,7 @@ void BackendWorker::_force_flush()
       std::shared_ptr<Handler> h = handler.lock();
       if (h)
       {
-        h->flush();
+        h->flush_by_backend();
       }
     }
 
@@ -896,18 +1087,94 @@ void BackendWorker::_force_flush()
   }
 }
 
+/***/
+void BackendWorker::_update_active_handlers_cache()
+{
+  uint64_t const version = _handler_collection.active_handlers_version();
+
+  if (version != _active_handlers_cache_version)
+  {
+    _handler_collection.active_handlers(_active_handlers_cache);
+    _active_handlers_cache_version = version;
+  }
+}
+
+/***/
+void BackendWorker::_flush_idle_handlers()
+{
+  if (_has_unflushed_messages)
+  {
+    auto const now = std::chrono::steady_clock::now();
+    bool pending_flush_interval{false};
+
+    // flush the handlers with unflushed log messages according to their flush policy
+    for (auto const& handler : _active_handlers_cache)
+    {
+      std::shared_ptr<Handler> h = handler.lock();
+      if (h)
+      {
+        if (h->should_flush_on_idle(now))
+        {
+          h->idle_flush_by_backend();
+        }
+        else
+        {
+          pending_flush_interval |= h->has_pending_flush_interval();
+        }
+      }
+    }
+
+    // keep checking while a flush interval has not elapsed yet
+    _has_unflushed_messages = pending_flush_interval;
+  }
+}
+
 /***/
 void BackendWorker::_check_message_failures(ThreadContextCollection::backend_thread_contexts_cache_t const& cached_thread_contexts,
                                             backend_worker_notification_handler_t const& notification_handler) noexcept
 {
-  if constexpr (QUILL_QUEUE_TYPE == detail::QueueType::UnboundedNoMaxLimit)
+  if constexpr ((QUILL_QUEUE_TYPE == detail::QueueType::UnboundedBlocking) ||
+                (QUILL_QUEUE_TYPE == detail::QueueType::UnboundedNoMaxLimit) ||
+                (QUILL_QUEUE_TYPE == detail::QueueType::UnboundedDropping))
   {
-    // UnboundedNoMaxLimit does not block or drop messages
-    return;
+    size_t const dropped_messages_cnt = MemoryBudget::instance().get_and_reset_dropped_messages();
+
+    if (QUILL_UNLIKELY(dropped_messages_cnt > 0))
+    {
+      char ts[24];
+      time_t t = time(nullptr);
+      struct tm p;
+      quill::detail::localtime_rs(std::addressof(t), std::addressof(p));
+      strftime(ts, 24, "%X", std::addressof(p));
+
+      notification_handler(fmtquill::format(
+        "{} Quill INFO: Memory budget of {} bytes dropped {} log messages", ts,
+        MemoryBudget::instance().limit(), dropped_messages_cnt));
+    }
   }
 
   for (ThreadContext* thread_context : cached_thread_contexts)
   {
+    size_t const shed_messages_cnt = thread_context->get_and_reset_shed_message_counter();
+
+    if (QUILL_UNLIKELY(shed_messages_cnt > 0))
+    {
+      char ts[24];
+      time_t t = time(nullptr);
+      struct tm p;
+      quill::detail::localtime_rs(std::addressof(t), std::addressof(p));
+      strftime(ts, 24, "%X", std::addressof(p));
+
+      notification_handler(fmtquill::format("{} Quill INFO: Load shedding dropped {} log messages from thread {}",
+                                            ts, shed_messages_cnt, thread_context->thread_id()));
+    }
+
+    if constexpr (QUILL_QUEUE_TYPE == detail::QueueType::UnboundedNoMaxLimit)
+    {
+      // UnboundedNoMaxLimit does not block or drop messages
+      continue;
+    }
+
     size_t const failed_messages_cnt = thread_context->get_and_reset_message_failure_counter();
 
     if (QUILL_UNLIKELY(failed_messages_cnt > 0))
@@ -1049,9 +1316,9 @@ void BackendWorker::_main_loop()
   if (total_events == 0)
   {
     // None of the thread local queues had any events to process, this means we have processed
-    // all messages in all queues We force flush all remaining messages
-    _handler_collection.active_handlers(_active_handlers_cache);
-    _force_flush();
+    // all messages in all queues We flush the handlers according to their flush policy
+    _update_active_handlers_cache();
+    _flush_idle_handlers();
 
     // invoke the Handler's periodic loop
     for (auto const& handler : _active_handlers_cache)
@@ -1176,7 +1443,7 @@ void BackendWorker::_exit()
       {
         // we are done, all queues are now empty
         _check_message_failures(cached_thread_contexts, _notification_handler);
-        _handler_collection.active_handlers(_active_handlers_cache);
+        _update_active_handlers_cache();
         _force_flush();
         break;
       }
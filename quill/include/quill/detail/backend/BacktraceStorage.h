@@ -24,17 +24,15 @@ class BaseEvent;
 /**
  * Stores N max messages per logger name in a vector.
  * For simplicity this class is used ONLY by the backend worker thread.
+ * The stored messages are charged to the MemoryBudget, when it is exceeded fewer messages are
+ * kept and the oldest message is replaced instead.
  * We push to the queue a BacktraceCommand event to communicate this from the frontend caller threads
  */
 class BacktraceStorage
 {
 public:
   BacktraceStorage() = default;
-  ~BacktraceStorage()
-  {
-    // we want to clear all messages first, calling deallocate on the free list allocator before destructing
-    _stored_records_map.clear();
-  }
+  ~BacktraceStorage();
 
   /**
    * Stores an object to a vector that maps to logger_name
@@ -81,6 +79,7 @@ private:
     std::string thread_name;
     std::string thread_id;
     TransitEvent transit_event;
+    size_t memory_size{0}; /** The approximate memory charged to the budget */
   };
 
   using StoredRecordsCollection = std::vector<StoredTransitEvent>;
@@ -101,6 +100,12 @@ private:
     StoredRecordsCollection stored_records_collection{}; /** A vector holding stored objects */
   };
 
+private:
+  /**
+   * Removes all stored objects and returns their memory to the budget
+   */
+  static void _clear(StoredRecordsCollection& stored_records_collection);
+
 private:
   /** A map where we store a vector of stored records for each logger name. We use the vectors like a ring buffer and loop around */
   std::unordered_map<std::string, StoredRecordInfo> _stored_records_map;
@@ -27,6 +27,16 @@ namespace quill::detail
  * 3) %Qns - Nanoseconds
  * @note %Qms, %Qus, %Qns specifiers are mutually exclusive
  * e.g given : "%I:%M.%Qms%p" the output would be "03:21.343PM"
+ *
+ * Additionally the following fixed layout formats are supported. They bypass strftime entirely
+ * and must be used on their own as the whole format string :
+ * 1) %Qepoch_ms - Milliseconds since epoch e.g "1587161887987"
+ * 2) %Qepoch_us - Microseconds since epoch e.g "1587161887987654"
+ * 3) %Qepoch_ns - Nanoseconds since epoch e.g "1587161887987654321"
+ * 4) %Qiso8601_ms - ISO-8601 UTC e.g "2020-04-17T22:18:07.987Z"
+ * 5) %Qiso8601_us - ISO-8601 UTC e.g "2020-04-17T22:18:07.987654Z"
+ * 6) %Qiso8601_ns - ISO-8601 UTC e.g "2020-04-17T22:18:07.987654321Z"
+ * @note The ISO-8601 formats are always in UTC, the timezone is ignored
  */
 class TimestampFormatter
 {
@@ -39,6 +49,17 @@ private:
     Qns
   };
 
+  enum FixedFormat : uint8_t
+  {
+    NoFixedFormat,
+    EpochMs,
+    EpochUs,
+    EpochNs,
+    Iso8601Ms,
+    Iso8601Us,
+    Iso8601Ns
+  };
+
 public:
   /**
    * Constructor
@@ -63,6 +84,21 @@ private:
    */
   void _append_fractional_seconds(uint32_t extracted_fractional_seconds);
 
+  /**
+   * Formats the timestamp as an integer since epoch
+   * @param time_since_epoch the timestamp from epoch
+   * @return formatted string
+   */
+  QUILL_NODISCARD std::string_view _format_epoch(std::chrono::nanoseconds time_since_epoch);
+
+  /**
+   * Formats the timestamp as ISO-8601 UTC. The date part is cached and only recalculated when
+   * the day changes, the time of day and fractional seconds are patched in place
+   * @param time_since_epoch the timestamp from epoch
+   * @return formatted string
+   */
+  QUILL_NODISCARD std::string_view _format_iso8601(std::chrono::nanoseconds time_since_epoch);
+
 private:
   /** As class member to avoid re-allocating **/
   std::string _formatted_date;
@@ -80,6 +116,16 @@ private:
 
   /** fractional seconds */
   AdditionalSpecifier _additional_format_specifier{AdditionalSpecifier::None};
+
+  /** fixed layout format that bypasses strftime, if any */
+  FixedFormat _fixed_format{FixedFormat::NoFixedFormat};
+
+  /** Number of fractional digits for the ISO-8601 formats */
+  uint32_t _iso8601_fractional_digits{0};
+
+  /** The start and end of the day, in seconds since epoch, of the cached ISO-8601 date */
+  int64_t _iso8601_day_begin_secs{0};
+  int64_t _iso8601_day_end_secs{0};
 };
 
 } // namespace quill::detail
\ No newline at end of file
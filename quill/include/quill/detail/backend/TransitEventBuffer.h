@@ -50,6 +50,14 @@ public:
      */
     explicit Node(uint32_t transit_buffer_capacity) : transit_buffer(transit_buffer_capacity) {}
 
+    /**
+     * @return the approximate memory of the transit buffer
+     */
+    QUILL_NODISCARD size_t memory_size() const noexcept
+    {
+      return static_cast<size_t>(transit_buffer.capacity()) * sizeof(TransitEvent);
+    }
+
     /** members */
     Node* next{nullptr};
     BoundedTransitEventBuffer transit_buffer;
@@ -62,6 +70,11 @@ public:
 
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT TransitEvent* front() noexcept;
   QUILL_ATTRIBUTE_HOT void pop_front() noexcept;
+
+  /**
+   * @return the next transit event to write or nullptr when the buffer is full and the memory
+   * budget does not allow it to grow
+   */
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT TransitEvent* back() noexcept;
   QUILL_ATTRIBUTE_HOT void push_back() noexcept;
   QUILL_NODISCARD QUILL_ATTRIBUTE_HOT uint32_t size() const noexcept;
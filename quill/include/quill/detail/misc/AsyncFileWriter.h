@@ -0,0 +1,68 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_NODISCARD, QUILL_ATTRIBUTE_COLD
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint32_t, uint64_t
+#include <memory>                         // for unique_ptr
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+namespace quill::detail
+{
+/**
+ * Writes buffers to a file descriptor without blocking the caller.
+ *
+ * Each submitted write is identified by a buffer index. The buffer must stay valid until the
+ * index is returned by reap(). Every write is done at the given absolute file offset so writes
+ * completing out of order still end up in submission order in the file.
+ */
+class AsyncFileWriter
+{
+public:
+  AsyncFileWriter() = default;
+  virtual ~AsyncFileWriter() = default;
+
+  AsyncFileWriter(AsyncFileWriter const&) = delete;
+  AsyncFileWriter& operator=(AsyncFileWriter const&) = delete;
+
+  /**
+   * Submits a write of the whole buffer
+   * @param buffer_index the index identifying the buffer on completion
+   * @param data buffer data
+   * @param size buffer size
+   * @param fd file descriptor to write to
+   * @param offset absolute file offset
+   * @throws QuillError when the write can not be submitted
+   */
+  virtual void submit(uint32_t buffer_index, char const* data, size_t size, int fd, uint64_t offset) = 0;
+
+  /**
+   * Collects the completed writes. Partially completed writes are resubmitted internally.
+   * Failed writes are also reported as completed so that their buffers can be reused.
+   * @param wait when true blocks until at least one write completes
+   * @param completed the indexes of the completed buffers are appended here
+   * @return an error message if any of the writes failed, otherwise an empty string
+   */
+  QUILL_NODISCARD virtual std::string reap(bool wait, std::vector<uint32_t>& completed) = 0;
+
+  /**
+   * @return true if the writes are done via io_uring
+   */
+  QUILL_NODISCARD virtual bool is_io_uring() const noexcept = 0;
+};
+
+/**
+ * Creates an io_uring writer when requested and available, otherwise a writer that does the
+ * writes on a dedicated thread
+ * @param max_in_flight the maximum number of writes in flight
+ * @param use_io_uring false to always use the thread based writer
+ * @return an async file writer
+ */
+QUILL_NODISCARD QUILL_ATTRIBUTE_COLD std::unique_ptr<AsyncFileWriter> create_async_file_writer(
+  uint32_t max_in_flight, bool use_io_uring);
+} // namespace quill::detail
@@ -0,0 +1,73 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_NODISCARD, QUILL_ATTRIBUTE_COLD
+#include <condition_variable>             // for condition_variable
+#include <deque>                          // for deque
+#include <functional>                     // for function
+#include <mutex>                          // for mutex
+#include <string>                         // for string
+#include <thread>                         // for thread
+
+namespace quill::detail
+{
+/**
+ * Runs slow file system work e.g. renaming rotated files on a dedicated thread, so that the
+ * backend thread is not blocked by it.
+ *
+ * Tasks run one at a time in the order they were enqueued. A task throwing an exception does not
+ * stop the worker, the error message is kept until it is collected with take_error().
+ */
+class BackgroundWorker
+{
+public:
+  /**
+   * Starts the worker thread
+   * @param name the name of the worker thread
+   */
+  explicit BackgroundWorker(std::string name);
+
+  /**
+   * Runs all the pending tasks and joins the worker thread
+   */
+  ~BackgroundWorker();
+
+  BackgroundWorker(BackgroundWorker const&) = delete;
+  BackgroundWorker& operator=(BackgroundWorker const&) = delete;
+
+  /**
+   * Adds a task to the end of the queue
+   * @param task the task to run on the worker thread
+   */
+  void enqueue(std::function<void()> task);
+
+  /**
+   * Blocks until all the enqueued tasks have completed
+   */
+  QUILL_ATTRIBUTE_COLD void wait_idle();
+
+  /**
+   * @return the error message of the first task that failed since the last call, or an empty
+   * string
+   */
+  QUILL_NODISCARD std::string take_error();
+
+private:
+  void _run();
+
+private:
+  std::string _name;
+  std::deque<std::function<void()>> _tasks;
+  std::string _error;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::condition_variable _idle_cv;
+  std::thread _thread;
+  bool _busy{false};
+  bool _stop{false};
+};
+} // namespace quill::detail
@@ -0,0 +1,39 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h"
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+  #include <time.h>
+#endif
+
+namespace quill::detail
+{
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+/**
+ * Get the coarse wall clock time. The precision is the kernel tick, typically 1-4 milliseconds,
+ * but reading it only loads the last tick time without touching the clock source
+ * @return nanoseconds since epoch
+ */
+QUILL_NODISCARD_ALWAYS_INLINE_HOT uint64_t coarse_time_since_epoch() noexcept
+{
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+}
+#else
+QUILL_NODISCARD_ALWAYS_INLINE_HOT uint64_t coarse_time_since_epoch() noexcept
+{
+  // soft failover
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch())
+                                 .count());
+}
+#endif
+} // namespace quill::detail
@@ -207,7 +207,18 @@ enum TimestampClockType : uint8_t
 {
   Tsc = 0,
   System,
-  Custom
+  Custom,
+  Coarse
+};
+
+/**
+ * What happens when a logging buffer needs to grow past Config::memory_budget
+ */
+enum class MemoryBudgetPolicy : uint8_t
+{
+  Block,                 /** the caller thread waits for the backend thread to free space */
+  DropLowestLevelsFirst, /** lower log levels stop growing the queues first, then messages are dropped */
+  StopGrowing            /** the queues stop growing and the messages that do not fit are dropped */
 };
 
 /**
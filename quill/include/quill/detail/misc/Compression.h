@@ -0,0 +1,68 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD
+#include "quill/detail/misc/Common.h"     // for fs
+#include <cstddef>                        // for size_t
+#include <memory>                         // for unique_ptr
+#include <string>                         // for string
+
+namespace quill::detail
+{
+/**
+ * @return true when quill was built with gzip support, see QUILL_ENABLE_GZIP
+ */
+constexpr bool is_gzip_supported() noexcept
+{
+#if defined(QUILL_HAS_ZLIB)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Compresses buffers to gzip members, reusing a single deflate stream for all of them.
+ * A file of concatenated gzip members is a valid gzip file and each member can be decompressed
+ * on its own.
+ */
+class GzipCompressor
+{
+public:
+  /**
+   * Constructor
+   * @throws QuillError on failure or when quill was built without gzip support
+   */
+  GzipCompressor();
+  ~GzipCompressor();
+
+  GzipCompressor(GzipCompressor const&) = delete;
+  GzipCompressor& operator=(GzipCompressor const&) = delete;
+
+  /**
+   * Compresses the data as a single gzip member and appends it to out. The deflate stream is
+   * reset before each member.
+   * @param data data to compress
+   * @param size size of the data
+   * @param out the gzip member is appended here
+   * @throws QuillError on failure
+   */
+  void compress(char const* data, size_t size, std::string& out);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+/**
+ * Compresses a file to a gzip file. The source file is not removed.
+ * @param source the file to compress
+ * @param destination the gzip file to create
+ * @throws QuillError on failure or when quill was built without gzip support
+ */
+QUILL_ATTRIBUTE_COLD void gzip_compress_file(fs::path const& source, fs::path const& destination);
+} // namespace quill::detail
@@ -0,0 +1,105 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_NODISCARD, QUILL_ATTRIBUTE_COLD
+#include <atomic>                         // for atomic
+#include <cstddef>                        // for size_t, byte
+#include <mutex>                          // for mutex
+#include <unordered_map>                  // for unordered_map
+#include <vector>                         // for vector
+
+namespace quill::detail
+{
+/**
+ * A region of memory reserved once, from which the queues of the hot path are allocated when
+ * huge pages are enabled.
+ *
+ * Mapping each queue separately wastes most of a 2 MiB huge page for a small queue and can fail
+ * at any time a new thread logs. The arena reserves all the huge pages at start and hands out
+ * blocks of it instead. When the arena is exhausted the queues fall back to normal pages.
+ *
+ * Blocks are rounded up to 4 KiB and kept in a first fit free list, allocations happen when a
+ * thread logs for the first time or a queue grows so a mutex is used.
+ */
+class HugePagesArena
+{
+public:
+  /**
+   * Constructor
+   * @param huge_pages map huge pages, false is used in the tests
+   */
+  explicit HugePagesArena(bool huge_pages) : _huge_pages(huge_pages) {}
+
+  /**
+   * Unmaps the arena, all the blocks must have been deallocated
+   */
+  ~HugePagesArena();
+
+  HugePagesArena(HugePagesArena const&) = delete;
+  HugePagesArena& operator=(HugePagesArena const&) = delete;
+
+  /**
+   * @return the arena used by alloc_aligned(), it is never destroyed as queues can outlive
+   * any other static object
+   */
+  QUILL_NODISCARD static HugePagesArena& instance();
+
+  /**
+   * Maps the arena. Does nothing when the arena is already reserved.
+   * @param size size of the arena, rounded up to a multiple of 2 MiB
+   * @throws when the memory can not be mapped, e.g. not enough huge pages are available
+   */
+  QUILL_ATTRIBUTE_COLD void reserve(size_t size);
+
+  /**
+   * @param size number of bytes
+   * @param alignment alignment of the block, at most 4096
+   * @return a block of the arena or nullptr when the arena is not reserved or exhausted
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_COLD void* allocate(size_t size, size_t alignment) noexcept;
+
+  /**
+   * Returns a block to the arena
+   * @param ptr a pointer returned by any allocator
+   * @return false when ptr is not a block of the arena
+   */
+  QUILL_NODISCARD bool deallocate(void* ptr) noexcept;
+
+  /**
+   * @return true when the arena is reserved
+   */
+  QUILL_NODISCARD bool is_reserved() const noexcept
+  {
+    return _begin.load(std::memory_order_acquire) != nullptr;
+  }
+
+  /**
+   * @return the size of the arena in bytes
+   */
+  QUILL_NODISCARD size_t capacity() const noexcept { return _capacity; }
+
+  /**
+   * @return the number of bytes handed out
+   */
+  QUILL_NODISCARD size_t used() noexcept;
+
+private:
+  struct FreeBlock
+  {
+    size_t offset;
+    size_t size;
+  };
+
+  std::mutex _mutex;
+  std::vector<FreeBlock> _free_blocks;              /** sorted by offset */
+  std::unordered_map<size_t, size_t> _allocated_blocks; /** offset -> size */
+  std::atomic<std::byte*> _begin{nullptr};
+  size_t _capacity{0};
+  size_t _used{0};
+  bool _huge_pages;
+};
+} // namespace quill::detail
@@ -0,0 +1,101 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/LogLevel.h"               // for LogLevel
+#include "quill/detail/misc/Attributes.h" // for QUILL_NODISCARD, QUILL_ATTRIBUTE_COLD
+#include "quill/detail/misc/Common.h"     // for MemoryBudgetPolicy
+#include <atomic>                         // for atomic
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint64_t
+
+namespace quill::detail
+{
+/**
+ * Tracks the memory used by the logging buffers of the whole process, the growth of the
+ * UnboundedQueues, the transit event buffers and the backtrace storage, against the limit
+ * set in Config::memory_budget.
+ *
+ * The usage is always tracked. When no limit is set every request succeeds.
+ */
+class MemoryBudget
+{
+public:
+  MemoryBudget() = default;
+  MemoryBudget(MemoryBudget const&) = delete;
+  MemoryBudget& operator=(MemoryBudget const&) = delete;
+
+  /**
+   * @return the budget of the process, it is never destroyed as queues can outlive any other
+   * static object
+   */
+  QUILL_NODISCARD static MemoryBudget& instance();
+
+  /**
+   * Sets the limit and the policy
+   * @param limit limit in bytes, 0 for no limit
+   * @param policy what happens when a buffer can not grow
+   */
+  QUILL_ATTRIBUTE_COLD void configure(size_t limit, MemoryBudgetPolicy policy) noexcept;
+
+  /**
+   * Reserves memory if the usage stays under the limit for this log level.
+   * With MemoryBudgetPolicy::DropLowestLevelsFirst TraceL3 to Debug may only use half of the
+   * limit and Info three quarters of it.
+   * @param bytes number of bytes
+   * @param log_level log level of the message that needs the memory
+   * @return true if the memory was reserved
+   */
+  QUILL_NODISCARD bool try_acquire(size_t bytes, LogLevel log_level) noexcept;
+
+  /**
+   * Reserves memory regardless of the limit, used for memory that is always needed
+   * @param bytes number of bytes
+   */
+  void acquire(size_t bytes) noexcept { _usage.fetch_add(bytes, std::memory_order_relaxed); }
+
+  /**
+   * Returns memory to the budget
+   * @param bytes number of bytes
+   */
+  void release(size_t bytes) noexcept { _usage.fetch_sub(bytes, std::memory_order_relaxed); }
+
+  /**
+   * Counts a log message that was dropped because its queue could not grow
+   */
+  void increment_dropped_messages() noexcept
+  {
+    _dropped_messages.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Called by the backend worker thread to report the dropped messages
+   * @return the number of dropped messages since the last call
+   */
+  QUILL_NODISCARD size_t get_and_reset_dropped_messages() noexcept
+  {
+    if (QUILL_LIKELY(_dropped_messages.load(std::memory_order_relaxed) == 0))
+    {
+      return 0;
+    }
+    return _dropped_messages.exchange(0, std::memory_order_relaxed);
+  }
+
+  /** Getters **/
+  QUILL_NODISCARD size_t usage() const noexcept { return _usage.load(std::memory_order_relaxed); }
+  QUILL_NODISCARD size_t limit() const noexcept { return _limit.load(std::memory_order_relaxed); }
+  QUILL_NODISCARD MemoryBudgetPolicy policy() const noexcept
+  {
+    return _policy.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<size_t> _usage{0};
+  std::atomic<size_t> _limit{0};
+  std::atomic<size_t> _dropped_messages{0};
+  std::atomic<MemoryBudgetPolicy> _policy{MemoryBudgetPolicy::Block};
+};
+} // namespace quill::detail
@@ -89,7 +89,8 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_COLD uint32_t get_process_id() noexcept;
  * Aligned alloc
  * @param size number of bytes to allocate. An integral multiple of alignment
  * @param alignment specifies the alignment. Must be a valid alignment supported by the implementation.
- * @param huge_pages allocate huge pages, only suported on linux
+ * @param huge_pages allocate huge pages, only suported on linux. The memory is taken from the
+ * HugePagesArena when it is reserved
  * @return On success, returns the pointer to the beginning of newly allocated memory.
  * To avoid a memory leak, the returned pointer must be deallocated with free_aligned().
  * @throws  std::system_error on failure
@@ -128,4 +129,10 @@ QUILL_NODISCARD QUILL_ATTRIBUTE_COLD bool is_in_terminal(FILE* file) noexcept;
  * @param f file
  */
 bool fsync(FILE* f);
+
+/**
+ * fdatasync the file descriptor, falls back to fsync where fdatasync is not available
+ * @param f file
+ */
+bool fdatasync(FILE* f);
 } // namespace quill::detail
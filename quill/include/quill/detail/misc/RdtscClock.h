@@ -11,6 +11,7 @@
 #include <atomic>
 #include <chrono>  // for nanoseconds, milliseconds
 #include <cstdint> // for int64_t, uint64_t
+#include <string>  // for string
 
 namespace quill::detail
 {
@@ -20,14 +21,23 @@ namespace quill::detail
 class RdtscClock
 {
   /**
-   * A static class that calculates the rdtsc ticks per second
+   * A static class that calculates the rdtsc ticks per second.
+   * The tsc frequency is obtained in the following order :
+   * 1) From the cpu, e.g. CPUID leaf 0x15/0x16 on x86, validated by a quick measurement
+   * 2) From the calibration cache file if one is provided, validated by a quick measurement
+   * 3) By a full calibration against the steady clock. The result is then stored in the
+   * calibration cache file if one is provided
    */
   class RdtscTicks
   {
   public:
-    QUILL_NODISCARD static RdtscTicks& instance()
+    /**
+     * @param calibration_cache_path optional file to load and store the calibration, only the
+     * value passed on the first call is used
+     */
+    QUILL_NODISCARD static RdtscTicks& instance(std::string const& calibration_cache_path)
     {
-      static RdtscTicks inst;
+      static RdtscTicks inst{calibration_cache_path};
       return inst;
     }
 
@@ -38,17 +48,73 @@ class RdtscClock
     /**
      * Constructor
      */
-    RdtscTicks();
+    explicit RdtscTicks(std::string const& calibration_cache_path);
 
     double _ns_per_tick{0};
   };
 
 public:
+  /**
+   * The drift between the tsc derived time and the system wall clock observed on each resync
+   */
+  struct DriftStats
+  {
+    std::chrono::nanoseconds max_drift{0}; /**< The maximum absolute drift observed */
+    std::chrono::nanoseconds avg_drift{0}; /**< The average absolute drift observed */
+    std::chrono::nanoseconds last_drift{0}; /**< The signed drift observed on the last resync */
+    std::chrono::nanoseconds resync_interval{0}; /**< The current resync interval */
+    uint64_t resync_count{0}; /**< The number of successful resyncs that measured a drift */
+    uint64_t failed_resync_count{0}; /**< The number of failed resyncs */
+  };
+
   /**
    * Constructor
    * @param resync_interval the interval to resync the tsc clock with the real system wall clock
+   * @param calibration_cache_path optional file used to cache the tsc calibration across runs
+   * @param accuracy_target when non zero, the resync interval is adapted to keep the drift
+   * between resyncs within this target. The resync_interval is used as the initial and the maximum interval
+   */
+  explicit RdtscClock(std::chrono::nanoseconds resync_interval,
+                      std::string const& calibration_cache_path = std::string{},
+                      std::chrono::nanoseconds accuracy_target = std::chrono::nanoseconds{0});
+
+  /**
+   * Checks if the tsc can be used as a clock source. On x86 this requires an invariant tsc, or
+   * on linux the kernel to have picked the tsc as its clocksource.
+   * @return true if the tsc is reliable on this machine
+   */
+  QUILL_NODISCARD static bool is_tsc_reliable() noexcept;
+
+  /**
+   * Picks the tsc frequency reported by the cpu, or else the cached one, when it agrees with a
+   * quick measurement
+   * @param cpu_reported_ticks_per_ns the ticks per nanosecond reported by the cpu or 0
+   * @param cached_ticks_per_ns the ticks per nanosecond loaded from the calibration cache or 0
+   * @param measured_ticks_per_ns the ticks per nanosecond of a quick measurement
+   * @return the accepted ticks per nanosecond or 0 when a full calibration is needed
+   */
+  QUILL_NODISCARD static double select_ticks_per_ns(double cpu_reported_ticks_per_ns, double cached_ticks_per_ns,
+                                                    double measured_ticks_per_ns) noexcept;
+
+  /**
+   * Obtains the tsc frequency, in the order described by RdtscTicks
+   * @param reported_ticks_per_ns the ticks per nanosecond reported by the cpu or 0
+   * @param calibration_cache_path optional file to load and store the calibration
+   * @return the ticks per nanosecond
+   */
+  QUILL_NODISCARD static double calibrate_ticks_per_ns(double reported_ticks_per_ns,
+                                                       std::string const& calibration_cache_path);
+
+  /**
+   * Loads the ticks per nanosecond from the calibration cache file
+   * @return the cached value or 0 if not available
    */
-  explicit RdtscClock(std::chrono::nanoseconds resync_interval);
+  QUILL_NODISCARD static double load_cached_ticks_per_ns(std::string const& calibration_cache_path);
+
+  /**
+   * Stores the ticks per nanosecond to the calibration cache file
+   */
+  static void store_cached_ticks_per_ns(std::string const& calibration_cache_path, double ticks_per_ns);
 
   /**
    * Convert tsc cycles to nanoseconds
@@ -78,6 +144,23 @@ public:
    */
   double nanoseconds_per_tick() const noexcept { return _ns_per_tick; }
 
+  /**
+   * @return the current resync interval, it differs from the initial one when adapted to the
+   * accuracy target or after a failed resync
+   * @note thread-safe, can be called by anyone
+   */
+  QUILL_NODISCARD std::chrono::nanoseconds resync_interval() const noexcept
+  {
+    return std::chrono::nanoseconds{static_cast<int64_t>(
+      static_cast<double>(_current_resync_interval_ticks.load(std::memory_order_relaxed)) * _ns_per_tick)};
+  }
+
+  /**
+   * @return the drift statistics observed so far
+   * @note thread-safe, can be called by anyone
+   */
+  QUILL_NODISCARD DriftStats drift_stats() const noexcept;
+
 private:
   struct BaseTimeTsc
   {
@@ -86,11 +169,35 @@ private:
     uint64_t base_tsc{0}; /**< Get the initial base tsc time */
   };
 
+private:
+  /**
+   * Measures the ticks per nanosecond by spinning for the given duration, using the median of
+   * the given number of trials
+   */
+  QUILL_NODISCARD static double _measure_ticks_per_ns(std::chrono::milliseconds spin_duration, size_t trials);
+
+  /**
+   * Records the drift observed on a resync and adapts the resync interval to the accuracy target
+   * @param drift_ns the tsc derived time minus the system wall clock time
+   * @param elapsed_ticks the ticks elapsed since the previous resync
+   */
+  void _record_drift(int64_t drift_ns, int64_t elapsed_ticks) const noexcept;
+
 private:
   mutable int64_t _resync_interval_ticks{0};
   int64_t _resync_interval_original{0}; /**< stores the initial interval value as as if we fail to resync we increase the timer */
+  mutable int64_t _resync_interval_adapted{0}; /**< the interval adapted to the accuracy target, the same as the original when there is no target */
+  int64_t _accuracy_target_ns{0};
   double _ns_per_tick{0};
 
+  /** Drift statistics, written only by the thread that is doing the resync */
+  mutable std::atomic<int64_t> _max_drift_ns{0};
+  mutable std::atomic<int64_t> _last_drift_ns{0};
+  mutable std::atomic<uint64_t> _total_drift_ns{0};
+  mutable std::atomic<uint64_t> _resync_count{0};
+  mutable std::atomic<uint64_t> _failed_resync_count{0};
+  mutable std::atomic<int64_t> _current_resync_interval_ticks{0};
+
   alignas(CACHE_LINE_ALIGNED) mutable std::atomic<uint32_t> _version{0};
   mutable std::array<BaseTimeTsc, 2> _base{};
 };
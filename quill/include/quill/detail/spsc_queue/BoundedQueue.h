@@ -163,6 +163,31 @@ public:
     return static_cast<integer_type>(_capacity);
   }
 
+  /**
+   * Only meant to be called by the writer. The position of the reader is only loaded when the
+   * cached value gives more than refresh_threshold bytes, as the real value can only be lower
+   * @param refresh_threshold number of bytes
+   * @return the number of bytes that are written but not yet read
+   */
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT integer_type producer_used_bytes(integer_type refresh_threshold) noexcept
+  {
+    if (static_cast<integer_type>(_writer_pos - _reader_pos_cache) > refresh_threshold)
+    {
+      _reader_pos_cache = _atomic_reader_pos.load(std::memory_order_acquire);
+    }
+
+    return static_cast<integer_type>(_writer_pos - _reader_pos_cache);
+  }
+
+  /**
+   * Only meant to be called by the writer
+   * @return the capacity of the queue the writer is using
+   */
+  QUILL_NODISCARD integer_type producer_capacity() const noexcept
+  {
+    return static_cast<integer_type>(_capacity);
+  }
+
 private:
 #if defined(QUILL_X86ARCH)
   QUILL_ALWAYS_INLINE_HOT void _flush_cachelines(integer_type& last, integer_type offset)
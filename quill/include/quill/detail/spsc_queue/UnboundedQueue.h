@@ -10,10 +10,13 @@
 #include <cstddef>
 #include <limits>
 #include <optional>
+#include <thread>
 #include <utility>
 
 #include "BoundedQueue.h"
+#include "quill/LogLevel.h"
 #include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/MemoryBudget.h"
 #include "quill/detail/misc/Os.h"
 
 namespace quill::detail
@@ -31,6 +34,9 @@ namespace quill::detail
  * Consumption is wait free. If not data is available a special value is returned. If a new
  * buffer is created from the producer the consumer first consumes everything in the old
  * buffer and then moves to the new buffer.
+ *
+ * The memory of each buffer is charged to the MemoryBudget, the first buffer is always allocated
+ * and a new buffer only when the budget allows it.
  */
 class UnboundedQueue
 {
@@ -49,6 +55,14 @@ private:
     {
     }
 
+    /**
+     * @return the memory of the bounded queue
+     */
+    QUILL_NODISCARD size_t memory_size() const noexcept
+    {
+      return 2u * static_cast<size_t>(bounded_queue.capacity());
+    }
+
     /** members */
     std::atomic<Node*> next{nullptr};
     BoundedQueue bounded_queue;
@@ -61,6 +75,7 @@ public:
   explicit UnboundedQueue(uint32_t initial_bounded_queue_capacity, bool huge_pages = false)
     : _huge_pages(huge_pages), _producer(new Node(initial_bounded_queue_capacity, huge_pages)), _consumer(_producer)
   {
+    MemoryBudget::instance().acquire(_producer->memory_size());
   }
 
   /**
@@ -82,6 +97,7 @@ public:
     {
       auto to_delete = current_node;
       current_node = current_node->next;
+      MemoryBudget::instance().release(to_delete->memory_size());
       delete to_delete;
     }
   }
@@ -89,9 +105,12 @@ public:
   /**
    * Reserve contiguous space for the producer without
    * making it visible to the consumer.
-   * @return a valid point to the buffer
+   * @param nbytes number of bytes
+   * @param log_level the log level of the message, used by the memory budget when the queue grows
+   * @return a valid point to the buffer or nullptr when the queue can not grow, see
+   * memory_budget_exceeded()
    */
-  QUILL_NODISCARD_ALWAYS_INLINE_HOT std::byte* prepare_write(uint32_t nbytes)
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT std::byte* prepare_write(uint32_t nbytes, LogLevel log_level = LogLevel::None)
   {
     // Try to reserve the bounded queue
     std::byte* write_pos = _producer->bounded_queue.prepare_write(nbytes);
@@ -101,6 +120,8 @@ public:
       return write_pos;
     }
 
+    _memory_budget_exceeded = false;
+
     // Then it means the queue doesn't have enough size
     uint64_t capacity = static_cast<uint64_t>(_producer->bounded_queue.capacity()) * 2ull;
     while (capacity < (nbytes + 1))
@@ -137,6 +158,35 @@ public:
     // commit previous write to the old queue before switching
     _producer->bounded_queue.commit_write();
 
+    MemoryBudget& memory_budget = MemoryBudget::instance();
+    size_t const node_memory_size = 2u * static_cast<size_t>(capacity);
+
+    while (QUILL_UNLIKELY(!memory_budget.try_acquire(node_memory_size, log_level)))
+    {
+      if (memory_budget.policy() != MemoryBudgetPolicy::Block)
+      {
+        _memory_budget_exceeded = true;
+        return nullptr;
+      }
+
+      if ((nbytes + 1) > _producer->bounded_queue.capacity())
+      {
+        // the message can never fit in the current queue, grow anyway
+        memory_budget.acquire(node_memory_size);
+        break;
+      }
+
+      // wait for the backend thread to free space in the current queue or in the budget
+      std::this_thread::yield();
+
+      write_pos = _producer->bounded_queue.prepare_write(nbytes);
+
+      if (write_pos)
+      {
+        return write_pos;
+      }
+    }
+
     // We failed to reserve because the queue was full, create a new node with a new queue
     auto next_node = new Node{static_cast<uint32_t>(capacity), _huge_pages};
 
@@ -196,6 +246,7 @@ public:
 
           // switch to the new buffer, existing one is deleted
           auto const previous_capacity = _consumer->bounded_queue.capacity();
+          MemoryBudget::instance().release(_consumer->memory_size());
           delete _consumer;
 
           _consumer = next_node;
@@ -230,6 +281,25 @@ public:
    */
   QUILL_NODISCARD uint32_t capacity() const noexcept { return _consumer->bounded_queue.capacity(); }
 
+  /**
+   * Only meant to be called by the producer
+   * @see BoundedQueue::producer_used_bytes
+   * @return the number of bytes that are written but not yet read in the current buffer
+   */
+  QUILL_NODISCARD_ALWAYS_INLINE_HOT uint32_t producer_used_bytes(uint32_t refresh_threshold) noexcept
+  {
+    return _producer->bounded_queue.producer_used_bytes(refresh_threshold);
+  }
+
+  /**
+   * Only meant to be called by the producer
+   * @return the capacity of the buffer the producer is using
+   */
+  QUILL_NODISCARD uint32_t producer_capacity() const noexcept
+  {
+    return _producer->bounded_queue.capacity();
+  }
+
   /**
    * checks if the queue is empty
    * @return true if empty, false otherwise
@@ -239,8 +309,15 @@ public:
     return _consumer->bounded_queue.empty() && (_consumer->next.load(std::memory_order_relaxed) == nullptr);
   }
 
+  /**
+   * @return true when the last prepare_write() returned nullptr because the memory budget did
+   * not allow the queue to grow
+   */
+  QUILL_NODISCARD bool memory_budget_exceeded() const noexcept { return _memory_budget_exceeded; }
+
 private:
   bool _huge_pages;
+  bool _memory_budget_exceeded{false}; /** Modified only by the producer */
   /** Modified by either the producer or consumer but never both */
   alignas(CACHE_LINE_ALIGNED) Node* _producer{nullptr};
   alignas(CACHE_LINE_ALIGNED) Node* _consumer{nullptr};
@@ -0,0 +1,169 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUIL...
+#include "quill/handlers/FileHandler.h"   // for FileHandler
+#include <chrono>                         // for milliseconds, steady_clock
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint32_t, uint64_t
+#include <memory>                         // for unique_ptr
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+namespace quill
+{
+
+namespace detail
+{
+class AsyncFileWriter;
+}
+
+/**
+ * The AsyncFileHandlerConfig class holds the configuration options for the AsyncFileHandler
+ */
+class AsyncFileHandlerConfig : public FileHandlerConfig
+{
+public:
+  /**
+   * @brief Sets the size of each write buffer in bytes. The size is rounded up to a multiple of
+   * 4096 bytes. The default value is 1 MiB.
+   * @param value The size of each write buffer
+   */
+  QUILL_ATTRIBUTE_COLD void set_write_buffer_size(size_t value);
+
+  /**
+   * @brief Sets the number of write buffers. One buffer is filled by the backend thread while
+   * the others are being written to the file. The backend thread only blocks when all the
+   * buffers are in flight. The minimum and default value is 2.
+   * @param value The number of write buffers
+   */
+  QUILL_ATTRIBUTE_COLD void set_max_in_flight(uint32_t value);
+
+  /**
+   * @brief Sets whether the writes are submitted via io_uring. When io_uring is not available
+   * or this is set to false the writes are done on a dedicated thread instead.
+   * The default value is true.
+   * @param value True to use io_uring when available, false otherwise.
+   */
+  QUILL_ATTRIBUTE_COLD void set_use_io_uring(bool value);
+
+  /**
+   * @brief Sets how long a partially filled write buffer is kept while the backend thread is
+   * idle before it is submitted. A value of zero submits it on the first idle flush.
+   * The default value is 100 milliseconds.
+   * @param value The maximum age of a partially filled write buffer
+   */
+  QUILL_ATTRIBUTE_COLD void set_idle_submit_interval(std::chrono::milliseconds value);
+
+  /** Getters **/
+  QUILL_NODISCARD size_t write_buffer_size() const noexcept { return _write_buffer_size; }
+  QUILL_NODISCARD uint32_t max_in_flight() const noexcept { return _max_in_flight; }
+  QUILL_NODISCARD bool use_io_uring() const noexcept { return _use_io_uring; }
+  QUILL_NODISCARD std::chrono::milliseconds idle_submit_interval() const noexcept
+  {
+    return _idle_submit_interval;
+  }
+
+private:
+  size_t _write_buffer_size{1024u * 1024u};
+  std::chrono::milliseconds _idle_submit_interval{100};
+  uint32_t _max_in_flight{2};
+  bool _use_io_uring{true};
+};
+
+/**
+ * AsyncFileHandler
+ * Writes the log messages to a file without blocking the backend thread on the disk.
+ *
+ * The formatted messages are copied into a write buffer. Full buffers are submitted to io_uring,
+ * or to a writer thread when io_uring is not available, while the backend thread continues
+ * with the next buffer.
+ *
+ * flush() waits for all the buffers in flight to be written. When the backend thread is idle the
+ * completed writes are reaped without waiting and a partially filled buffer is only submitted
+ * once it is older than the idle submit interval.
+ *
+ * @note When io_uring is used O_APPEND is removed from the file and each write is done at an
+ * explicit offset so that writes completing out of order do not interleave. Other processes
+ * appending to the same file are not supported.
+ */
+class AsyncFileHandler : public FileHandler
+{
+public:
+  /**
+   * Constructor
+   * @param filename string containing the name of the file to be opened.
+   * @param config AsyncFileHandler config
+   * @param file_event_notifier notifies on file events
+   * @throws on invalid config or when the file can not be opened
+   */
+  AsyncFileHandler(fs::path const& filename, AsyncFileHandlerConfig const& config,
+                   FileEventNotifier file_event_notifier);
+
+  ~AsyncFileHandler() override;
+
+  /**
+   * Copies a formatted log message to the current write buffer
+   * @param formatted_log_message input log message to write
+   * @param log_event log_event
+   */
+  QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
+                                 quill::TransitEvent const& log_event) override;
+
+  /**
+   * Submits the current write buffer, waits for all the buffers in flight and optionally fsyncs
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override;
+
+  /**
+   * Reaps the completed writes without waiting and submits the current write buffer when it is
+   * older than the idle submit interval
+   */
+  QUILL_ATTRIBUTE_HOT void idle_flush() noexcept override;
+
+  /**
+   * Keeps submitting and reaping the pending writes while the backend thread is idle
+   */
+  QUILL_ATTRIBUTE_HOT void run_loop() noexcept override;
+
+  /**
+   * @return true if the writes are submitted via io_uring
+   */
+  QUILL_NODISCARD bool is_io_uring() const noexcept;
+
+protected:
+  void open_file(fs::path const& filename, std::string const& mode) override;
+
+private:
+  void _prepare_file();
+  void _append(char const* data, size_t size);
+  void _submit_buffer();
+  void _reap(bool wait);
+  void _wait_all();
+  void _flush_without_waiting() noexcept;
+
+  QUILL_NODISCARD char* _buffer(uint32_t buffer_index) const noexcept
+  {
+    return _buffers + static_cast<size_t>(buffer_index) * _buffer_size;
+  }
+
+private:
+  AsyncFileHandlerConfig _config;
+  std::unique_ptr<detail::AsyncFileWriter> _writer;
+  char* _buffers{nullptr};
+  std::vector<uint32_t> _free_buffers;
+  std::vector<uint32_t> _completed;
+  std::string _pending_error; /** a write error detected during flush, reported on the next write */
+  std::chrono::steady_clock::time_point _current_buffer_since{}; /** first write to the current buffer */
+  uint64_t _file_offset{0};
+  size_t _buffer_size{0};
+  size_t _current_size{0};
+  uint32_t _current_buffer{0};
+  uint32_t _in_flight{0};
+  int _fd{-1};
+};
+} // namespace quill
@@ -0,0 +1,159 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/LoggerDetails.h"           // for LoggerDetails
+#include "quill/detail/misc/Attributes.h"         // for QUILL_ATTRIBUTE_HOT, QUILL_NODISCARD
+#include "quill/detail/spsc_queue/BoundedQueue.h" // for BoundedQueue
+#include "quill/handlers/Handler.h"               // for Handler
+#include <atomic>                                 // for atomic
+#include <condition_variable>                     // for condition_variable
+#include <cstddef>                                // for size_t
+#include <cstdint>                                // for uint64_t, uint8_t
+#include <memory>                                 // for shared_ptr
+#include <mutex>                                  // for mutex
+#include <string>                                 // for string
+#include <thread>                                 // for thread
+#include <unordered_map>                          // for unordered_map
+
+namespace quill
+{
+/**
+ * AsyncHandler
+ * Wraps another handler and writes to it on a dedicated thread, so that a slow handler e.g. a
+ * file on a network file system or a pipe to a slow consumer does not hold up the backend thread
+ * and every other handler.
+ *
+ * The backend thread formats the log messages with the pattern of the AsyncHandler and copies
+ * them into a lock free ring. The writer thread passes them to the write() of the wrapped
+ * handler and flushes it each time the ring is drained. When the ring is full the log message is
+ * either dropped or the backend thread waits for space, depending on the overflow policy.
+ *
+ * Filters, the sanitizer and the pattern are applied by the backend thread and must be set on
+ * the AsyncHandler, those of the wrapped handler are not used. The wrapped handler receives the
+ * timestamp, log level, metadata, logger name, thread id and thread name of each log message but
+ * not the structured key values. The logger name is copied into the ring as the logger can be
+ * removed before the writer thread reaches its log messages.
+ *
+ * flush() waits until the writer thread has written and flushed all the log messages passed to
+ * the AsyncHandler so far. Errors thrown by the wrapped handler are reported on the next write.
+ *
+ * @note The wrapped handler must not also be passed to a logger, it is only used by the writer thread
+ */
+class AsyncHandler : public Handler
+{
+public:
+  /**
+   * What happens to a log message when the ring is full
+   */
+  enum class OverflowPolicy : uint8_t
+  {
+    Drop,
+    Block
+  };
+
+  /**
+   * Constructor
+   * Starts the writer thread
+   * @param handler the handler to write to
+   * @param capacity the size of the ring in bytes, rounded up to a power of two
+   * @param overflow_policy what happens to a log message when the ring is full
+   * @throws on invalid capacity
+   */
+  AsyncHandler(std::shared_ptr<Handler> handler, size_t capacity, OverflowPolicy overflow_policy);
+
+  /**
+   * Writes the remaining log messages and joins the writer thread
+   */
+  ~AsyncHandler() override;
+
+  /**
+   * Copies a formatted log message into the ring
+   * @param formatted_log_message input log message to write
+   * @param log_event log_event
+   */
+  QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
+                                 quill::TransitEvent const& log_event) override;
+
+  /**
+   * Waits for the writer thread to write and flush all the log messages in the ring
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override;
+
+  /**
+   * @return the wrapped handler
+   */
+  QUILL_NODISCARD std::shared_ptr<Handler> const& handler() const noexcept { return _handler; }
+
+  /**
+   * @return the number of log messages dropped because the ring was full or because a log
+   * message was bigger than the ring
+   */
+  QUILL_NODISCARD uint64_t dropped_messages() const noexcept
+  {
+    return _dropped_messages.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @return the number of log messages for which the backend thread had to wait for space in
+   * the ring
+   */
+  QUILL_NODISCARD uint64_t blocked_messages() const noexcept
+  {
+    return _blocked_messages.load(std::memory_order_relaxed);
+  }
+
+private:
+  /**
+   * Fixed part of each record in the ring, followed by the log message, the thread id, the
+   * thread name and the logger name and padded to the alignment of the record.
+   * The logger_details of the header is not used by the writer thread.
+   */
+  struct Record
+  {
+    detail::Header header;
+    uint32_t size;
+    uint32_t message_size;
+    uint16_t thread_id_size;
+    uint16_t thread_name_size;
+    uint16_t logger_name_size;
+    TimestampClockType timestamp_clock_type;
+    LogLevel log_level;
+  };
+
+  void _run();
+  QUILL_NODISCARD bool _write_records();
+  void _wake_writer();
+  QUILL_NODISCARD detail::LoggerDetails const* _logger_details(TimestampClockType timestamp_clock_type);
+
+private:
+  std::shared_ptr<Handler> _handler;
+  detail::BoundedQueue _queue;
+  OverflowPolicy _overflow_policy;
+
+  /** Used by the writer thread to rebuild the log messages **/
+  fmt_buffer_t _formatted_log_message;
+  TransitEvent _transit_event;
+  std::string _thread_id;
+  std::string _thread_name;
+  std::string _logger_name;
+  std::unordered_map<std::string, std::unique_ptr<detail::LoggerDetails>> _loggers; /** one per logger name */
+  detail::LoggerDetails const* _last_logger{nullptr};
+
+  std::string _error; /** the error of the wrapped handler, reported on the next write */
+  std::mutex _mutex;
+  std::condition_variable _writer_cv;
+  std::condition_variable _flushed_cv;
+  uint64_t _flushed_sequence{0};
+  std::atomic<uint64_t> _flush_sequence{0};
+  std::atomic<uint64_t> _dropped_messages{0};
+  std::atomic<uint64_t> _blocked_messages{0};
+  std::atomic<bool> _writer_sleeping{false};
+  std::atomic<bool> _has_error{false};
+  std::atomic<bool> _stop{false};
+  std::thread _writer_thread;
+};
+} // namespace quill
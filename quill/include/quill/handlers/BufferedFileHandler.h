@@ -0,0 +1,147 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/Fmt.h"                    // for fmtquill::detail::buffer
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUIL...
+#include "quill/handlers/FileHandler.h"   // for FileHandler
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint64_t
+#include <string>                         // for string
+
+namespace quill
+{
+
+namespace detail
+{
+/**
+ * A growable fmt buffer backed by aligned memory, suitable for O_DIRECT writes
+ */
+class AlignedWriteBuffer final : public fmtquill::detail::buffer<char>
+{
+public:
+  AlignedWriteBuffer(size_t capacity, size_t alignment);
+  ~AlignedWriteBuffer();
+
+  AlignedWriteBuffer(AlignedWriteBuffer const&) = delete;
+  AlignedWriteBuffer& operator=(AlignedWriteBuffer const&) = delete;
+
+protected:
+  void grow(size_t capacity) override;
+
+private:
+  void _reallocate(size_t capacity);
+
+private:
+  size_t _alignment;
+};
+} // namespace detail
+
+/**
+ * The BufferedFileHandlerConfig class holds the configuration options for the BufferedFileHandler
+ */
+class BufferedFileHandlerConfig : public FileHandlerConfig
+{
+public:
+  /**
+   * @brief Sets the size of the write buffer in bytes. The size is rounded up to a multiple of
+   * 4096 bytes. The buffer is written to the file when it is almost full or on flush.
+   * The default value is 1 MiB.
+   * @param value The size of the write buffer
+   */
+  QUILL_ATTRIBUTE_COLD void set_write_buffer_size(size_t value);
+
+  /**
+   * @brief Sets whether the file is written with O_DIRECT, bypassing the page cache.
+   * Only block aligned writes are issued while logging, the unaligned tail is written via the
+   * page cache on flush. Ignored on platforms or filesystems without O_DIRECT support.
+   * The default value is false.
+   * @param value True to use O_DIRECT, false otherwise.
+   */
+  QUILL_ATTRIBUTE_COLD void set_direct_io(bool value);
+
+  /** Getters **/
+  QUILL_NODISCARD size_t write_buffer_size() const noexcept { return _write_buffer_size; }
+  QUILL_NODISCARD bool direct_io() const noexcept { return _direct_io; }
+
+private:
+  size_t _write_buffer_size{1024u * 1024u};
+  bool _direct_io{false};
+};
+
+/**
+ * BufferedFileHandler
+ * Writes the log messages to a file via a large user space buffer and raw write(2) calls,
+ * bypassing stdio.
+ *
+ * The backend thread formats each log message directly at the end of the buffer, unless the
+ * handler has filters, a sanitizer or a before_write callback, in which case the formatted message
+ * is copied.
+ */
+class BufferedFileHandler : public FileHandler
+{
+public:
+  /**
+   * Constructor
+   * @param filename string containing the name of the file to be opened.
+   * @param config BufferedFileHandler config
+   * @param file_event_notifier notifies on file events
+   * @throws on invalid config or when the file can not be opened
+   */
+  BufferedFileHandler(fs::path const& filename, BufferedFileHandlerConfig const& config,
+                      FileEventNotifier file_event_notifier);
+
+  ~BufferedFileHandler() override;
+
+  /**
+   * Copies a formatted log message to the write buffer
+   * @param formatted_log_message input log message to write
+   * @param log_event log_event
+   */
+  QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
+                                 quill::TransitEvent const& log_event) override;
+
+  /**
+   * Writes the buffer to the file and optionally fsyncs
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override;
+
+  /**
+   * @return the write buffer when no before_write callback is set
+   */
+  QUILL_NODISCARD fmtquill::detail::buffer<char>* direct_write_buffer() noexcept override;
+
+  /**
+   * Writes the buffer to the file when it is almost full
+   */
+  QUILL_ATTRIBUTE_HOT void on_direct_write(quill::TransitEvent const& log_event) override;
+
+  /**
+   * @return true if the file is written with O_DIRECT
+   */
+  QUILL_NODISCARD bool is_direct_io() const noexcept { return _direct_io; }
+
+protected:
+  void open_file(fs::path const& filename, std::string const& mode) override;
+  void close_file() override;
+
+private:
+  void _prepare_file();
+  void _disable_direct_io() noexcept;
+  void _write_buffer(bool write_tail);
+  void _on_append(quill::TransitEvent const& log_event);
+
+private:
+  BufferedFileHandlerConfig _config;
+  detail::AlignedWriteBuffer _buffer;
+  std::string _pending_error; /** a write error detected during flush, reported on the next write */
+  uint64_t _file_offset{0};   /** only used with O_DIRECT */
+  size_t _write_threshold;
+  size_t _recorded_size{0}; /** buffer size already accounted for the fsync policy */
+  int _fd{-1};
+  bool _direct_io{false};
+};
+} // namespace quill
@@ -211,5 +211,9 @@ private:
 
 private:
   ConsoleColours _console_colours;
+
+#if !defined(_WIN32)
+  fmt_buffer_t _colour_buffer; /** the colour codes and the message written with a single fwrite */
+#endif
 };
 } // namespace quill
\ No newline at end of file
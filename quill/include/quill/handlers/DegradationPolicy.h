@@ -0,0 +1,68 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/LogLevel.h"               // for LogLevel
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUILL_NODISCARD
+#include <chrono>                         // for microseconds, milliseconds
+
+namespace quill
+{
+/**
+ * The DegradationPolicy class protects the backend thread from a slow handler, e.g. a file on
+ * a slow disk or a full pipe.
+ *
+ * The backend thread measures the time each log message takes to be written to the handler.
+ * When the moving average exceeds the latency threshold the handler is degraded: the log
+ * messages below the minimum log level are skipped for at least the degraded duration. The
+ * handler leaves the degraded mode once the average of the log messages still written, or the
+ * latency of a single probe write, is below the threshold again, otherwise it stays degraded for
+ * another degraded duration. Both changes and the number of skipped log messages are reported
+ * via the notification handler.
+ *
+ * The default policy is disabled.
+ */
+class DegradationPolicy
+{
+public:
+  /**
+   * @brief Sets the average write latency above which the handler is degraded.
+   * The default value is 0 which disables it.
+   * @param value The latency threshold
+   */
+  QUILL_ATTRIBUTE_COLD void set_latency_threshold(std::chrono::microseconds value);
+
+  /**
+   * @brief Sets the log level from which log messages are still written while the handler is
+   * degraded. The default value is LogLevel::Warning.
+   * @param value The minimum log level written while degraded
+   */
+  QUILL_ATTRIBUTE_COLD void set_min_log_level(LogLevel value);
+
+  /**
+   * @brief Sets how long the handler stays degraded before the latency is checked again.
+   * The default value is 1 second.
+   * @param value The degraded duration
+   */
+  QUILL_ATTRIBUTE_COLD void set_degraded_duration(std::chrono::milliseconds value);
+
+  /** Getters **/
+  QUILL_NODISCARD std::chrono::microseconds latency_threshold() const noexcept
+  {
+    return _latency_threshold;
+  }
+  QUILL_NODISCARD LogLevel min_log_level() const noexcept { return _min_log_level; }
+  QUILL_NODISCARD std::chrono::milliseconds degraded_duration() const noexcept
+  {
+    return _degraded_duration;
+  }
+
+private:
+  std::chrono::microseconds _latency_threshold{0};
+  std::chrono::milliseconds _degraded_duration{1000};
+  LogLevel _min_log_level{LogLevel::Warning};
+};
+} // namespace quill
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include "quill/LogLevel.h"                // for LogLevel
 #include "quill/handlers/StreamHandler.h" // for StreamHandler
+#include <chrono>                         // for milliseconds, steady_clock
+#include <cstddef>                        // for size_t
 #include <string>                         // for string
 
 namespace quill
@@ -54,6 +57,39 @@ public:
    */
   QUILL_ATTRIBUTE_COLD void set_do_fsync(bool value);
 
+  /**
+   * @brief Sets the number of bytes written after which the file is synced on the next flush.
+   * Can be combined with `set_fsync_interval`, the file is synced when either is reached.
+   * The default value is 0 which disables it.
+   * @param value The number of bytes written between syncs
+   */
+  QUILL_ATTRIBUTE_COLD void set_fsync_min_bytes(size_t value);
+
+  /**
+   * @brief Sets the minimum interval between syncs. When data was written, the file is synced on
+   * the first flush after the interval has elapsed.
+   * The default value is 0 which disables it.
+   * @param value The interval between syncs
+   */
+  QUILL_ATTRIBUTE_COLD void set_fsync_interval(std::chrono::milliseconds value);
+
+  /**
+   * @brief Sets the log level from which the file is flushed and synced immediately after the
+   * log message is written, e.g. to make sure errors reach the disk before a crash.
+   * The default value is LogLevel::None which disables it.
+   * @param value The minimum log level that is synced immediately
+   */
+  QUILL_ATTRIBUTE_COLD void set_fsync_log_level(LogLevel value);
+
+  /**
+   * @brief Sets how often the handler checks on flush whether the file was deleted while the
+   * application is running, in which case the file is recreated. The check uses fstat on the open
+   * file instead of a path lookup. An interval of 0 checks on every flush.
+   * The default value is 1 second.
+   * @param value The interval between checks
+   */
+  QUILL_ATTRIBUTE_COLD void set_file_check_interval(std::chrono::milliseconds value);
+
   /**
    * @brief Sets the open mode for the file.
    * Valid options for the open mode are 'a' or 'w'. The default value is 'a'.
@@ -76,6 +112,13 @@ public:
 
   /** Getters **/
   QUILL_NODISCARD bool do_fsync() const noexcept { return _do_fsync; }
+  QUILL_NODISCARD size_t fsync_min_bytes() const noexcept { return _fsync_min_bytes; }
+  QUILL_NODISCARD std::chrono::milliseconds fsync_interval() const noexcept { return _fsync_interval; }
+  QUILL_NODISCARD LogLevel fsync_log_level() const noexcept { return _fsync_log_level; }
+  QUILL_NODISCARD std::chrono::milliseconds file_check_interval() const noexcept
+  {
+    return _file_check_interval;
+  }
   QUILL_NODISCARD Timezone timezone() const noexcept { return _timezone_value; }
   QUILL_NODISCARD FilenameAppend append_to_filename() const noexcept { return _append_to_filename; }
   QUILL_NODISCARD std::string const& open_mode() const noexcept { return _open_mode; }
@@ -86,8 +129,12 @@ private:
   std::string _open_mode{'a'};
   std::string _log_pattern;
   std::string _time_format;
+  size_t _fsync_min_bytes{0};
+  std::chrono::milliseconds _fsync_interval{0};
+  std::chrono::milliseconds _file_check_interval{1000};
   Timezone _timezone_value{Timezone::LocalTime};
   FilenameAppend _append_to_filename{FilenameAppend::None};
+  LogLevel _fsync_log_level{LogLevel::None};
   bool _do_fsync{false};
 };
 
@@ -110,16 +157,53 @@ public:
 
   ~FileHandler() override;
 
+  /**
+   * Write a formatted log message to the stream
+   * @param formatted_log_message input log message to write
+   * @param log_event log_event
+   */
+  QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
+                                 quill::TransitEvent const& log_event) override;
+
   /**
    * Flushes the stream and optionally fsyncs it
    */
   QUILL_ATTRIBUTE_HOT void flush() noexcept override;
 
 protected:
-  void open_file(fs::path const& filename, std::string const& mode);
-  void close_file();
+  virtual void open_file(fs::path const& filename, std::string const& mode);
+  virtual void close_file();
+
+  /**
+   * Accounts the bytes written for the fsync policy. Derived handlers that do not write via
+   * FileHandler::write call this for each log message
+   * @param size bytes written
+   * @param log_event log_event
+   * @return true if the log message must be flushed and synced immediately
+   */
+  QUILL_NODISCARD bool record_write(size_t size, quill::TransitEvent const& log_event) noexcept;
+
+  /**
+   * Syncs the file when required by the fsync policy. Called on flush after the data is handed
+   * to the kernel
+   */
+  void fsync_if_needed() noexcept;
+
+  /**
+   * Recreates the file when it was deleted while the application is running.
+   * The file is reopened via the virtual close_file and open_file.
+   * @return true if the file was reopened
+   */
+  bool reopen_if_deleted();
+
+private:
+  QUILL_NODISCARD bool _is_file_deleted() const;
 
 private:
   FileHandlerConfig _config;
+  std::chrono::steady_clock::time_point _last_fsync_time{};
+  std::chrono::steady_clock::time_point _next_file_check_time{};
+  size_t _unsynced_bytes{0};
+  bool _fsync_requested{false};
 };
 } // namespace quill
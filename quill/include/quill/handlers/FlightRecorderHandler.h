@@ -0,0 +1,146 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUIL...
+#include "quill/detail/misc/Common.h"     // for fs
+#include "quill/handlers/Handler.h"       // for Handler
+#include <atomic>                         // for atomic
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint64_t, uint32_t
+#include <string>                         // for string
+
+namespace quill
+{
+/**
+ * The header at the start of a flight recorder file, followed by the ring of `capacity` bytes.
+ * The ring holds the most recent log messages, `write_position` is the total number of bytes
+ * ever written and the ring offset of the next byte is `write_position % capacity`.
+ *
+ * The writer advances `reserved_position` before copying a log message and publishes
+ * `write_position` after. A reader copies the ring up to `write_position`, then loads
+ * `reserved_position`, any byte older than `reserved_position - capacity` may have been
+ * overwritten during the copy.
+ */
+struct FlightRecorderHeader
+{
+  char magic[8];                           /** "QUILLFR1" */
+  uint32_t version;                        /** layout version, currently 1 */
+  uint32_t header_size;                    /** offset of the ring in the file */
+  uint64_t capacity;                       /** size of the ring in bytes */
+  std::atomic<uint64_t> write_position;    /** published after the log message is copied */
+  std::atomic<uint64_t> reserved_position; /** advanced before the log message is copied */
+  std::atomic<uint64_t> sequence;          /** number of log messages written */
+  char padding[16];
+};
+
+static_assert(sizeof(FlightRecorderHeader) == 64, "FlightRecorderHeader must be 64 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "FlightRecorderHeader needs lock free atomics to be shared between processes");
+
+/**
+ * The FlightRecorderHandlerConfig class holds the configuration options for the FlightRecorderHandler
+ */
+class FlightRecorderHandlerConfig
+{
+public:
+  /**
+   * @brief Sets the size of the ring, the most recent log messages up to this size are kept.
+   * The default value is 16 MiB.
+   * @param value The ring size in bytes
+   */
+  QUILL_ATTRIBUTE_COLD void set_capacity(size_t value);
+
+  /**
+   * @brief Sets the open mode for the file.
+   * With 'a' a valid ring of the same capacity left by a previous run is continued, otherwise
+   * the file is reset. With 'w' the file is always reset. The default value is 'a'.
+   * @param open_mode open mode for the file.
+   */
+  QUILL_ATTRIBUTE_COLD void set_open_mode(char open_mode);
+
+  /**
+   * @brief Sets the logging pattern for the handler.
+   * @see PatternFormatter.h for more details on the pattern format.
+   * @param log_pattern: Specifies the format pattern for the log messages.
+   * @param time_format Specifies the format pattern for the log timestamps.
+   */
+  QUILL_ATTRIBUTE_COLD void set_pattern(std::string const& log_pattern,
+                                        std::string const& time_format = std::string{
+                                          "%H:%M:%S.%Qns"});
+
+  /** Getters **/
+  QUILL_NODISCARD size_t capacity() const noexcept { return _capacity; }
+  QUILL_NODISCARD char open_mode() const noexcept { return _open_mode; }
+  QUILL_NODISCARD std::string const& log_pattern() const noexcept { return _log_pattern; }
+  QUILL_NODISCARD std::string const& time_format() const noexcept { return _time_format; }
+
+private:
+  std::string _log_pattern;
+  std::string _time_format;
+  size_t _capacity{16u * 1024u * 1024u};
+  char _open_mode{'a'};
+};
+
+/**
+ * FlightRecorderHandler
+ * Keeps the most recent log messages in a fixed size ring inside a shared memory mapped file.
+ *
+ * Each log message is copied into the mapping and the write position in the file header is
+ * published, there is no system call on the write path. As the mapping is shared, the file
+ * contains the log messages up to the last published position after a process crash and
+ * can be read live by another process, e.g. with `FlightRecorderHandler::read`.
+ * Put the file on tmpfs to keep it in memory only.
+ *
+ * @note flush does nothing, the kernel writes back the pages
+ * @note Not supported on windows
+ */
+class FlightRecorderHandler : public Handler
+{
+public:
+  /**
+   * Constructor
+   * Creates or reuses the file and maps it
+   * @param filename the name of the file
+   * @param config flight recorder handler config
+   * @throws when the file can not be mapped or on windows
+   */
+  FlightRecorderHandler(fs::path const& filename, FlightRecorderHandlerConfig const& config);
+
+  ~FlightRecorderHandler() override;
+
+  /**
+   * Copies a formatted log message into the ring
+   * @param formatted_log_message input log message to write
+   * @param log_event log_event
+   */
+  QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
+                                 quill::TransitEvent const& log_event) override;
+
+  /**
+   * Does nothing
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override {}
+
+  /**
+   * Reads the log messages of a flight recorder file, oldest first. The partially overwritten
+   * oldest log message is skipped. Can be used while the file is being written.
+   * @param filename the name of the file
+   * @return the log messages in the ring
+   * @throws when the file is not a valid flight recorder file
+   */
+  QUILL_NODISCARD static std::string read(fs::path const& filename);
+
+private:
+  fs::path _filename;
+  FlightRecorderHeader* _header{nullptr};
+  char* _ring{nullptr};
+  size_t _mapped_size{0};
+  uint64_t _capacity{0};
+  uint64_t _write_position{0}; /** our copy of header->write_position, we are the only writer */
+  uint64_t _sequence{0};
+};
+} // namespace quill
@@ -0,0 +1,66 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/LogLevel.h"               // for LogLevel
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUILL_NODISCARD
+#include <chrono>                         // for milliseconds
+#include <cstddef>                        // for size_t
+
+namespace quill
+{
+/**
+ * The FlushPolicy class controls when the backend thread flushes a handler.
+ * A handler is flushed when any of the enabled conditions is met. quill::flush() always
+ * flushes all the handlers.
+ *
+ * The default policy flushes the handler when the backend thread becomes idle.
+ */
+class FlushPolicy
+{
+public:
+  /**
+   * @brief Sets the log level from which the handler is flushed immediately after the log
+   * message is written. The default value is LogLevel::None which disables it.
+   * @param value The minimum log level that is flushed immediately
+   */
+  QUILL_ATTRIBUTE_COLD void set_flush_log_level(LogLevel value);
+
+  /**
+   * @brief Sets the number of bytes written after which the handler is flushed.
+   * The default value is 0 which disables it.
+   * @param value The number of bytes written between flushes
+   */
+  QUILL_ATTRIBUTE_COLD void set_flush_bytes(size_t value);
+
+  /**
+   * @brief Sets the maximum time a log message stays unflushed, also while the backend thread is
+   * busy. The default value is 0 which disables it.
+   * @param value The flush interval
+   */
+  QUILL_ATTRIBUTE_COLD void set_flush_interval(std::chrono::milliseconds value);
+
+  /**
+   * @brief Sets whether the handler is flushed when the backend thread becomes idle. Disable it
+   * together with a byte or time threshold to reduce the flushes of a chatty handler.
+   * The default value is true.
+   * @param value True to flush when idle
+   */
+  QUILL_ATTRIBUTE_COLD void set_flush_on_idle(bool value);
+
+  /** Getters **/
+  QUILL_NODISCARD LogLevel flush_log_level() const noexcept { return _flush_log_level; }
+  QUILL_NODISCARD size_t flush_bytes() const noexcept { return _flush_bytes; }
+  QUILL_NODISCARD std::chrono::milliseconds flush_interval() const noexcept { return _flush_interval; }
+  QUILL_NODISCARD bool flush_on_idle() const noexcept { return _flush_on_idle; }
+
+private:
+  size_t _flush_bytes{0};
+  std::chrono::milliseconds _flush_interval{0};
+  LogLevel _flush_log_level{LogLevel::None};
+  bool _flush_on_idle{true};
+};
+} // namespace quill
@@ -8,12 +8,16 @@
 #include "quill/Fmt.h"
 #include "quill/MacroMetadata.h"
 #include "quill/PatternFormatter.h"
+#include "quill/Sanitizer.h"
 #include "quill/TransitEvent.h"
 #include "quill/detail/Serialize.h"
 #include "quill/detail/misc/Common.h"
 #include "quill/detail/misc/Os.h"
 #include "quill/filters/FilterBase.h"
+#include "quill/handlers/DegradationPolicy.h"
+#include "quill/handlers/FlushPolicy.h"
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -63,6 +67,149 @@ public:
    */
   QUILL_ATTRIBUTE_HOT PatternFormatter& formatter() { return *_formatter; }
 
+  /**
+   * Sets a sanitizer that escapes control characters and redacts sensitive data in the log
+   * messages of this handler. Only the log message is sanitized, before the pattern formatting.
+   * The JsonFileHandler sanitizes each structured value instead
+   * @warning This function is not thread safe and should be called before any logging to this handler happens
+   * @param config sanitizer config
+   */
+  QUILL_ATTRIBUTE_COLD void set_sanitizer(SanitizerConfig const& config)
+  {
+    _sanitizer = std::make_unique<Sanitizer>(config);
+  }
+
+  /**
+   * @note: Accessor for backend processing
+   * @return the sanitizer of this handler or nullptr
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT Sanitizer* sanitizer() noexcept { return _sanitizer.get(); }
+
+  /**
+   * Sets when the backend thread flushes this handler
+   * @warning This function is not thread safe and should be called before any logging to this handler happens
+   * @param flush_policy flush policy
+   */
+  QUILL_ATTRIBUTE_COLD void set_flush_policy(FlushPolicy const& flush_policy)
+  {
+    _flush_policy = flush_policy;
+  }
+
+  /**
+   * @return the flush policy of this handler
+   */
+  QUILL_NODISCARD FlushPolicy const& flush_policy() const noexcept { return _flush_policy; }
+
+  /**
+   * Accounts a log message written to this handler for the flush policy
+   * @note: called internally by the backend worker thread.
+   * @param bytes size of the formatted log message
+   * @param log_level log level of the log message
+   * @return true if the handler must be flushed now
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT bool record_unflushed_write(size_t bytes, LogLevel log_level) noexcept;
+
+  /**
+   * @note: called internally by the backend worker thread when it is idle.
+   * @param now current time
+   * @return true if the handler has unflushed log messages that must be flushed now
+   */
+  QUILL_NODISCARD bool should_flush_on_idle(std::chrono::steady_clock::time_point now) const noexcept;
+
+  /**
+   * @return true if the handler has unflushed log messages and a flush interval
+   */
+  QUILL_NODISCARD bool has_pending_flush_interval() const noexcept
+  {
+    return _has_unflushed_writes && (_flush_policy.flush_interval().count() != 0);
+  }
+
+  /**
+   * Flushes the handler and resets the flush policy counters
+   * @note: called internally by the backend worker thread.
+   */
+  QUILL_ATTRIBUTE_HOT void flush_by_backend() noexcept
+  {
+    flush();
+    _unflushed_bytes = 0;
+    _has_unflushed_writes = false;
+  }
+
+  /**
+   * Flushes the handler when the backend thread is idle and resets the flush policy counters
+   * @note: called internally by the backend worker thread.
+   */
+  QUILL_ATTRIBUTE_HOT void idle_flush_by_backend() noexcept
+  {
+    idle_flush();
+    _unflushed_bytes = 0;
+    _has_unflushed_writes = false;
+  }
+
+  /**
+   * Sets when the backend thread degrades this handler because it is slow
+   * @warning This function is not thread safe and should be called before any logging to this handler happens
+   * @param degradation_policy degradation policy
+   */
+  QUILL_ATTRIBUTE_COLD void set_degradation_policy(DegradationPolicy const& degradation_policy)
+  {
+    _degradation_policy = degradation_policy;
+  }
+
+  /**
+   * @return the degradation policy of this handler
+   */
+  QUILL_NODISCARD DegradationPolicy const& degradation_policy() const noexcept
+  {
+    return _degradation_policy;
+  }
+
+  /**
+   * @return true while the handler skips the log messages below the minimum log level of the
+   * degradation policy
+   */
+  QUILL_NODISCARD bool is_degraded() const noexcept { return _degraded; }
+
+  /**
+   * @return the moving average of the write latency
+   */
+  QUILL_NODISCARD std::chrono::nanoseconds write_latency() const noexcept
+  {
+    return _write_latency;
+  }
+
+  /**
+   * Accounts the time a log message took to be written for the degradation policy
+   * @note: called internally by the backend worker thread.
+   * @param write_start time before the write
+   * @param write_end time after the write
+   * @return true if the handler became degraded
+   */
+  QUILL_NODISCARD bool record_write_latency(std::chrono::steady_clock::time_point write_start,
+                                            std::chrono::steady_clock::time_point write_end) noexcept;
+
+  /**
+   * Counts the log message as skipped when the handler is degraded and its level is below the
+   * minimum log level, unless it is written as a probe of the write latency
+   * @note: called internally by the backend worker thread.
+   * @param log_level log level of the log message
+   * @return true if the log message must be skipped
+   */
+  QUILL_NODISCARD bool skip_degraded_write(LogLevel log_level) noexcept;
+
+  /**
+   * Ends the degraded mode once the degraded duration elapsed and the write latency recovered.
+   * The average latency is still updated by the log messages written while degraded, when it is
+   * still above the threshold a single log message is written as a probe. When the probe is also
+   * slow the handler stays degraded for another degraded duration
+   * @note: called internally by the backend worker thread.
+   * @param now current time
+   * @param skipped_messages set to the number of log messages skipped while degraded
+   * @return true if the handler is no longer degraded
+   */
+  QUILL_NODISCARD bool leave_degraded_mode(std::chrono::steady_clock::time_point now,
+                                           size_t& skipped_messages) noexcept;
+
   /**
    * Logs a formatted log message to the handler
    * @note: Accessor for backend processing
@@ -77,6 +224,13 @@ public:
    */
   QUILL_ATTRIBUTE_HOT virtual void flush() noexcept = 0;
 
+  /**
+   * Called instead of flush() when the backend thread is idle and the flush policy requests a
+   * flush. Handlers that write asynchronously can override this to avoid waiting for their
+   * pending writes. An explicit quill::flush() always calls flush().
+   */
+  QUILL_ATTRIBUTE_HOT virtual void idle_flush() noexcept { flush(); }
+
   /**
    * Executes periodically by the backend thread, providing an opportunity for the user
    * to perform custom tasks. For example, batch committing to a database, or any other
@@ -87,6 +241,25 @@ public:
    */
   QUILL_ATTRIBUTE_HOT virtual void run_loop() noexcept {};
 
+  /**
+   * Handlers that own a write buffer can return it here. The backend thread then formats the
+   * log message directly at the end of this buffer and calls on_direct_write() instead of
+   * write(), saving a copy of each message.
+   * @note Handlers with filters are always written via write() as they need the formatted message
+   * on its own.
+   * @return the buffer to format into or nullptr to receive the messages via write()
+   */
+  QUILL_NODISCARD virtual fmtquill::detail::buffer<char>* direct_write_buffer() noexcept
+  {
+    return nullptr;
+  }
+
+  /**
+   * Called by the backend thread after a log message was formatted into direct_write_buffer()
+   * @param log_event transit event
+   */
+  QUILL_ATTRIBUTE_HOT virtual void on_direct_write(quill::TransitEvent const& /* log_event */) {}
+
   /**
    * Sets a log level filter on the handler. Log statements with higher or equal severity only will be logged
    * @note thread safe
@@ -123,11 +296,42 @@ public:
                                      LogLevel log_level, MacroMetadata const& metadata,
                                      fmt_buffer_t const& formatted_record);
 
+  /**
+   * @note: called internally by the backend worker thread.
+   * @return true if any filters were added to this handler
+   */
+  QUILL_NODISCARD bool has_filters();
+
 protected:
   /**< Owned formatter for this handler, we have to use a pointer here since the PatterFormatter
    * must not be moved or copied. We create the default pattern formatter always on init */
   std::unique_ptr<PatternFormatter> _formatter = std::make_unique<PatternFormatter>();
 
+private:
+  /** Optional sanitizer, applied to the log message before the pattern formatting **/
+  std::unique_ptr<Sanitizer> _sanitizer;
+
+  /** Flush policy and its state, only accessed by the backend thread **/
+  FlushPolicy _flush_policy;
+  std::chrono::steady_clock::time_point _unflushed_since{};
+  size_t _unflushed_bytes{0};
+  bool _has_unflushed_writes{false};
+
+  /** Degradation policy and its state, only accessed by the backend thread **/
+  DegradationPolicy _degradation_policy;
+  std::chrono::nanoseconds _write_latency{0};
+  std::chrono::nanoseconds _probe_latency{0}; /** of a single write once the degraded duration elapsed */
+  std::chrono::steady_clock::time_point _degraded_until{};
+  size_t _degraded_skipped_messages{0};
+  bool _degraded{false};
+  bool _probe_pending{false}; /** the next log message is written even below the minimum log level */
+  bool _has_probe_latency{false};
+
+  /**
+   * Reloads the local filters when a new filter was added
+   */
+  void _update_local_filters();
+
 private:
   /** Local Filters for this handler **/
   std::vector<FilterBase*> _local_filters;
@@ -19,6 +19,10 @@ public:
   JsonFileHandlerConfig() = default;
 };
 
+/**
+ * Writes each log message as a json object of the message format and the structured values.
+ * A sanitizer set on this handler is applied to each structured value.
+ */
 class JsonFileHandler : public FileHandler
 {
 public:
@@ -41,5 +45,6 @@ public:
 
 private:
   fmt_buffer_t _json_message;
+  fmt_buffer_t _structured_value; /** input of the sanitizer */
 };
 } // namespace quill
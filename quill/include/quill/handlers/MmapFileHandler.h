@@ -0,0 +1,122 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h"       // for QUILL_ATTRIBUTE_COLD, QUIL...
+#include "quill/handlers/RotatingFileHandler.h" // for RotatingFileHandler
+#include <chrono>                               // for system_clock
+#include <cstddef>                              // for size_t
+#include <cstdint>                              // for uint64_t, uint8_t
+#include <string>                               // for string
+
+namespace quill
+{
+
+/**
+ * The MmapFileHandlerConfig class holds the configuration options for the MmapFileHandler.
+ * All the rotation options of the RotatingFileHandlerConfig are also supported.
+ */
+class MmapFileHandlerConfig : public RotatingFileHandlerConfig
+{
+public:
+  /**
+   * Controls when the mapped pages are written back to the file
+   */
+  enum class SyncPolicy : uint8_t
+  {
+    None,  /**< Leave the write back to the kernel */
+    Async, /**< msync(MS_ASYNC) when the window advances and on flush */
+    Sync   /**< msync(MS_SYNC) when the window advances and on flush */
+  };
+
+  /**
+   * @brief Sets the size of each preallocated extent, which is also the size of the mapped
+   * window. The size is rounded up to a multiple of the page size. The default value is 64 MiB.
+   * @param value The size of each preallocated extent in bytes
+   */
+  QUILL_ATTRIBUTE_COLD void set_chunk_size(size_t value);
+
+  /**
+   * @brief Sets when the mapped pages are written back to the file. The default value is None.
+   * @param value The sync policy
+   */
+  QUILL_ATTRIBUTE_COLD void set_sync_policy(SyncPolicy value);
+
+  /** Getters **/
+  QUILL_NODISCARD size_t chunk_size() const noexcept { return _chunk_size; }
+  QUILL_NODISCARD SyncPolicy sync_policy() const noexcept { return _sync_policy; }
+
+private:
+  size_t _chunk_size{64u * 1024u * 1024u};
+  SyncPolicy _sync_policy{SyncPolicy::None};
+};
+
+/**
+ * MmapFileHandler
+ * Writes the log messages to a memory mapped file.
+ *
+ * The file is preallocated in chunks and the current chunk is mapped, each log message is then
+ * copied straight into the mapping without any system call. The file is truncated to its real
+ * size when it is closed or rotated.
+ *
+ * @note Until the file is closed, its size on disk includes the preallocated part which reads
+ * as zeros. After a crash the trailing zeros remain in the file.
+ * @note On windows the file is written via stdio instead.
+ * @note The async rotation, preallocate and GzipStream compression options are ignored, the
+ * rotation is always done by the backend thread and the file is preallocated in chunks.
+ */
+class MmapFileHandler : public RotatingFileHandler
+{
+public:
+  /**
+   * Constructor
+   * @param filename The base file name to be used for logs.
+   * @param config The handler configuration.
+   * @param file_event_notifier notifies on file events
+   * @param start_time start time used for the time based rotation
+   */
+  MmapFileHandler(fs::path const& filename, MmapFileHandlerConfig const& config,
+                  FileEventNotifier file_event_notifier,
+                  std::chrono::system_clock::time_point start_time = std::chrono::system_clock::now());
+
+  ~MmapFileHandler() override;
+
+  /**
+   * Syncs the mapped window according to the sync policy and optionally fsyncs
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override;
+
+  /**
+   * @return true if the file is currently memory mapped
+   */
+  QUILL_NODISCARD bool is_mapped() const noexcept { return _window != nullptr; }
+
+protected:
+  QUILL_ATTRIBUTE_HOT void write_to_file(fmt_buffer_t const& formatted_log_message,
+                                         quill::TransitEvent const& log_event) override;
+
+  void open_file(fs::path const& filename, std::string const& mode) override;
+  void close_file() override;
+
+private:
+  void _map_file();
+  void _unmap_file();
+  void _map_window(uint64_t file_offset);
+  void _advance_window();
+  void _sync_window() noexcept;
+  void _preallocate(uint64_t size);
+  void _append(char const* data, size_t size);
+
+private:
+  MmapFileHandlerConfig _config;
+  char* _window{nullptr};
+  uint64_t _window_offset{0};  /** file offset of the mapped window */
+  uint64_t _allocated_size{0}; /** preallocated size of the file */
+  size_t _window_pos{0};       /** write position inside the window */
+  size_t _chunk_size;
+  int _fd{-1};
+};
+} // namespace quill
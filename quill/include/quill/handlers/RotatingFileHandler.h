@@ -5,13 +5,16 @@
 
 #pragma once
 
-#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUIL...
-#include "quill/handlers/FileHandler.h"   // for FileHandler
-#include <chrono>                         // for nanoseconds
-#include <cstddef>                        // for size_t
-#include <cstdint>                        // for uint32_t
+#include "quill/detail/misc/Attributes.h"       // for QUILL_ATTRIBUTE_COLD, QUIL...
+#include "quill/detail/misc/BackgroundWorker.h" // for BackgroundWorker
+#include "quill/handlers/FileHandler.h"         // for FileHandler
+#include <atomic>                               // for atomic
+#include <chrono>                               // for nanoseconds, milliseconds
+#include <cstddef>                              // for size_t
+#include <cstdint>                              // for uint32_t
 #include <deque>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -19,6 +22,11 @@
 namespace quill
 {
 
+namespace detail
+{
+class GzipCompressor;
+}
+
 /**
  * The RotatingFileHandlerConfig class holds the configuration options for the RotatingFileHandler
  */
@@ -40,6 +48,13 @@ public:
     DateAndTime
   };
 
+  enum class Compression : uint8_t
+  {
+    None,
+    Gzip,      /**< The rotated files are compressed to .gz files by a helper thread */
+    GzipStream /**< The log file is written as a sequence of independently decompressible gzip members */
+  };
+
   RotatingFileHandlerConfig();
 
   /**
@@ -96,11 +111,74 @@ public:
    */
   QUILL_ATTRIBUTE_COLD void set_rotation_naming_scheme(RotationNamingScheme value);
 
+  /**
+   * @brief Sets whether the rotation is done asynchronously.
+   * When enabled, the next log file is created ahead of time by a helper thread. On rotation the
+   * backend thread only renames the current file to a temporary name and switches to the next
+   * file, the backup files are renamed and removed by the helper thread.
+   * The before_open, before_close and after_close callbacks are then invoked by the helper thread
+   * and before_open is invoked when the next file is created.
+   * Not supported on windows, where it is ignored. The default value is false.
+   * @param value True to rotate asynchronously, false otherwise.
+   */
+  QUILL_ATTRIBUTE_COLD void set_async_rotation(bool value);
+
+  /**
+   * @brief Sets the compression of the log files. Requires quill to be built with QUILL_ENABLE_GZIP.
+   *
+   * Gzip: Each rotated file is compressed to a `.gz` file by a helper thread and the
+   * uncompressed file is removed. The backup files keep the `.gz` suffix when they are renamed.
+   *
+   * GzipStream: The log messages are buffered and written as a gzip member once the buffer reaches
+   * the frame size or the frame interval, on an explicit flush, on rotation and when the file is
+   * closed. A crash leaves at most the last gzip member unreadable. The
+   * maximum file size refers to the uncompressed size and the file event callbacks must not write
+   * to the file.
+   *
+   * The default value is None.
+   * @param value The compression to use.
+   * @throws QuillError when quill was built without gzip support
+   */
+  QUILL_ATTRIBUTE_COLD void set_compression(Compression value);
+
+  /**
+   * @brief Sets the uncompressed size of each gzip member when using Compression::GzipStream.
+   * The default value is 256 KiB.
+   * @param value The frame size in bytes.
+   */
+  QUILL_ATTRIBUTE_COLD void set_compression_frame_size(size_t value);
+
+  /**
+   * @brief Sets how long the log messages are buffered while the backend thread is idle before
+   * a gzip member is written when using Compression::GzipStream. A value of zero writes a member
+   * on every idle flush. The default value is 1 second.
+   * @param value The maximum age of the buffered log messages.
+   */
+  QUILL_ATTRIBUTE_COLD void set_compression_frame_interval(std::chrono::milliseconds value);
+
+  /**
+   * @brief Sets whether the maximum file size is preallocated when each file is opened.
+   * The blocks are reserved with fallocate(FALLOC_FL_KEEP_SIZE) so the file size does not change
+   * and the appends do not have to allocate blocks. The unused blocks are released when the
+   * file is closed. Requires the rotation by file size and is only supported on linux.
+   * The default value is false.
+   * @param value True to preallocate the files, false otherwise.
+   */
+  QUILL_ATTRIBUTE_COLD void set_preallocate(bool value);
+
   /** Getter methods **/
   QUILL_NODISCARD size_t rotation_max_file_size() const noexcept { return _rotation_max_file_size; }
   QUILL_NODISCARD uint32_t max_backup_files() const noexcept { return _max_backup_files; }
   QUILL_NODISCARD bool overwrite_rolled_files() const noexcept { return _overwrite_rolled_files; }
   QUILL_NODISCARD bool remove_old_files() const noexcept { return _remove_old_files; }
+  QUILL_NODISCARD bool async_rotation() const noexcept { return _async_rotation; }
+  QUILL_NODISCARD Compression compression() const noexcept { return _compression; }
+  QUILL_NODISCARD size_t compression_frame_size() const noexcept { return _compression_frame_size; }
+  QUILL_NODISCARD std::chrono::milliseconds compression_frame_interval() const noexcept
+  {
+    return _compression_frame_interval;
+  }
+  QUILL_NODISCARD bool preallocate() const noexcept { return _preallocate; }
   QUILL_NODISCARD RotationFrequency rotation_frequency() const noexcept
   {
     return _rotation_frequency;
@@ -118,12 +196,17 @@ public:
 private:
   std::pair<std::chrono::hours, std::chrono::minutes> _rotation_at_time_daily;
   size_t _rotation_max_file_size{0};                                // 0 means disabled
+  size_t _compression_frame_size{256u * 1024u};
+  std::chrono::milliseconds _compression_frame_interval{1000};
   uint32_t _max_backup_files{std::numeric_limits<uint32_t>::max()}; // max means disabled
   uint32_t _rotation_interval{0};                                   // 0 means disabled
   RotationFrequency _rotation_frequency{RotationFrequency::Disabled};
   RotationNamingScheme _rotation_naming_scheme{RotationNamingScheme::Index};
+  Compression _compression{Compression::None};
   bool _overwrite_rolled_files{true};
   bool _remove_old_files{true};
+  bool _async_rotation{false};
+  bool _preallocate{false};
 };
 
 /**
@@ -148,9 +231,9 @@ public:
   /**
    * @brief Destructor.
    *
-   * Destroys the RotatingFileHandler object.
+   * Destroys the RotatingFileHandler object. Waits for any pending asynchronous rotation.
    */
-  ~RotatingFileHandler() override = default;
+  ~RotatingFileHandler() override;
 
   /**
    * @brief Write a formatted log message to the stream.
@@ -163,11 +246,34 @@ public:
   QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
                                  quill::TransitEvent const& log_event) override;
 
-private:
-  QUILL_NODISCARD bool _time_rotation(uint64_t record_timestamp_ns);
-  void _size_rotation(size_t log_msg_size, uint64_t record_timestamp_ns);
-  void _rotate_files(uint64_t record_timestamp_ns);
-  void _clean_and_recover_files(fs::path const& filename, std::string const& open_mode, uint64_t today_timestamp_ns);
+  /**
+   * @brief Flushes the stream, writing any pending compressed frame first.
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override;
+
+  /**
+   * @brief Flushes the stream when the backend thread is idle. A pending compressed frame is only
+   * written once it is older than the compression frame interval.
+   */
+  QUILL_ATTRIBUTE_HOT void idle_flush() noexcept override;
+
+  /**
+   * @brief Writes a pending compressed frame once it is older than the compression frame interval.
+   */
+  QUILL_ATTRIBUTE_HOT void run_loop() noexcept override;
+
+protected:
+  /**
+   * @brief Writes the formatted log message to the currently open file, after any rotation.
+   *
+   * @param formatted_log_message The formatted log message to write.
+   * @param log_event The log event associated with the message.
+   */
+  QUILL_ATTRIBUTE_HOT virtual void write_to_file(fmt_buffer_t const& formatted_log_message,
+                                                 quill::TransitEvent const& log_event);
+
+  void open_file(fs::path const& filename, std::string const& mode) override;
+  void close_file() override;
 
 private:
   struct FileInfo
@@ -182,6 +288,32 @@ private:
     uint32_t index;
   };
 
+  /**
+   * The renames and the removal that have to be done on disk for a rotation, in order
+   */
+  struct RotationPlan
+  {
+    std::vector<std::pair<fs::path, fs::path>> renames;
+    fs::path removed_file;
+    fs::path compressed_file; /**< The rotated file to compress, after the renames */
+  };
+
+private:
+  QUILL_NODISCARD bool _time_rotation(uint64_t record_timestamp_ns);
+  void _size_rotation(size_t log_msg_size, uint64_t record_timestamp_ns);
+  void _rotate_files(uint64_t record_timestamp_ns);
+  void _rotate_files_async(uint64_t record_timestamp_ns);
+  QUILL_NODISCARD RotationPlan _plan_rotation(fs::path const& current_file);
+  void _prepare_next_file();
+  void _write_frame();
+  QUILL_NODISCARD bool _write_frame_if_expired() noexcept;
+  QUILL_NODISCARD fs::path _backup_filename(FileInfo const& file_info) const;
+  QUILL_NODISCARD fs::path _strip_compression_extension(fs::path const& filename) const;
+  static void _execute_rotation_plan(RotationPlan const& plan);
+  static void _compress_file(fs::path const& filename);
+  void _preallocate_file(FILE* file) const noexcept;
+  void _clean_and_recover_files(fs::path const& filename, std::string const& open_mode, uint64_t today_timestamp_ns);
+
 private:
   FileEventNotifier _file_event_notifier;
   std::deque<FileInfo> _created_files; /**< We store in a queue the filenames we created, first: index, second: date/datetime, third: base_filename */
@@ -189,6 +321,16 @@ private:
   uint64_t _open_file_timestamp{0};    /**< The timestamp of the currently open file */
   size_t _file_size{0};                /**< The current file size */
   RotatingFileHandlerConfig _config;
+  fs::path _next_filename;                /**< The file created ahead of time for async rotation */
+  std::atomic<FILE*> _next_file{nullptr}; /**< Set by the rotation worker once the next file is open */
+  std::string _frame_buffer;              /**< Uncompressed messages of the next gzip member */
+  std::string _compressed_frame;          /**< Reused buffer for the compressed gzip member */
+  std::unique_ptr<detail::GzipCompressor> _compressor; /**< Reused for every gzip member */
+  std::chrono::steady_clock::time_point _frame_since{}; /**< First message of the next gzip member */
+  std::string _pending_error; /**< A frame write error detected during flush, reported on the next write */
+  uint32_t _rotation_count{0}; /**< Used to create a unique temporary rotated filename */
+  bool _async_rotation{false};
+  std::unique_ptr<detail::BackgroundWorker> _rotation_worker; /**< Set for async rotation or compression */
 };
 
 } // namespace quill
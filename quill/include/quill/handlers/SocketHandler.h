@@ -0,0 +1,192 @@
+/**
+ * Copyright(c) 2020-present, Odysseas Georgoudis & quill contributors.
+ * Distributed under the MIT License (http://opensource.org/licenses/MIT)
+ */
+
+#pragma once
+
+#include "quill/detail/misc/Attributes.h" // for QUILL_ATTRIBUTE_COLD, QUIL...
+#include "quill/handlers/Handler.h"       // for Handler
+#include <chrono>                         // for steady_clock
+#include <cstddef>                        // for size_t
+#include <cstdint>                        // for uint16_t, uint64_t
+#include <string>                         // for string
+#include <vector>                         // for vector
+
+namespace quill
+{
+/**
+ * The SocketHandlerConfig class holds the configuration options for the SocketHandler
+ */
+class SocketHandlerConfig
+{
+public:
+  enum class SocketType : uint8_t
+  {
+    UnixStream,   /**< AF_UNIX SOCK_STREAM, the address is the socket path */
+    UnixDatagram, /**< AF_UNIX SOCK_DGRAM, the address is the socket path */
+    Udp           /**< AF_INET SOCK_DGRAM, the address is an IPv4 address */
+  };
+
+  /**
+   * What happens to a log message when the outbound buffer is full
+   */
+  enum class OverflowPolicy : uint8_t
+  {
+    Drop, /**< The log message is dropped and counted */
+    Block /**< The backend thread waits until the socket is writable */
+  };
+
+  /**
+   * @brief Sets the socket type. The default value is UnixStream.
+   * @param value The socket type
+   */
+  QUILL_ATTRIBUTE_COLD void set_socket_type(SocketType value);
+
+  /**
+   * @brief Sets the address to connect to. This is the socket path for the unix sockets or an
+   * IPv4 address for Udp. The default value is "127.0.0.1".
+   * @param value The address
+   */
+  QUILL_ATTRIBUTE_COLD void set_address(std::string value);
+
+  /**
+   * @brief Sets the port to connect to, only used for Udp.
+   * @param value The port
+   */
+  QUILL_ATTRIBUTE_COLD void set_port(uint16_t value);
+
+  /**
+   * @brief Sets the maximum frame size. The log messages are packed into frames of up to this
+   * size. For the datagram sockets each frame is a datagram and a log message bigger than a frame
+   * is dropped. For the stream socket a frame is sent once it is full.
+   * The default value is 32 KiB.
+   * @param value The frame size in bytes
+   */
+  QUILL_ATTRIBUTE_COLD void set_max_frame_size(size_t value);
+
+  /**
+   * @brief Sets the maximum number of bytes buffered while the collector is slow or not
+   * connected. The default value is 4 MiB.
+   * @param value The buffer size in bytes
+   */
+  QUILL_ATTRIBUTE_COLD void set_buffer_size(size_t value);
+
+  /**
+   * @brief Sets what happens to a log message when the buffer is full. When blocking, messages
+   * are still dropped while the socket is not connected. The default value is Drop.
+   * @param value The overflow policy
+   */
+  QUILL_ATTRIBUTE_COLD void set_overflow_policy(OverflowPolicy value);
+
+  /**
+   * @brief Sets the logging pattern for the handler.
+   * @see PatternFormatter.h for more details on the pattern format.
+   * @param log_pattern: Specifies the format pattern for the log messages.
+   * @param time_format Specifies the format pattern for the log timestamps.
+   */
+  QUILL_ATTRIBUTE_COLD void set_pattern(std::string const& log_pattern,
+                                        std::string const& time_format = std::string{
+                                          "%H:%M:%S.%Qns"});
+
+  /** Getters **/
+  QUILL_NODISCARD SocketType socket_type() const noexcept { return _socket_type; }
+  QUILL_NODISCARD std::string const& address() const noexcept { return _address; }
+  QUILL_NODISCARD uint16_t port() const noexcept { return _port; }
+  QUILL_NODISCARD size_t max_frame_size() const noexcept { return _max_frame_size; }
+  QUILL_NODISCARD size_t buffer_size() const noexcept { return _buffer_size; }
+  QUILL_NODISCARD OverflowPolicy overflow_policy() const noexcept { return _overflow_policy; }
+  QUILL_NODISCARD std::string const& log_pattern() const noexcept { return _log_pattern; }
+  QUILL_NODISCARD std::string const& time_format() const noexcept { return _time_format; }
+
+private:
+  std::string _address{"127.0.0.1"};
+  std::string _log_pattern;
+  std::string _time_format;
+  size_t _max_frame_size{32u * 1024u};
+  size_t _buffer_size{4u * 1024u * 1024u};
+  uint16_t _port{0};
+  SocketType _socket_type{SocketType::UnixStream};
+  OverflowPolicy _overflow_policy{OverflowPolicy::Drop};
+};
+
+/**
+ * SocketHandler
+ * Sends the log messages to a local collector via a unix socket or udp.
+ *
+ * The log messages are packed into frames in an outbound buffer. The frames are sent with
+ * non-blocking sends when they are full or on flush, on linux the datagrams are sent in batches
+ * with sendmmsg. When the socket can not be connected or the connection is lost, a new connection
+ * is attempted at most once per second while the messages are buffered.
+ *
+ * @note Not supported on windows
+ */
+class SocketHandler : public Handler
+{
+public:
+  /**
+   * Constructor
+   * Attempts to connect the socket, the handler is still created when the collector is not
+   * available yet.
+   * @param config socket handler config
+   * @throws on invalid config or on windows
+   */
+  explicit SocketHandler(SocketHandlerConfig const& config);
+
+  /**
+   * Destructor
+   * Attempts to send the buffered messages and closes the socket
+   */
+  ~SocketHandler() override;
+
+  /**
+   * Appends a formatted log message to the outbound buffer
+   * @param formatted_log_message input log message to write
+   * @param log_event log_event
+   */
+  QUILL_ATTRIBUTE_HOT void write(fmt_buffer_t const& formatted_log_message,
+                                 quill::TransitEvent const& log_event) override;
+
+  /**
+   * Sends the buffered messages without blocking, unless the overflow policy is Block
+   */
+  QUILL_ATTRIBUTE_HOT void flush() noexcept override;
+
+  /**
+   * @return the number of log messages dropped because the buffer was full, because a log
+   * message was bigger than a datagram or because the connection was lost while a log message
+   * was partially sent
+   */
+  QUILL_NODISCARD uint64_t dropped_messages() const noexcept { return _dropped_messages; }
+
+  /**
+   * @return true if the socket is connected
+   */
+  QUILL_NODISCARD bool is_connected() const noexcept { return _fd != -1; }
+
+private:
+  void _connect() noexcept;
+  void _disconnect() noexcept;
+  void _close_frame() noexcept;
+  void _send_pending(bool block) noexcept;
+  QUILL_NODISCARD bool _send_frames() noexcept;
+  QUILL_NODISCARD bool _wait_writable() noexcept;
+  void _compact(bool force = false) noexcept;
+
+  QUILL_NODISCARD size_t _frame_start(size_t frame_index) const noexcept
+  {
+    return (frame_index == 0) ? 0 : _frame_ends[frame_index - 1];
+  }
+
+private:
+  SocketHandlerConfig _config;
+  std::string _buffer;               /** sent frames, unsent frames and the open frame */
+  std::vector<size_t> _frame_ends;   /** end offset of each closed frame in the buffer */
+  std::vector<size_t> _message_ends; /** end offset of each log message, only for streams */
+  size_t _sent_frames{0};            /** closed frames that were fully sent */
+  size_t _frame_sent_bytes{0};       /** bytes of the next frame already sent, only for streams */
+  std::chrono::steady_clock::time_point _next_connect_time{};
+  uint64_t _dropped_messages{0};
+  int _fd{-1};
+};
+} // namespace quill
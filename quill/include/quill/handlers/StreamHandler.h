@@ -27,6 +27,13 @@ struct FileEventNotifier
   std::function<void(fs::path const& filename, FILE* f)> before_close;
   std::function<void(fs::path const& filename)> after_close;
   std::function<std::string(std::string_view message)> before_write;
+
+  /**
+   * Alternative to before_write that does not allocate. The modified message is appended to
+   * `output`, which is cleared and reused for each log message, and a view of it is returned.
+   * Returning `message` writes the log message unchanged. When set, before_write is not called.
+   */
+  std::function<std::string_view(std::string_view message, fmt_buffer_t& output)> before_write_view;
 };
 
 class StreamHandler : public Handler
@@ -77,10 +84,30 @@ public:
 
   QUILL_NODISCARD bool is_null() const noexcept;
 
+protected:
+  /**
+   * Applies the before_write callback of the file event notifier if any
+   * @param formatted_log_message input log message
+   * @return the log message to write, valid until the next call
+   */
+  QUILL_NODISCARD QUILL_ATTRIBUTE_HOT std::string_view apply_before_write(fmt_buffer_t const& formatted_log_message);
+
+  /**
+   * @return true if a before_write callback is set
+   */
+  QUILL_NODISCARD bool has_before_write() const noexcept
+  {
+    return _file_event_notifier.before_write_view || _file_event_notifier.before_write;
+  }
+
 protected:
   fs::path _filename;
   FILE* _file{nullptr};
   FileEventNotifier _file_event_notifier;
   bool _is_null{false};
+
+private:
+  fmt_buffer_t _before_write_buffer;
+  std::string _before_write_message;
 };
 } // namespace quill
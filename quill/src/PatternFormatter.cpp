@@ -222,16 +222,29 @@ fmt_buffer_t const& PatternFormatter::format(std::chrono::nanoseconds timestamp,
                                              std::string_view thread_name, std::string_view process_id,
                                              std::string_view logger_name, std::string_view log_level,
                                              MacroMetadata const& macro_metadata,
-                                             transit_event_fmt_buffer_t const& log_msg)
+                                             fmtquill::detail::buffer<char> const& log_msg)
 {
   // clear out existing buffer
   _formatted_log_message.clear();
 
+  format_to(_formatted_log_message, timestamp, thread_id, thread_name, process_id, logger_name,
+            log_level, macro_metadata, log_msg);
+
+  return _formatted_log_message;
+}
+
+/***/
+void PatternFormatter::format_to(fmtquill::detail::buffer<char>& out, std::chrono::nanoseconds timestamp,
+                                 std::string_view thread_id, std::string_view thread_name,
+                                 std::string_view process_id, std::string_view logger_name,
+                                 std::string_view log_level, MacroMetadata const& macro_metadata,
+                                 fmtquill::detail::buffer<char> const& log_msg)
+{
   if (_format.empty())
   {
     // nothing to format when the given format is empty. This is useful e.g. in the JsonFileHandler
     // if we want to skip formatting the main message
-    return _formatted_log_message;
+    return;
   }
 
   if (_is_set_in_pattern[Attribute::AsciiTime])
@@ -296,10 +309,8 @@ fmt_buffer_t const& PatternFormatter::format(std::chrono::nanoseconds timestamp,
 
   _set_arg_val<Attribute::Message>(std::string_view{log_msg.begin(), log_msg.size()});
 
-  fmtquill::vformat_to(std::back_inserter(_formatted_log_message), _format,
+  fmtquill::vformat_to(std::back_inserter(out), _format,
                        fmtquill::basic_format_args(_args.data(), static_cast<int>(_args.size())));
-
-  return _formatted_log_message;
 }
 
 /***/
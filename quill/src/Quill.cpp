@@ -5,6 +5,7 @@
 #include "quill/detail/LoggerCollection.h"        // for LoggerCollection
 #include "quill/detail/ThreadContext.h"           // for ThreadContext, Thr...
 #include "quill/detail/ThreadContextCollection.h" // for ThreadContextColle...
+#include "quill/detail/misc/MemoryBudget.h"       // for MemoryBudget
 #include "quill/handlers/ConsoleHandler.h"        // for ConsoleHandler
 #include "quill/handlers/NullHandler.h"           // for NullHandler
 #include "quill/handlers/StreamHandler.h"         // for StreamHandler
@@ -24,6 +25,16 @@ QUILL_ATTRIBUTE_COLD void configure(Config const& config)
     QUILL_THROW(QuillError{"quill::configure(...) needs to be called before quill::start()"});
   }
 
+  if (config.enable_load_shedding &&
+      ((config.load_shedding_hysteresis > config.load_shedding_debug_watermark) ||
+       (config.load_shedding_debug_watermark > config.load_shedding_info_watermark) ||
+       (config.load_shedding_info_watermark > 100)))
+  {
+    QUILL_THROW(QuillError{
+      "Invalid config, the load shedding watermarks must satisfy load_shedding_hysteresis <= "
+      "load_shedding_debug_watermark <= load_shedding_info_watermark <= 100"});
+  }
+
   return detail::LogManagerSingleton::instance().log_manager().configure(config);
 }
 
@@ -73,6 +84,27 @@ std::shared_ptr<Handler> rotating_file_handler(fs::path const& base_filename,
   return create_handler<RotatingFileHandler>(base_filename.string(), config, std::move(file_event_notifier));
 }
 
+/***/
+std::shared_ptr<Handler> async_file_handler(fs::path const& filename, AsyncFileHandlerConfig const& config, /* = AsyncFileHandlerConfig{} */
+                                            FileEventNotifier file_event_notifier /* = FileEventNotifier{} */)
+{
+  return create_handler<AsyncFileHandler>(filename.string(), config, std::move(file_event_notifier));
+}
+
+/***/
+std::shared_ptr<Handler> buffered_file_handler(fs::path const& filename, BufferedFileHandlerConfig const& config, /* = BufferedFileHandlerConfig{} */
+                                               FileEventNotifier file_event_notifier /* = FileEventNotifier{} */)
+{
+  return create_handler<BufferedFileHandler>(filename.string(), config, std::move(file_event_notifier));
+}
+
+/***/
+std::shared_ptr<Handler> mmap_file_handler(fs::path const& base_filename, MmapFileHandlerConfig const& config, /* = MmapFileHandlerConfig{} */
+                                           FileEventNotifier file_event_notifier /* = FileEventNotifier{} */)
+{
+  return create_handler<MmapFileHandler>(base_filename.string(), config, std::move(file_event_notifier));
+}
+
 /***/
 std::shared_ptr<Handler> json_file_handler(fs::path const& filename, JsonFileHandlerConfig const& config, /* = JsonFileHandlerConfig{} */
                                            FileEventNotifier file_event_notifier /* = FileEventNotifier{} */)
@@ -80,6 +112,25 @@ std::shared_ptr<Handler> json_file_handler(fs::path const& filename, JsonFileHan
   return create_handler<JsonFileHandler>(filename.string(), config, std::move(file_event_notifier));
 }
 
+/***/
+std::shared_ptr<Handler> flight_recorder_handler(fs::path const& filename, FlightRecorderHandlerConfig const& config /* = FlightRecorderHandlerConfig{} */)
+{
+  return create_handler<FlightRecorderHandler>(filename.string(), filename, config);
+}
+
+/***/
+std::shared_ptr<Handler> socket_handler(std::string const& handler_name, SocketHandlerConfig const& config)
+{
+  return create_handler<SocketHandler>(handler_name, config);
+}
+
+/***/
+std::shared_ptr<Handler> async_handler(std::shared_ptr<Handler> handler, size_t capacity /* = 4u * 1024u * 1024u */,
+                                       AsyncHandler::OverflowPolicy overflow_policy /* = AsyncHandler::OverflowPolicy::Block */)
+{
+  return std::make_shared<AsyncHandler>(std::move(handler), capacity, overflow_policy);
+}
+
 /***/
 std::shared_ptr<Handler> null_handler() { return create_handler<NullHandler>("nullhandler"); }
 
@@ -163,4 +214,7 @@ void wake_up_logging_thread()
   detail::LogManagerSingleton::instance().log_manager().wake_up_backend_worker();
 }
 
+/***/
+size_t memory_usage() noexcept { return detail::MemoryBudget::instance().usage(); }
+
 } // namespace quill
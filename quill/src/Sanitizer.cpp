@@ -0,0 +1,368 @@
+#include "quill/Sanitizer.h"
+#include "quill/QuillError.h" // for QUILL_THROW, QuillError
+#include <algorithm>          // for find
+#include <cstring>            // for memcmp
+#include <string_view>        // for string_view
+#include <utility>            // for move, pair
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define QUILL_SANITIZER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define QUILL_SANITIZER_SSE2
+#endif
+
+#if defined(_MSC_VER) && (defined(QUILL_SANITIZER_AVX2) || defined(QUILL_SANITIZER_SSE2))
+  #include <intrin.h>
+#endif
+
+namespace
+{
+/***/
+QUILL_NODISCARD bool is_control(unsigned char c) noexcept { return (c < 0x20) || (c == 0x7F); }
+
+/***/
+QUILL_NODISCARD bool is_digit(char c) noexcept { return (c >= '0') && (c <= '9'); }
+
+#if defined(QUILL_SANITIZER_AVX2)
+constexpr size_t simd_width{32};
+#elif defined(QUILL_SANITIZER_SSE2)
+constexpr size_t simd_width{16};
+#endif
+
+#if defined(QUILL_SANITIZER_AVX2) || defined(QUILL_SANITIZER_SSE2)
+/***/
+QUILL_NODISCARD size_t count_trailing_zeros(uint32_t value) noexcept
+{
+  #if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, value);
+  return static_cast<size_t>(index);
+  #else
+  return static_cast<size_t>(__builtin_ctz(value));
+  #endif
+}
+#endif
+} // namespace
+
+namespace quill
+{
+/***/
+void SanitizerConfig::set_escape_control_characters(bool value)
+{
+  _escape_control_characters = value;
+}
+
+/***/
+void SanitizerConfig::add_redacted_literal(std::string literal)
+{
+  if (literal.empty())
+  {
+    QUILL_THROW(QuillError{"redacted literal must not be empty"});
+  }
+
+  _redacted_literals.push_back(std::move(literal));
+}
+
+/***/
+void SanitizerConfig::set_redacted_digit_run(size_t value) { _redacted_digit_run = value; }
+
+/***/
+void SanitizerConfig::set_redaction_mask(std::string value) { _redaction_mask = std::move(value); }
+
+/***/
+Sanitizer::Sanitizer(SanitizerConfig config) : _config(std::move(config))
+{
+  if (_config.escape_control_characters())
+  {
+    for (size_t c = 0; c < 256; ++c)
+    {
+      _candidates[c] = is_control(static_cast<unsigned char>(c));
+    }
+  }
+
+  if (_config.redacted_digit_run() != 0)
+  {
+    for (char c = '0'; c <= '9'; ++c)
+    {
+      _candidates[static_cast<unsigned char>(c)] = true;
+    }
+  }
+
+  for (auto const& literal : _config.redacted_literals())
+  {
+    _candidates[static_cast<unsigned char>(literal.front())] = true;
+
+    // the simd scan matches the first two bytes, which are rarely both found by chance
+    if (literal.size() == 1)
+    {
+      if (std::find(_literal_first_bytes.begin(), _literal_first_bytes.end(), literal.front()) ==
+          _literal_first_bytes.end())
+      {
+        _literal_first_bytes.push_back(literal.front());
+      }
+    }
+    else if (std::pair<char, char> const prefix{literal[0], literal[1]};
+             std::find(_literal_prefixes.begin(), _literal_prefixes.end(), prefix) == _literal_prefixes.end())
+    {
+      _literal_prefixes.push_back(prefix);
+    }
+  }
+
+  _has_work = _config.escape_control_characters() || (_config.redacted_digit_run() != 0) ||
+    !_config.redacted_literals().empty();
+}
+
+/***/
+fmtquill::detail::buffer<char> const& Sanitizer::sanitize(fmtquill::detail::buffer<char> const& log_message)
+{
+  char const* data = log_message.data();
+  size_t const size = log_message.size();
+
+  // the newline terminating the log message is not escaped
+  size_t const end = ((size != 0) && (data[size - 1] == '\n')) ? size - 1 : size;
+
+  _chunk_end = 0;
+  size_t pos = _has_work ? _find_candidate(data, 0, end) : end;
+
+  if (pos == end)
+  {
+    // the common case, nothing to do
+    return log_message;
+  }
+
+  size_t unchanged_begin{0};
+  _output.clear();
+
+  while (pos != end)
+  {
+    if (size_t const literal_size = _match_literal(data, pos, end); literal_size != 0)
+    {
+      _output.append(data + unchanged_begin, data + pos);
+      _output.append(std::string_view{_config.redaction_mask()});
+      pos += literal_size;
+      unchanged_begin = pos;
+    }
+    else if ((_config.redacted_digit_run() != 0) && is_digit(data[pos]))
+    {
+      auto const [run_end, digits] = _scan_digit_run(data, pos, end);
+
+      if (digits >= _config.redacted_digit_run())
+      {
+        _output.append(data + unchanged_begin, data + pos);
+        _output.append(std::string_view{_config.redaction_mask()});
+        unchanged_begin = run_end;
+      }
+
+      pos = run_end;
+    }
+    else if (_config.escape_control_characters() && is_control(static_cast<unsigned char>(data[pos])))
+    {
+      _output.append(data + unchanged_begin, data + pos);
+      _append_escaped(static_cast<unsigned char>(data[pos]));
+      ++pos;
+      unchanged_begin = pos;
+    }
+    else
+    {
+      // first byte of a literal that did not match
+      ++pos;
+    }
+
+    pos = _find_candidate(data, pos, end);
+  }
+
+  if (unchanged_begin == 0)
+  {
+    // nothing was changed e.g. there were only short digit runs
+    return log_message;
+  }
+
+  _output.append(data + unchanged_begin, data + size);
+  return _output;
+}
+
+/***/
+size_t Sanitizer::_find_candidate(char const* data, size_t begin, size_t end) noexcept
+{
+  size_t pos = begin;
+
+#if defined(QUILL_SANITIZER_AVX2) || defined(QUILL_SANITIZER_SSE2)
+  if (pos < _chunk_end)
+  {
+    // the remaining candidates of the last chunk
+    uint32_t const mask = _chunk_mask & (~uint32_t{0} << (pos - (_chunk_end - simd_width)));
+
+    if (mask != 0)
+    {
+      return _chunk_end - simd_width + count_trailing_zeros(mask);
+    }
+
+    pos = _chunk_end;
+  }
+
+  // the byte after each chunk is also read for the second byte of the literals
+  for (; pos + simd_width < end; pos += simd_width)
+  {
+    if (uint32_t const mask = _candidate_mask(data + pos); mask != 0)
+    {
+      _chunk_end = pos + simd_width;
+      _chunk_mask = mask;
+      return pos + count_trailing_zeros(mask);
+    }
+  }
+#endif
+
+  // the tail or the whole message without simd
+  while ((pos != end) && !_candidates[static_cast<unsigned char>(data[pos])])
+  {
+    ++pos;
+  }
+
+  return pos;
+}
+
+#if defined(QUILL_SANITIZER_AVX2)
+/***/
+uint32_t Sanitizer::_candidate_mask(char const* data) const noexcept
+{
+  __m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+  __m256i matches = _mm256_setzero_si256();
+
+  if (_config.escape_control_characters())
+  {
+    // unsigned v <= 0x1F or v == 0x7F
+    matches = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1F)), v),
+                              _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7F)));
+  }
+
+  if (_config.redacted_digit_run() != 0)
+  {
+    __m256i const d = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d));
+  }
+
+  for (char const c : _literal_first_bytes)
+  {
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)));
+  }
+
+  if (!_literal_prefixes.empty())
+  {
+    __m256i const next = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + 1));
+
+    for (auto const& [first, second] : _literal_prefixes)
+    {
+      matches = _mm256_or_si256(matches, _mm256_and_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(first)),
+                                                          _mm256_cmpeq_epi8(next, _mm256_set1_epi8(second))));
+    }
+  }
+
+  return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+#elif defined(QUILL_SANITIZER_SSE2)
+/***/
+uint32_t Sanitizer::_candidate_mask(char const* data) const noexcept
+{
+  __m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+  __m128i matches = _mm_setzero_si128();
+
+  if (_config.escape_control_characters())
+  {
+    // unsigned v <= 0x1F or v == 0x7F
+    matches = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v),
+                           _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7F)));
+  }
+
+  if (_config.redacted_digit_run() != 0)
+  {
+    __m128i const d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d));
+  }
+
+  for (char const c : _literal_first_bytes)
+  {
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(v, _mm_set1_epi8(c)));
+  }
+
+  if (!_literal_prefixes.empty())
+  {
+    __m128i const next = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + 1));
+
+    for (auto const& [first, second] : _literal_prefixes)
+    {
+      matches = _mm_or_si128(matches, _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(first)),
+                                                    _mm_cmpeq_epi8(next, _mm_set1_epi8(second))));
+    }
+  }
+
+  return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+#endif
+
+/***/
+size_t Sanitizer::_match_literal(char const* data, size_t pos, size_t end) const noexcept
+{
+  for (auto const& literal : _config.redacted_literals())
+  {
+    if ((literal.front() == data[pos]) && (literal.size() <= end - pos) &&
+        (std::memcmp(data + pos, literal.data(), literal.size()) == 0))
+    {
+      return literal.size();
+    }
+  }
+
+  return 0;
+}
+
+/***/
+std::pair<size_t, size_t> Sanitizer::_scan_digit_run(char const* data, size_t pos, size_t end) const noexcept
+{
+  size_t digits{0};
+  size_t run_end{pos};
+
+  while (pos != end)
+  {
+    if (is_digit(data[pos]))
+    {
+      ++digits;
+      run_end = ++pos;
+    }
+    else if (((data[pos] == ' ') || (data[pos] == '-')) && (pos + 1 != end) && is_digit(data[pos + 1]))
+    {
+      // a single separator between two digits
+      ++pos;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  return std::make_pair(run_end, digits);
+}
+
+/***/
+void Sanitizer::_append_escaped(unsigned char c)
+{
+  switch (c)
+  {
+  case '\n':
+    _output.append(std::string_view{"\\n"});
+    break;
+  case '\r':
+    _output.append(std::string_view{"\\r"});
+    break;
+  case '\t':
+    _output.append(std::string_view{"\\t"});
+    break;
+  default:
+  {
+    constexpr char hex_digits[] = "0123456789ABCDEF";
+    char const escaped[4] = {'\\', 'x', hex_digits[c >> 4], hex_digits[c & 0xF]};
+    _output.append(escaped, escaped + 4);
+  }
+  }
+}
+} // namespace quill
@@ -40,6 +40,19 @@ std::shared_ptr<Handler> HandlerCollection::get_handler(std::string const& handl
   return handler;
 }
 
+/***/
+std::string HandlerCollection::handler_name(Handler const* handler) const
+{
+  // Protect shared access
+  std::lock_guard<std::mutex> const lock{_mutex};
+
+  auto const search = std::find_if(_handler_collection.cbegin(), _handler_collection.cend(),
+                                   [handler](auto const& elem)
+                                   { return elem.second.lock().get() == handler; });
+
+  return (search != _handler_collection.cend()) ? search->first : std::string{};
+}
+
 /***/
 void HandlerCollection::subscribe_handler(std::shared_ptr<Handler> const& handler_to_insert)
 {
@@ -65,14 +78,14 @@ void HandlerCollection::subscribe_handler(std::shared_ptr<Handler> const& handle
   {
     // we don't have this object so add it
     _active_handlers_collection.push_back(handler_to_insert);
+    _active_handlers_version.fetch_add(1, std::memory_order_release);
   }
 }
 
 /***/
 void HandlerCollection::active_handlers(std::vector<std::weak_ptr<Handler>>& active_handlers_collection) const
 {
-  // Protect shared access, we just use a lock here since this function is not used when logging
-  // messages but only in special cases e.g. flushing
+  // Protect shared access, the backend thread only calls this when active_handlers_version() changed
   std::lock_guard<std::mutex> const lock{_mutex};
   active_handlers_collection = _active_handlers_collection;
 }
@@ -95,10 +108,15 @@ void HandlerCollection::remove_unused_handlers()
     }
   }
 
-  _active_handlers_collection.erase(
+  auto const removed_begin =
     std::remove_if(std::begin(_active_handlers_collection), std::end(_active_handlers_collection),
-                   [](std::weak_ptr<Handler> const& elem) { return elem.expired(); }),
-    std::end(_active_handlers_collection));
+                   [](std::weak_ptr<Handler> const& elem) { return elem.expired(); });
+
+  if (removed_begin != std::end(_active_handlers_collection))
+  {
+    _active_handlers_collection.erase(removed_begin, std::end(_active_handlers_collection));
+    _active_handlers_version.fetch_add(1, std::memory_order_release);
+  }
 }
 
 /***/
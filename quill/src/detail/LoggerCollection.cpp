@@ -4,7 +4,9 @@
 #include "quill/detail/LoggerDetails.h"     // for LoggerDetails
 #include "quill/detail/misc/Common.h"       // for QUILL_UNLIKELY
 #include "quill/handlers/StreamHandler.h"   // for StreamHandler
+#include <functional>                       // for hash
 #include <mutex>                            // for lock_guard
+#include <string_view>                      // for string_view
 #include <utility>                          // for move, pair
 #include <vector>                           // for vector
 
@@ -21,6 +23,8 @@ LoggerCollection::LoggerCollection(Config const& config, ThreadContextCollection
 {
   // Pre-allocate early to a reasonable size
   _logger_name_map.reserve(16);
+  _logger_tables.push_back(std::make_unique<LoggerTable>(32));
+  _logger_table.store(_logger_tables.back().get(), std::memory_order_release);
   create_root_logger();
 }
 
@@ -29,18 +33,19 @@ Logger* LoggerCollection::get_logger(char const* logger_name /* = nullptr */) co
 {
   if (logger_name)
   {
-    std::string logger_name_str{logger_name};
-    std::lock_guard<std::recursive_mutex> const lock{_rmutex};
+    std::string_view const logger_name_sv{logger_name};
+
+    // Search for the logger without locking
+    LoggerEntry const* entry = _find_entry(logger_name_sv, std::hash<std::string_view>{}(logger_name_sv));
+    Logger* logger = entry ? entry->logger.load(std::memory_order_acquire) : nullptr;
 
-    // Search for the logger
-    auto const search = _logger_name_map.find(logger_name_str);
-    if (QUILL_UNLIKELY(search == _logger_name_map.cend()))
+    if (QUILL_UNLIKELY(!logger))
     {
       // logger does not exist
-      QUILL_THROW(QuillError{std::string{"logger does not exist. name: "} + logger_name_str});
+      QUILL_THROW(QuillError{std::string{"logger does not exist. name: "} + logger_name});
     }
 
-    return (*search).second.get();
+    return logger;
   }
   else
   {
@@ -63,6 +68,116 @@ QUILL_NODISCARD std::unordered_map<std::string, Logger*> LoggerCollection::get_a
   return logger_names;
 }
 
+/***/
+LoggerCollection::LoggerEntry* LoggerCollection::_find_entry(std::string_view logger_name, size_t hash) const noexcept
+{
+  LoggerTable const* table = _logger_table.load(std::memory_order_acquire);
+
+  // the table is at most half full, the probing always ends at an empty slot
+  for (size_t i = hash & table->mask;; i = (i + 1) & table->mask)
+  {
+    LoggerEntry* entry = table->slots[i].load(std::memory_order_acquire);
+
+    if (!entry)
+    {
+      return nullptr;
+    }
+
+    if ((entry->hash == hash) && (entry->name == logger_name))
+    {
+      return entry;
+    }
+  }
+}
+
+/***/
+void LoggerCollection::_publish_logger(std::string const& logger_name, Logger* logger)
+{
+  if (logger->_logger_details.timestamp_clock_type() == TimestampClockType::Coarse)
+  {
+    _has_coarse_clock_loggers.store(true, std::memory_order_release);
+  }
+
+  size_t const hash = std::hash<std::string_view>{}(logger_name);
+  LoggerEntry* entry = _find_entry(logger_name, hash);
+
+  if (!entry)
+  {
+    LoggerTable* table = _logger_table.load(std::memory_order_relaxed);
+
+    if ((table->size + 1) * 2 > table->mask + 1)
+    {
+      // copy the entries to a bigger table, the old table stays valid for concurrent lookups
+      auto new_table = std::make_unique<LoggerTable>((table->mask + 1) * 2);
+      for (auto const& existing_entry : _logger_entries)
+      {
+        size_t i = existing_entry->hash & new_table->mask;
+        while (new_table->slots[i].load(std::memory_order_relaxed))
+        {
+          i = (i + 1) & new_table->mask;
+        }
+
+        new_table->slots[i].store(existing_entry.get(), std::memory_order_relaxed);
+        ++new_table->size;
+      }
+
+      table = new_table.get();
+      _logger_tables.push_back(std::move(new_table));
+      _logger_table.store(table, std::memory_order_release);
+    }
+
+    _logger_entries.push_back(std::make_unique<LoggerEntry>(logger_name, hash));
+    entry = _logger_entries.back().get();
+
+    size_t i = hash & table->mask;
+    while (table->slots[i].load(std::memory_order_relaxed))
+    {
+      i = (i + 1) & table->mask;
+    }
+
+    table->slots[i].store(entry, std::memory_order_release);
+    ++table->size;
+  }
+
+  entry->logger.store(logger, std::memory_order_release);
+}
+
+/***/
+void LoggerCollection::_unpublish_logger(std::string const& logger_name) noexcept
+{
+  LoggerEntry* entry = _find_entry(logger_name, std::hash<std::string_view>{}(logger_name));
+
+  if (entry)
+  {
+    entry->logger.store(nullptr, std::memory_order_release);
+  }
+}
+
+/***/
+void LoggerCollection::_subscribe_handlers(std::vector<std::shared_ptr<Handler>> const& handlers)
+{
+  for (auto const& handler : handlers)
+  {
+    _handler_collection.subscribe_handler(handler);
+  }
+}
+
+/***/
+Logger* LoggerCollection::_insert_logger(std::string const& logger_name, std::unique_ptr<Logger> logger)
+{
+  std::lock_guard<std::recursive_mutex> const lock{_rmutex};
+
+  auto const insert_result = _logger_name_map.emplace(logger_name, std::move(logger));
+
+  if (insert_result.second)
+  {
+    _publish_logger(logger_name, (*insert_result.first).second.get());
+  }
+
+  // Return the inserted logger or the existing logger
+  return (*insert_result.first).second.get();
+}
+
 /***/
 Logger* LoggerCollection::create_logger(std::string const& logger_name, TimestampClockType timestamp_clock_type,
                                         TimestampClock* timestamp_clock)
@@ -80,13 +195,8 @@ Logger* LoggerCollection::create_logger(std::string const& logger_name, Timestam
   std::unique_ptr<Logger> logger{new Logger(logger_name, handlers, timestamp_clock_type,
                                             timestamp_clock, _thread_context_collection)};
 
-  std::lock_guard<std::recursive_mutex> const lock{_rmutex};
-
   // Place the logger in our map
-  auto const insert_result = _logger_name_map.emplace(std::string{logger_name}, std::move(logger));
-
-  // Return the inserted logger or the existing logger
-  return (*insert_result.first).second.get();
+  return _insert_logger(logger_name, std::move(logger));
 }
 
 /***/
@@ -100,12 +210,8 @@ Logger* LoggerCollection::create_logger(std::string const& logger_name, std::sha
   std::unique_ptr<Logger> logger{new Logger(logger_name, std::move(handler), timestamp_clock_type,
                                             timestamp_clock, _thread_context_collection)};
 
-  std::lock_guard<std::recursive_mutex> const lock{_rmutex};
-
-  auto const insert_result = _logger_name_map.emplace(std::string{logger_name}, std::move(logger));
-
   // Return the inserted logger or the existing logger
-  return (*insert_result.first).second.get();
+  return _insert_logger(logger_name, std::move(logger));
 }
 
 /***/
@@ -133,12 +239,8 @@ QUILL_NODISCARD Logger* LoggerCollection::create_logger(std::string const& logge
   std::unique_ptr<Logger> logger{new Logger(logger_name, handlers, timestamp_clock_type,
                                             timestamp_clock, _thread_context_collection)};
 
-  std::lock_guard<std::recursive_mutex> const lock{_rmutex};
-
-  auto const insert_result = _logger_name_map.emplace(std::string{logger_name}, std::move(logger));
-
   // Return the inserted logger or the existing logger
-  return (*insert_result.first).second.get();
+  return _insert_logger(logger_name, std::move(logger));
 }
 
 /***/
@@ -221,6 +323,11 @@ void LoggerCollection::create_root_logger()
       std::unique_ptr<Logger> logger = std::move(search->second);
 
       // now we can erase the logger from the map in case the name is different
+      if (search->first != _config.default_logger_name)
+      {
+        _unpublish_logger(search->first);
+      }
+
       _logger_name_map.erase(search);
 
       // update the root logger
@@ -231,7 +338,9 @@ void LoggerCollection::create_root_logger()
       logger->_custom_timestamp_clock = _config.default_custom_timestamp_clock;
 
       // add back the logger to the map
+      Logger* root_logger = logger.get();
       _logger_name_map.emplace(std::string{_config.default_logger_name}, std::move(logger));
+      _publish_logger(_config.default_logger_name, root_logger);
     }
     else
     {
@@ -250,6 +359,11 @@ void LoggerCollection::create_root_logger()
       std::unique_ptr<Logger> logger = std::move(search->second);
 
       // now we can erase the logger from the map in case the name is different
+      if (search->first != _config.default_logger_name)
+      {
+        _unpublish_logger(search->first);
+      }
+
       _logger_name_map.erase(search);
 
       // update the root logger
@@ -259,7 +373,9 @@ void LoggerCollection::create_root_logger()
       logger->_custom_timestamp_clock = _config.default_custom_timestamp_clock;
 
       // add back the logger to the map
+      Logger* root_logger = logger.get();
       _logger_name_map.emplace(std::string{_config.default_logger_name}, std::move(logger));
+      _publish_logger(_config.default_logger_name, root_logger);
     }
   }
 }
@@ -293,6 +409,7 @@ bool LoggerCollection::remove_invalidated_loggers(std::function<bool(void)> cons
         else
         {
           loggers_removed = true;
+          _unpublish_logger(it->first);
           it = _logger_name_map.erase(it);
         }
       }
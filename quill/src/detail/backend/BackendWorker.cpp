@@ -127,13 +127,15 @@ std::pair<std::string, std::vector<std::string>> BackendWorker::_process_structu
 /***/
 void BackendWorker::_resync_rdtsc_clock()
 {
-  if (_rdtsc_clock.load(std::memory_order_relaxed))
+  RdtscClock const* rdtsc_clock = _rdtsc_clock.load(std::memory_order_relaxed);
+  if (rdtsc_clock)
   {
     // resync in rdtsc if we are not logging so that time_since_epoch() still works
     auto const now = std::chrono::system_clock::now();
-    if ((now - _last_rdtsc_resync) > _rdtsc_resync_interval)
+    // the clock starts from rdtsc_resync_interval and adapts it to the accuracy target
+    if ((now - _last_rdtsc_resync) > rdtsc_clock->resync_interval())
     {
-      _rdtsc_clock.load(std::memory_order_relaxed)->resync(2500);
+      rdtsc_clock->resync(2500);
       _last_rdtsc_resync = now;
     }
   }
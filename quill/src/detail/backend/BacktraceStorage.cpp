@@ -2,10 +2,19 @@
 #include "quill/QuillError.h" // for QUILL_THROW, Quil...
 #include "quill/detail/LoggerDetails.h"
 #include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/MemoryBudget.h"
 #include "quill/detail/misc/Os.h"
 
 namespace quill::detail
 {
+/***/
+BacktraceStorage::~BacktraceStorage()
+{
+  for (auto& stored_records : _stored_records_map)
+  {
+    _clear(stored_records.second.stored_records_collection);
+  }
+}
 
 /***/
 void BacktraceStorage::store(TransitEvent transit_event)
@@ -25,11 +34,24 @@ void BacktraceStorage::store(TransitEvent transit_event)
   std::string tn = std::string{transit_event.thread_name};
   std::string ti = std::string{transit_event.thread_id};
 
-  if (stored_object_info.stored_records_collection.size() < stored_object_info.capacity)
+  StoredRecordsCollection& stored_records_collection = stored_object_info.stored_records_collection;
+  size_t const memory_size = sizeof(StoredTransitEvent) + tn.capacity() + ti.capacity() +
+    transit_event.formatted_msg.capacity();
+
+  // when the budget is exceeded we stop growing and replace the oldest message instead
+  if ((stored_records_collection.size() < stored_object_info.capacity) &&
+      (stored_records_collection.empty() ||
+       MemoryBudget::instance().try_acquire(memory_size, LogLevel::Backtrace)))
   {
+    if (stored_records_collection.empty())
+    {
+      // always keep the latest message
+      MemoryBudget::instance().acquire(memory_size);
+    }
+
     // We are still growing the vector to max capacity
-    auto& emplaced =
-      stored_object_info.stored_records_collection.emplace_back(tn, ti, std::move(transit_event));
+    auto& emplaced = stored_records_collection.emplace_back(tn, ti, std::move(transit_event));
+    emplaced.memory_size = memory_size;
 
     // we want to point the transit event objects to ours because they can point to invalid memory
     // if the thread is destructed
@@ -39,16 +61,19 @@ void BacktraceStorage::store(TransitEvent transit_event)
   else
   {
     // Store the object in the vector
-    StoredTransitEvent& ste = stored_object_info.stored_records_collection[stored_object_info.index];
+    StoredTransitEvent& ste = stored_records_collection[stored_object_info.index];
+    MemoryBudget::instance().release(ste.memory_size);
+    MemoryBudget::instance().acquire(memory_size);
     ste = StoredTransitEvent{tn, ti, std::move(transit_event)};
+    ste.memory_size = memory_size;
 
     // we want to point the transit event objects to ours because they can point to invalid memory
     // if the thread is destructed
     ste.transit_event.thread_name = ste.thread_name.data();
     ste.transit_event.thread_id = ste.thread_id.data();
 
-    // Update the index wrapping around the vector capacity
-    if (stored_object_info.index < stored_object_info.capacity - 1)
+    // Update the index wrapping around the stored messages
+    if (stored_object_info.index < stored_records_collection.size() - 1)
     {
       stored_object_info.index += 1;
     }
@@ -92,7 +117,8 @@ void BacktraceStorage::process(std::string const& logger_name,
   }
 
   // finally clean all messages
-  stored_record_collection.clear();
+  _clear(stored_record_collection);
+  stored_records_it->second.index = 0;
 }
 
 /***/
@@ -109,7 +135,8 @@ void BacktraceStorage::set_capacity(std::string const& logger_name, uint32_t cap
     // store the new capacity if the new capacity is different
     if (stored_object_info.capacity != capacity)
     {
-      stored_object_info.stored_records_collection.clear();
+      _clear(stored_object_info.stored_records_collection);
+      stored_object_info.index = 0;
       stored_object_info.capacity = capacity;
     }
   }
@@ -123,8 +150,20 @@ void BacktraceStorage::clear(std::string const& logger_name)
   if (QUILL_LIKELY(stored_records_it != _stored_records_map.end()))
   {
     // we found stored messages for this logger
-    stored_records_it->second.stored_records_collection.clear();
+    _clear(stored_records_it->second.stored_records_collection);
+    stored_records_it->second.index = 0;
+  }
+}
+
+/***/
+void BacktraceStorage::_clear(StoredRecordsCollection& stored_records_collection)
+{
+  for (StoredTransitEvent const& stored_transit_event : stored_records_collection)
+  {
+    MemoryBudget::instance().release(stored_transit_event.memory_size);
   }
+
+  stored_records_collection.clear();
 }
 
 } // namespace quill::detail
\ No newline at end of file
@@ -16,6 +16,29 @@ std::array<char const*, 4> specifier_name{"", "%Qms", "%Qus", "%Qns"};
 
 // All special specifiers have same length at the moment
 constexpr size_t specifier_length = 4u;
+
+// Contains the fixed format name, at the same index as the enum
+std::array<char const*, 7> fixed_format_name{"",           "%Qepoch_ms",   "%Qepoch_us",
+                                             "%Qepoch_ns", "%Qiso8601_ms", "%Qiso8601_us",
+                                             "%Qiso8601_ns"};
+
+// "YYYY-MM-DDTHH:MM:SS." the fractional seconds begin after this prefix
+constexpr size_t iso8601_date_length = 11u;
+constexpr size_t iso8601_hour_index = 11u;
+constexpr size_t iso8601_minute_index = 14u;
+constexpr size_t iso8601_second_index = 17u;
+constexpr size_t iso8601_fractional_index = 20u;
+
+constexpr int64_t seconds_per_day = 86'400;
+
+/**
+ * Writes a two digit number to the given destination
+ */
+QUILL_ALWAYS_INLINE void write_two_digits(char* dest, uint32_t value)
+{
+  dest[0] = static_cast<char>('0' + (value / 10));
+  dest[1] = static_cast<char>('0' + (value % 10));
+}
 } // namespace
 
 namespace quill::detail
@@ -29,6 +52,47 @@ TimestampFormatter::TimestampFormatter(std::string const& timestamp_format_strin
   assert((_timezone_type == Timezone::LocalTime || _timezone_type == Timezone::GmtTime) &&
          "Invalid timezone type");
 
+  // check for the fixed layout formats first, those can only be used on their own
+  for (uint8_t i = FixedFormat::EpochMs; i <= FixedFormat::Iso8601Ns; ++i)
+  {
+    if (timestamp_format_string == fixed_format_name[i])
+    {
+      _fixed_format = static_cast<FixedFormat>(i);
+
+      if (_fixed_format == FixedFormat::Iso8601Ms)
+      {
+        _iso8601_fractional_digits = 3;
+      }
+      else if (_fixed_format == FixedFormat::Iso8601Us)
+      {
+        _iso8601_fractional_digits = 6;
+      }
+      else if (_fixed_format == FixedFormat::Iso8601Ns)
+      {
+        _iso8601_fractional_digits = 9;
+      }
+
+      if (_iso8601_fractional_digits != 0)
+      {
+        // "YYYY-MM-DDTHH:MM:SS." + fractional seconds + "Z", the date is populated on first use
+        _formatted_date.assign(iso8601_fractional_index + _iso8601_fractional_digits + 1, '0');
+        _formatted_date[iso8601_hour_index + 2] = ':';
+        _formatted_date[iso8601_minute_index + 2] = ':';
+        _formatted_date[iso8601_second_index + 2] = '.';
+        _formatted_date.back() = 'Z';
+      }
+
+      return;
+    }
+
+    if (timestamp_format_string.find(fixed_format_name[i]) != std::string::npos)
+    {
+      QUILL_THROW(QuillError{"format specifiers %Qepoch_ms, %Qepoch_us, %Qepoch_ns, %Qiso8601_ms, "
+                             "%Qiso8601_us and %Qiso8601_ns can not be combined with other "
+                             "specifiers"});
+    }
+  }
+
   // store the beginning of the found specifier
   size_t specifier_begin{std::string::npos};
 
@@ -90,6 +154,12 @@ TimestampFormatter::TimestampFormatter(std::string const& timestamp_format_strin
 /***/
 std::string_view TimestampFormatter::format_timestamp(std::chrono::nanoseconds time_since_epoch)
 {
+  if (QUILL_UNLIKELY(_fixed_format != FixedFormat::NoFixedFormat))
+  {
+    return (_iso8601_fractional_digits != 0) ? _format_iso8601(time_since_epoch)
+                                             : _format_epoch(time_since_epoch);
+  }
+
   int64_t const timestamp_ns = time_since_epoch.count();
 
   // convert timestamp to seconds
@@ -154,4 +224,69 @@ void TimestampFormatter::_append_fractional_seconds(uint32_t extracted_fractiona
          extracted_ms_string.data(), extracted_ms_string.size());
 }
 
+/***/
+std::string_view TimestampFormatter::_format_epoch(std::chrono::nanoseconds time_since_epoch)
+{
+  int64_t timestamp = time_since_epoch.count();
+
+  if (_fixed_format == FixedFormat::EpochMs)
+  {
+    timestamp /= 1'000'000;
+  }
+  else if (_fixed_format == FixedFormat::EpochUs)
+  {
+    timestamp /= 1'000;
+  }
+
+  fmtquill::format_int const timestamp_string{timestamp};
+  _formatted_date.assign(timestamp_string.data(), timestamp_string.size());
+  return std::string_view{_formatted_date};
+}
+
+/***/
+std::string_view TimestampFormatter::_format_iso8601(std::chrono::nanoseconds time_since_epoch)
+{
+  int64_t const timestamp_ns = time_since_epoch.count();
+  int64_t const timestamp_secs = timestamp_ns / 1'000'000'000;
+
+  if (QUILL_UNLIKELY((timestamp_secs < _iso8601_day_begin_secs) ||
+                     (timestamp_secs >= _iso8601_day_end_secs)))
+  {
+    // The day changed, recalculate the cached date part
+    auto const raw_ts = static_cast<time_t>(timestamp_secs);
+    tm time_info{};
+    gmtime_rs(std::addressof(raw_ts), std::addressof(time_info));
+
+    fmtquill::format_to_n(_formatted_date.data(), iso8601_date_length, "{:04d}-{:02d}-{:02d}T",
+                          time_info.tm_year + 1900, time_info.tm_mon + 1, time_info.tm_mday);
+
+    _iso8601_day_begin_secs =
+      timestamp_secs - (time_info.tm_hour * 3600 + time_info.tm_min * 60 + time_info.tm_sec);
+    _iso8601_day_end_secs = _iso8601_day_begin_secs + seconds_per_day;
+  }
+
+  // Patch the time of the day
+  auto seconds_of_day = static_cast<uint32_t>(timestamp_secs - _iso8601_day_begin_secs);
+  write_two_digits(&_formatted_date[iso8601_hour_index], seconds_of_day / 3600);
+  seconds_of_day %= 3600;
+  write_two_digits(&_formatted_date[iso8601_minute_index], seconds_of_day / 60);
+  write_two_digits(&_formatted_date[iso8601_second_index], seconds_of_day % 60);
+
+  // Patch the fractional seconds, written right to left
+  auto fractional = static_cast<uint32_t>(timestamp_ns - (timestamp_secs * 1'000'000'000));
+  for (uint32_t i = _iso8601_fractional_digits; i < 9; ++i)
+  {
+    fractional /= 10;
+  }
+
+  size_t const fractional_end = iso8601_fractional_index + _iso8601_fractional_digits;
+  for (size_t i = fractional_end; i > iso8601_fractional_index; --i)
+  {
+    _formatted_date[i - 1] = static_cast<char>('0' + (fractional % 10));
+    fractional /= 10;
+  }
+
+  return std::string_view{_formatted_date};
+}
+
 } // namespace quill::detail
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "quill/detail/backend/TransitEventBuffer.h"
 
 #include "quill/QuillError.h"
+#include "quill/detail/misc/MemoryBudget.h"
 #include "quill/detail/misc/Utilities.h"
 
 #include <limits>
@@ -82,6 +83,7 @@ template class BoundedTransitEventBufferImpl<uint8_t>;
 UnboundedTransitEventBuffer::UnboundedTransitEventBuffer(uint32_t initial_transit_buffer_capacity)
   : _writer(new Node(initial_transit_buffer_capacity)), _reader(_writer)
 {
+  MemoryBudget::instance().acquire(_writer->memory_size());
 }
 
 /***/
@@ -94,6 +96,7 @@ UnboundedTransitEventBuffer::~UnboundedTransitEventBuffer()
   {
     auto to_delete = reader_node;
     reader_node = reader_node->next;
+    MemoryBudget::instance().release(to_delete->memory_size());
     delete to_delete;
   }
 }
@@ -112,6 +115,7 @@ TransitEvent* UnboundedTransitEventBuffer::front() noexcept
 
       // switch to the new buffer, existing one is deleted
       Node* next_node = _reader->next;
+      MemoryBudget::instance().release(_reader->memory_size());
       delete _reader;
       _reader = next_node;
       next_event = _reader->transit_buffer.front();
@@ -142,14 +146,19 @@ TransitEvent* UnboundedTransitEventBuffer::back() noexcept
       capacity = max_bounded_queue_capacity;
     }
 
+    // the backend thread never waits, it stops reading the queues until the buffer is drained
+    if (!MemoryBudget::instance().try_acquire(static_cast<size_t>(capacity) * sizeof(TransitEvent),
+                                              LogLevel::Critical))
+    {
+      return nullptr;
+    }
+
     auto new_node = new Node{static_cast<uint32_t>(capacity)};
     _writer->next = new_node;
     _writer = _writer->next;
     write_event = _writer->transit_buffer.back();
   }
 
-  assert(write_event && "Write event is always true");
-
   return write_event;
 }
 
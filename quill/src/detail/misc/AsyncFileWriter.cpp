@@ -0,0 +1,475 @@
+#include "quill/detail/misc/AsyncFileWriter.h"
+#include "quill/Fmt.h"        // for format
+#include "quill/QuillError.h" // for QUILL_THROW, QuillError
+#include "quill/detail/misc/Common.h" // for QUILL_UNLIKELY
+#include <algorithm>          // for max
+#include <cassert>            // for assert
+#include <cerrno>             // for errno, EINTR, EAGAIN
+#include <condition_variable> // for condition_variable
+#include <cstring>            // for strerror, memset
+#include <deque>              // for deque
+#include <mutex>              // for mutex, unique_lock
+#include <string>             // for string
+#include <thread>             // for thread
+
+#if defined(_WIN32)
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+  #if __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+
+    #if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+      #define QUILL_HAS_IO_URING 1
+    #endif
+  #endif
+#endif
+
+namespace
+{
+/**
+ * Writes the whole buffer at the given offset
+ * @return an error message or an empty string on success
+ */
+std::string write_fully(int fd, char const* data, size_t size, uint64_t offset)
+{
+  while (size != 0)
+  {
+#if defined(_WIN32)
+    if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) == -1)
+    {
+      return fmtquill::format("lseek failed with error message errno: \"{}\" {}", errno, strerror(errno));
+    }
+
+    auto const written = _write(fd, data, static_cast<unsigned int>(size));
+#else
+    auto const written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+#endif
+
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      return fmtquill::format("write failed with error message errno: \"{}\" {}", errno, strerror(errno));
+    }
+
+    data += written;
+    size -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+
+  return std::string{};
+}
+
+/**
+ * Does the writes in submission order on a dedicated thread
+ */
+class ThreadFileWriter final : public quill::detail::AsyncFileWriter
+{
+public:
+  ThreadFileWriter() : _thread([this]() { _run(); }) {}
+
+  ~ThreadFileWriter() override
+  {
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+      _stop = true;
+    }
+
+    _cv.notify_all();
+    _thread.join();
+  }
+
+  /***/
+  void submit(uint32_t buffer_index, char const* data, size_t size, int fd, uint64_t offset) override
+  {
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+      _pending.push_back(WriteRequest{data, size, offset, fd, buffer_index});
+    }
+
+    _cv.notify_all();
+  }
+
+  /***/
+  QUILL_NODISCARD std::string reap(bool wait, std::vector<uint32_t>& completed) override
+  {
+    std::unique_lock<std::mutex> lock{_mutex};
+
+    if (wait)
+    {
+      _cv.wait(lock, [this]() { return !_completed.empty() || !_error.empty(); });
+    }
+
+    completed.insert(completed.end(), _completed.begin(), _completed.end());
+    _completed.clear();
+
+    std::string error;
+    error.swap(_error);
+    return error;
+  }
+
+  /***/
+  QUILL_NODISCARD bool is_io_uring() const noexcept override { return false; }
+
+private:
+  struct WriteRequest
+  {
+    char const* data;
+    size_t size;
+    uint64_t offset;
+    int fd;
+    uint32_t buffer_index;
+  };
+
+  /***/
+  void _run()
+  {
+    std::unique_lock<std::mutex> lock{_mutex};
+
+    while (true)
+    {
+      _cv.wait(lock, [this]() { return _stop || !_pending.empty(); });
+
+      if (_pending.empty())
+      {
+        // only stop once all the pending writes are done
+        return;
+      }
+
+      WriteRequest const request = _pending.front();
+      _pending.pop_front();
+
+      lock.unlock();
+      std::string error = write_fully(request.fd, request.data, request.size, request.offset);
+      lock.lock();
+
+      if (QUILL_UNLIKELY(!error.empty()))
+      {
+        _error = std::move(error);
+      }
+
+      // the buffer is always returned so that it can be reused
+      _completed.push_back(request.buffer_index);
+      _cv.notify_all();
+    }
+  }
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque<WriteRequest> _pending;
+  std::vector<uint32_t> _completed;
+  std::string _error;
+  bool _stop{false};
+  std::thread _thread; /** must be last, it uses the members above */
+};
+
+#if defined(QUILL_HAS_IO_URING)
+/**
+ * Submits the writes to an io_uring. The rings are mapped directly without liburing.
+ */
+class UringFileWriter final : public quill::detail::AsyncFileWriter
+{
+public:
+  /**
+   * @return the writer or nullptr when io_uring is not available, e.g. old kernel or blocked by seccomp
+   */
+  static std::unique_ptr<quill::detail::AsyncFileWriter> create(uint32_t max_in_flight)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    int const ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, max_in_flight, &params));
+
+    if (ring_fd < 0)
+    {
+      return nullptr;
+    }
+
+    std::unique_ptr<UringFileWriter> writer{new UringFileWriter{ring_fd, max_in_flight}};
+
+    if (!writer->_map_rings(params))
+    {
+      return nullptr;
+    }
+
+    return writer;
+  }
+
+  ~UringFileWriter() override
+  {
+    if (_sqes)
+    {
+      ::munmap(_sqes, _sqes_size);
+    }
+
+    if (_cq_ring && (_cq_ring != _sq_ring))
+    {
+      ::munmap(_cq_ring, _cq_ring_size);
+    }
+
+    if (_sq_ring)
+    {
+      ::munmap(_sq_ring, _sq_ring_size);
+    }
+
+    ::close(_ring_fd);
+  }
+
+  /***/
+  void submit(uint32_t buffer_index, char const* data, size_t size, int fd, uint64_t offset) override
+  {
+    assert(buffer_index < _requests.size() && "buffer_index is out of range");
+
+    WriteRequest& request = _requests[buffer_index];
+    request.iov.iov_base = const_cast<char*>(data);
+    request.iov.iov_len = size;
+    request.offset = offset;
+    request.fd = fd;
+
+    _push_sqe(buffer_index);
+    _enter(1, 0, 0);
+  }
+
+  /***/
+  QUILL_NODISCARD std::string reap(bool wait, std::vector<uint32_t>& completed) override
+  {
+    uint32_t head = *_cq_head;
+
+    if (wait && (head == __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)))
+    {
+      _enter(0, 1, IORING_ENTER_GETEVENTS);
+    }
+
+    uint32_t const tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+    uint32_t to_resubmit{0};
+    std::string error;
+
+    while (head != tail)
+    {
+      io_uring_cqe const& cqe = _cqes[head & _cq_mask];
+      auto const buffer_index = static_cast<uint32_t>(cqe.user_data);
+      int32_t const res = cqe.res;
+      ++head;
+
+      WriteRequest& request = _requests[buffer_index];
+
+      if ((res == -EINTR) || (res == -EAGAIN))
+      {
+        _push_sqe(buffer_index);
+        ++to_resubmit;
+      }
+      else if ((res <= 0) && (request.iov.iov_len != 0))
+      {
+        error = fmtquill::format("io_uring write failed with error message errno: \"{}\" {}", -res,
+                                 strerror(-res));
+        completed.push_back(buffer_index);
+      }
+      else if (static_cast<size_t>(res) < request.iov.iov_len)
+      {
+        // short write, submit the remaining part
+        request.iov.iov_base = static_cast<char*>(request.iov.iov_base) + res;
+        request.iov.iov_len -= static_cast<size_t>(res);
+        request.offset += static_cast<uint64_t>(res);
+        _push_sqe(buffer_index);
+        ++to_resubmit;
+      }
+      else
+      {
+        completed.push_back(buffer_index);
+      }
+    }
+
+    __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+
+    if (to_resubmit != 0)
+    {
+      _enter(to_resubmit, 0, 0);
+    }
+
+    return error;
+  }
+
+  /***/
+  QUILL_NODISCARD bool is_io_uring() const noexcept override { return true; }
+
+private:
+  struct WriteRequest
+  {
+    iovec iov;
+    uint64_t offset;
+    int fd;
+  };
+
+  UringFileWriter(int ring_fd, uint32_t max_in_flight) : _requests(max_in_flight), _ring_fd(ring_fd)
+  {
+  }
+
+  /***/
+  QUILL_NODISCARD bool _map_rings(io_uring_params const& params)
+  {
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    bool single_mmap{false};
+  #if defined(IORING_FEAT_SINGLE_MMAP)
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  #endif
+
+    if (single_mmap)
+    {
+      _sq_ring_size = (std::max)(_sq_ring_size, _cq_ring_size);
+      _cq_ring_size = _sq_ring_size;
+    }
+
+    void* sq_ring = ::mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           _ring_fd, IORING_OFF_SQ_RING);
+
+    if (sq_ring == MAP_FAILED)
+    {
+      return false;
+    }
+
+    _sq_ring = static_cast<char*>(sq_ring);
+
+    if (single_mmap)
+    {
+      _cq_ring = _sq_ring;
+    }
+    else
+    {
+      void* cq_ring = ::mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_CQ_RING);
+
+      if (cq_ring == MAP_FAILED)
+      {
+        return false;
+      }
+
+      _cq_ring = static_cast<char*>(cq_ring);
+    }
+
+    void* sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        _ring_fd, IORING_OFF_SQES);
+
+    if (sqes == MAP_FAILED)
+    {
+      return false;
+    }
+
+    _sqes = static_cast<io_uring_sqe*>(sqes);
+
+    _sq_tail = reinterpret_cast<uint32_t*>(_sq_ring + params.sq_off.tail);
+    _sq_mask = *reinterpret_cast<uint32_t*>(_sq_ring + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<uint32_t*>(_sq_ring + params.sq_off.array);
+    _cq_head = reinterpret_cast<uint32_t*>(_cq_ring + params.cq_off.head);
+    _cq_tail = reinterpret_cast<uint32_t*>(_cq_ring + params.cq_off.tail);
+    _cq_mask = *reinterpret_cast<uint32_t*>(_cq_ring + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(_cq_ring + params.cq_off.cqes);
+
+    return true;
+  }
+
+  /***/
+  void _push_sqe(uint32_t buffer_index) noexcept
+  {
+    WriteRequest const& request = _requests[buffer_index];
+
+    // we are the only producer of the submission queue
+    uint32_t const tail = *_sq_tail;
+    uint32_t const index = tail & _sq_mask;
+
+    io_uring_sqe& sqe = _sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_WRITEV;
+    sqe.fd = request.fd;
+    sqe.addr = reinterpret_cast<uint64_t>(&request.iov);
+    sqe.len = 1;
+    sqe.off = request.offset;
+    sqe.user_data = buffer_index;
+
+    _sq_array[index] = index;
+    __atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  /***/
+  void _enter(uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+  {
+    while (true)
+    {
+      auto const ret = ::syscall(__NR_io_uring_enter, _ring_fd, to_submit, min_complete, flags, nullptr, 0);
+
+      if (ret >= 0)
+      {
+        to_submit -= static_cast<uint32_t>(ret);
+
+        if (to_submit == 0)
+        {
+          return;
+        }
+
+        // not everything was consumed, the waiting part is already satisfied by the caller
+        min_complete = 0;
+      }
+      else if ((errno != EINTR) && (errno != EAGAIN) && (errno != EBUSY))
+      {
+        QUILL_THROW(quill::QuillError{fmtquill::format(
+          "io_uring_enter failed with error message errno: \"{}\" {}", errno, strerror(errno))});
+      }
+    }
+  }
+
+private:
+  std::vector<WriteRequest> _requests; /** indexed by buffer index, the iovecs must stay stable */
+  int _ring_fd;
+  char* _sq_ring{nullptr};
+  char* _cq_ring{nullptr};
+  io_uring_sqe* _sqes{nullptr};
+  size_t _sq_ring_size{0};
+  size_t _cq_ring_size{0};
+  size_t _sqes_size{0};
+  uint32_t* _sq_tail{nullptr};
+  uint32_t* _sq_array{nullptr};
+  uint32_t* _cq_head{nullptr};
+  uint32_t* _cq_tail{nullptr};
+  io_uring_cqe* _cqes{nullptr};
+  uint32_t _sq_mask{0};
+  uint32_t _cq_mask{0};
+};
+#endif
+} // namespace
+
+namespace quill::detail
+{
+/***/
+std::unique_ptr<AsyncFileWriter> create_async_file_writer(uint32_t max_in_flight, bool use_io_uring)
+{
+#if defined(QUILL_HAS_IO_URING)
+  if (use_io_uring)
+  {
+    std::unique_ptr<AsyncFileWriter> writer = UringFileWriter::create(max_in_flight);
+
+    if (writer)
+    {
+      return writer;
+    }
+  }
+#else
+  (void)max_in_flight;
+  (void)use_io_uring;
+#endif
+
+  return std::make_unique<ThreadFileWriter>();
+}
+} // namespace quill::detail
@@ -0,0 +1,104 @@
+#include "quill/detail/misc/BackgroundWorker.h"
+#include "quill/QuillError.h"     // for QUILL_TRY, QUILL_CATCH
+#include "quill/detail/misc/Os.h" // for set_thread_name
+#include <exception>              // for exception
+#include <utility>                // for move
+
+namespace quill::detail
+{
+/***/
+BackgroundWorker::BackgroundWorker(std::string name) : _name(std::move(name))
+{
+  _thread = std::thread{[this]() { _run(); }};
+}
+
+/***/
+BackgroundWorker::~BackgroundWorker()
+{
+  {
+    std::lock_guard<std::mutex> const lock{_mutex};
+    _stop = true;
+  }
+
+  _cv.notify_one();
+  _thread.join();
+}
+
+/***/
+void BackgroundWorker::enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> const lock{_mutex};
+    _tasks.push_back(std::move(task));
+  }
+
+  _cv.notify_one();
+}
+
+/***/
+void BackgroundWorker::wait_idle()
+{
+  std::unique_lock<std::mutex> lock{_mutex};
+  _idle_cv.wait(lock, [this]() { return _tasks.empty() && !_busy; });
+}
+
+/***/
+std::string BackgroundWorker::take_error()
+{
+  std::lock_guard<std::mutex> const lock{_mutex};
+  std::string error;
+  error.swap(_error);
+  return error;
+}
+
+/***/
+void BackgroundWorker::_run()
+{
+  QUILL_TRY { set_thread_name(_name.data()); }
+  QUILL_CATCH_ALL() {}
+
+  std::unique_lock<std::mutex> lock{_mutex};
+
+  while (true)
+  {
+    _cv.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+
+    if (_tasks.empty())
+    {
+      // stop is only honoured once all the tasks have run
+      return;
+    }
+
+    std::function<void()> task = std::move(_tasks.front());
+    _tasks.pop_front();
+    _busy = true;
+    lock.unlock();
+
+    std::string error;
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_TRY
+    {
+#endif
+      task();
+#if !defined(QUILL_NO_EXCEPTIONS)
+    }
+    QUILL_CATCH(std::exception const& e) { error = e.what(); }
+    QUILL_CATCH_ALL() { error = "Caught unhandled exception."; }
+#endif
+
+    lock.lock();
+    _busy = false;
+
+    if (!error.empty() && _error.empty())
+    {
+      _error = std::move(error);
+    }
+
+    if (_tasks.empty())
+    {
+      _idle_cv.notify_all();
+    }
+  }
+}
+} // namespace quill::detail
@@ -0,0 +1,173 @@
+#include "quill/detail/misc/Compression.h"
+#include "quill/QuillError.h"                // for QUILL_THROW, QuillError
+#include "quill/detail/misc/FileUtilities.h" // for open_file
+#include <cstdio>                            // for fread, fclose
+#include <memory>                            // for unique_ptr
+
+#if defined(QUILL_HAS_ZLIB)
+  #include <zlib.h>
+#endif
+
+namespace
+{
+#if defined(QUILL_HAS_ZLIB)
+/**
+ * Adding 16 to the window bits writes a gzip header and trailer instead of a zlib wrapper
+ */
+constexpr int gzip_window_bits{15 + 16};
+constexpr int gzip_memory_level{8};
+constexpr size_t chunk_size{64u * 1024u};
+
+/**
+ * Owns a deflate stream
+ */
+class Deflater
+{
+public:
+  Deflater()
+  {
+    if (deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, gzip_window_bits,
+                     gzip_memory_level, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      QUILL_THROW(quill::QuillError{"deflateInit2 failed"});
+    }
+  }
+
+  ~Deflater() { deflateEnd(&_stream); }
+
+  Deflater(Deflater const&) = delete;
+  Deflater& operator=(Deflater const&) = delete;
+
+  /**
+   * Compresses the input and appends the output to out
+   */
+  void deflate(char const* data, size_t size, bool finish, std::string& out)
+  {
+    _stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    _stream.avail_in = static_cast<uInt>(size);
+
+    int res;
+    do
+    {
+      size_t const out_pos = out.size();
+      out.resize(out_pos + chunk_size);
+
+      _stream.next_out = reinterpret_cast<Bytef*>(out.data() + out_pos);
+      _stream.avail_out = static_cast<uInt>(chunk_size);
+
+      res = ::deflate(&_stream, finish ? Z_FINISH : Z_NO_FLUSH);
+
+      out.resize(out.size() - _stream.avail_out);
+
+      if (res == Z_STREAM_ERROR)
+      {
+        QUILL_THROW(quill::QuillError{"deflate failed"});
+      }
+    } while (_stream.avail_out == 0);
+
+    if (finish && (res != Z_STREAM_END))
+    {
+      QUILL_THROW(quill::QuillError{"deflate did not complete the stream"});
+    }
+  }
+
+  /**
+   * Resets the stream to start a new gzip member, keeping the allocated state
+   */
+  void reset()
+  {
+    if (deflateReset(&_stream) != Z_OK)
+    {
+      QUILL_THROW(quill::QuillError{"deflateReset failed"});
+    }
+  }
+
+private:
+  z_stream _stream{};
+};
+
+/**
+ * Closes a FILE* on destruction
+ */
+struct FileCloser
+{
+  void operator()(FILE* file) const noexcept { fclose(file); }
+};
+#endif
+} // namespace
+
+namespace quill::detail
+{
+struct GzipCompressor::Impl
+{
+#if defined(QUILL_HAS_ZLIB)
+  Deflater deflater;
+#endif
+};
+
+/***/
+GzipCompressor::GzipCompressor()
+{
+#if defined(QUILL_HAS_ZLIB)
+  _impl = std::make_unique<Impl>();
+#else
+  QUILL_THROW(QuillError{"gzip compression requires quill to be built with QUILL_ENABLE_GZIP"});
+#endif
+}
+
+/***/
+GzipCompressor::~GzipCompressor() = default;
+
+/***/
+void GzipCompressor::compress(char const* data, size_t size, std::string& out)
+{
+#if defined(QUILL_HAS_ZLIB)
+  // start each member from a clean stream, also after a previous failure
+  _impl->deflater.reset();
+  _impl->deflater.deflate(data, size, true, out);
+#else
+  (void)data;
+  (void)size;
+  (void)out;
+#endif
+}
+
+/***/
+void gzip_compress_file(fs::path const& source, fs::path const& destination)
+{
+#if defined(QUILL_HAS_ZLIB)
+  std::unique_ptr<FILE, FileCloser> const input{open_file(source, "rb")};
+  std::unique_ptr<FILE, FileCloser> output{open_file(destination, "wb")};
+
+  Deflater deflater;
+  std::string in_buffer(chunk_size, '\0');
+  std::string out_buffer;
+
+  bool finish = false;
+  while (!finish)
+  {
+    size_t const read = fread(in_buffer.data(), 1, in_buffer.size(), input.get());
+
+    if (ferror(input.get()))
+    {
+      QUILL_THROW(QuillError{"failed to read \"" + source.string() + "\""});
+    }
+
+    finish = (read != in_buffer.size());
+
+    out_buffer.clear();
+    deflater.deflate(in_buffer.data(), read, finish, out_buffer);
+    fwrite_fully(out_buffer.data(), sizeof(char), out_buffer.size(), output.get());
+  }
+
+  if (fclose(output.release()) != 0)
+  {
+    QUILL_THROW(QuillError{"failed to close \"" + destination.string() + "\""});
+  }
+#else
+  (void)source;
+  (void)destination;
+  QUILL_THROW(QuillError{"gzip compression requires quill to be built with QUILL_ENABLE_GZIP"});
+#endif
+}
+} // namespace quill::detail
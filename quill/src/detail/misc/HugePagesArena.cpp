@@ -0,0 +1,176 @@
+#include "quill/detail/misc/HugePagesArena.h"
+#include "quill/Fmt.h"        // for format
+#include "quill/QuillError.h" // for QUILL_THROW, QuillError
+#include <algorithm>          // for lower_bound
+#include <cerrno>             // for errno
+#include <cstring>            // for strerror
+#include <iterator>           // for prev
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+#endif
+
+namespace
+{
+constexpr size_t huge_page_size{2u * 1024u * 1024u};
+constexpr size_t block_granularity{4096u};
+
+/***/
+QUILL_NODISCARD constexpr size_t round_up(size_t value, size_t multiple) noexcept
+{
+  return ((value + multiple - 1) / multiple) * multiple;
+}
+} // namespace
+
+namespace quill::detail
+{
+/***/
+HugePagesArena::~HugePagesArena()
+{
+#if defined(__linux__)
+  if (std::byte* begin = _begin.load(std::memory_order_relaxed); begin)
+  {
+    ::munmap(begin, _capacity);
+  }
+#endif
+}
+
+/***/
+HugePagesArena& HugePagesArena::instance()
+{
+  // never destroyed, the thread local queues can be freed after every other static object
+  static HugePagesArena* arena = new HugePagesArena{true};
+  return *arena;
+}
+
+/***/
+void HugePagesArena::reserve(size_t size)
+{
+#if defined(__linux__)
+  std::lock_guard<std::mutex> const lock{_mutex};
+
+  if (_begin.load(std::memory_order_relaxed) || (size == 0))
+  {
+    return;
+  }
+
+  size_t const capacity = round_up(size, huge_page_size);
+
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+  if (_huge_pages)
+  {
+    flags |= MAP_HUGETLB;
+  }
+
+  void* mem = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+  if (mem == MAP_FAILED)
+  {
+    QUILL_THROW(QuillError{fmtquill::format(
+      "failed to reserve {} bytes of huge pages for the queues, error message \"{}\", errno \"{}\"",
+      capacity, strerror(errno), errno)});
+  }
+
+  _capacity = capacity;
+  _free_blocks.push_back(FreeBlock{0, capacity});
+  _begin.store(static_cast<std::byte*>(mem), std::memory_order_release);
+#else
+  // only linux supports huge pages, the queues are allocated as before
+  (void)size;
+#endif
+}
+
+/***/
+void* HugePagesArena::allocate(size_t size, size_t alignment) noexcept
+{
+  if (!is_reserved() || (alignment > block_granularity))
+  {
+    return nullptr;
+  }
+
+  size_t const block_size = round_up(size, block_granularity);
+
+  std::lock_guard<std::mutex> const lock{_mutex};
+
+  auto const free_block = std::find_if(_free_blocks.begin(), _free_blocks.end(),
+                                       [block_size](FreeBlock const& block)
+                                       { return block.size >= block_size; });
+
+  if (free_block == _free_blocks.end())
+  {
+    return nullptr;
+  }
+
+  size_t const offset = free_block->offset;
+
+  if (free_block->size == block_size)
+  {
+    _free_blocks.erase(free_block);
+  }
+  else
+  {
+    free_block->offset += block_size;
+    free_block->size -= block_size;
+  }
+
+  _allocated_blocks.emplace(offset, block_size);
+  _used += block_size;
+
+  return _begin.load(std::memory_order_relaxed) + offset;
+}
+
+/***/
+bool HugePagesArena::deallocate(void* ptr) noexcept
+{
+  std::byte* begin = _begin.load(std::memory_order_acquire);
+  auto* block_begin = static_cast<std::byte*>(ptr);
+
+  if (!begin || (block_begin < begin) || (block_begin >= begin + _capacity))
+  {
+    return false;
+  }
+
+  auto const offset = static_cast<size_t>(block_begin - begin);
+
+  std::lock_guard<std::mutex> const lock{_mutex};
+
+  auto const allocated_block = _allocated_blocks.find(offset);
+  size_t const block_size = allocated_block->second;
+  _allocated_blocks.erase(allocated_block);
+  _used -= block_size;
+
+  // insert in offset order and merge with the neighbours
+  auto next = std::lower_bound(_free_blocks.begin(), _free_blocks.end(), offset,
+                               [](FreeBlock const& block, size_t value) { return block.offset < value; });
+
+  if ((next != _free_blocks.begin()) && (std::prev(next)->offset + std::prev(next)->size == offset))
+  {
+    auto previous = std::prev(next);
+    previous->size += block_size;
+
+    if ((next != _free_blocks.end()) && (previous->offset + previous->size == next->offset))
+    {
+      previous->size += next->size;
+      _free_blocks.erase(next);
+    }
+  }
+  else if ((next != _free_blocks.end()) && (offset + block_size == next->offset))
+  {
+    next->offset = offset;
+    next->size += block_size;
+  }
+  else
+  {
+    _free_blocks.insert(next, FreeBlock{offset, block_size});
+  }
+
+  return true;
+}
+
+/***/
+size_t HugePagesArena::used() noexcept
+{
+  std::lock_guard<std::mutex> const lock{_mutex};
+  return _used;
+}
+} // namespace quill::detail
@@ -0,0 +1,56 @@
+#include "quill/detail/misc/MemoryBudget.h"
+
+namespace quill::detail
+{
+/***/
+MemoryBudget& MemoryBudget::instance()
+{
+  // never destroyed, the thread local queues can be freed after every other static object
+  static MemoryBudget* memory_budget = new MemoryBudget{};
+  return *memory_budget;
+}
+
+/***/
+void MemoryBudget::configure(size_t limit, MemoryBudgetPolicy policy) noexcept
+{
+  _policy.store(policy, std::memory_order_relaxed);
+  _limit.store(limit, std::memory_order_relaxed);
+}
+
+/***/
+bool MemoryBudget::try_acquire(size_t bytes, LogLevel log_level) noexcept
+{
+  size_t limit = _limit.load(std::memory_order_relaxed);
+
+  if (limit == 0)
+  {
+    _usage.fetch_add(bytes, std::memory_order_relaxed);
+    return true;
+  }
+
+  if (_policy.load(std::memory_order_relaxed) == MemoryBudgetPolicy::DropLowestLevelsFirst)
+  {
+    // keep the remaining memory for the more important messages
+    if (log_level <= LogLevel::Debug)
+    {
+      limit = limit / 2;
+    }
+    else if (log_level == LogLevel::Info)
+    {
+      limit = (limit / 4) * 3;
+    }
+  }
+
+  size_t usage = _usage.load(std::memory_order_relaxed);
+
+  do
+  {
+    if ((bytes > limit) || (usage > (limit - bytes)))
+    {
+      return false;
+    }
+  } while (!_usage.compare_exchange_weak(usage, usage + bytes, std::memory_order_relaxed));
+
+  return true;
+}
+} // namespace quill::detail
@@ -1,6 +1,7 @@
 #include "quill/detail/misc/Os.h"
 #include "quill/QuillError.h"
 #include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/HugePagesArena.h"
 #include "quill/detail/misc/Utilities.h"
 #include <array>
 #include <cerrno> // for errno, EINVAL, ENOMEM
@@ -348,6 +349,21 @@ void* alloc_aligned(size_t size, size_t alignment, bool huge_pages /* = false */
 
   return p;
 #else
+  #if defined(__linux__)
+  if (huge_pages)
+  {
+    HugePagesArena& huge_pages_arena = HugePagesArena::instance();
+
+    if (void* p = huge_pages_arena.allocate(size, alignment); p)
+    {
+      return p;
+    }
+
+    // when the reserved arena is exhausted fall back to normal pages
+    huge_pages = !huge_pages_arena.is_reserved();
+  }
+  #endif
+
   // Calculate the total size including the metadata and alignment
   constexpr size_t metadata_size{2u * sizeof(size_t)};
   size_t const total_size{size + metadata_size + alignment};
@@ -393,6 +409,13 @@ void free_aligned(void* ptr) noexcept
 #if defined(_WIN32)
   _aligned_free(ptr);
 #else
+  #if defined(__linux__)
+  if (HugePagesArena::instance().deallocate(ptr))
+  {
+    return;
+  }
+  #endif
+
   // Retrieve the size and offset information from the metadata
   size_t offset;
   std::memcpy(&offset, static_cast<std::byte*>(ptr) - (2u * sizeof(size_t)), sizeof(offset));
@@ -480,4 +503,14 @@ bool fsync(FILE* fd)
   return ::fsync(fileno(fd)) == 0;
 #endif
 }
+
+/***/
+bool fdatasync(FILE* fd)
+{
+#if defined(__linux__)
+  return ::fdatasync(fileno(fd)) == 0;
+#else
+  return fsync(fd);
+#endif
+}
 } // namespace quill::detail
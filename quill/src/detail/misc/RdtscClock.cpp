@@ -4,14 +4,47 @@
 #include <algorithm>                  // for nth_element
 #include <array>                      // for array<>::iterator, array
 #include <chrono>                     // for nanoseconds, duration, operator-
+#include <cmath>                      // for fabs
 #include <cstddef>                    // for size_t
+#include <cstdlib>                    // for strtod
+#include <fstream>                    // for ifstream, ofstream
 #include <iostream>                   // for cerr
+#include <vector>                     // for vector
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  #define QUILL_HAS_CPUID 1
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
 
 namespace quill::detail
 {
 
 namespace
 {
+/**
+ * The maximum relative difference allowed between the cpu reported or cached tsc frequency
+ * and a quick measurement, 10us of drift per second between two resyncs. A nominal frequency
+ * that is off by more than this e.g. a base frequency rounded to MHz is calibrated instead
+ */
+constexpr double max_ticks_per_ns_deviation{1e-5};
+
+/**
+ * The quick measurement spins long enough for the clock reads at both ends to stay well below
+ * the allowed deviation
+ */
+constexpr std::chrono::milliseconds validation_spin_duration{20};
+
+/**
+ * The adapted resync interval changes by at most this factor on each resync and stays within
+ * [original / max_resync_interval_factor, original]
+ */
+constexpr int64_t max_resync_interval_step{2};
+constexpr int64_t max_resync_interval_factor{64};
+
 /**
  * Calculates a fast average of two numbers
  */
@@ -19,19 +52,142 @@ QUILL_NODISCARD uint64_t fast_average(uint64_t x, uint64_t y) noexcept
 {
   return (x & y) + ((x ^ y) >> 1);
 }
+
+#if defined(QUILL_HAS_CPUID)
+/**
+ * Executes cpuid for the given leaf
+ * @return eax, ebx, ecx, edx
+ */
+QUILL_NODISCARD std::array<uint32_t, 4> cpuid(uint32_t leaf) noexcept
+{
+  std::array<uint32_t, 4> regs{};
+  #if defined(_MSC_VER)
+  std::array<int, 4> msvc_regs{};
+  __cpuidex(msvc_regs.data(), static_cast<int>(leaf), 0);
+  for (size_t i = 0; i < regs.size(); ++i)
+  {
+    regs[i] = static_cast<uint32_t>(msvc_regs[i]);
+  }
+  #else
+  __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+  #endif
+  return regs;
+}
+#endif
+
+/**
+ * Reads the tsc frequency as reported by the cpu
+ * @return the tsc ticks per nanosecond or 0 if not available
+ */
+QUILL_NODISCARD double cpu_reported_ticks_per_ns() noexcept
+{
+#if defined(QUILL_HAS_CPUID)
+  uint32_t const max_leaf = cpuid(0)[0];
+
+  if (max_leaf < 0x15)
+  {
+    return 0;
+  }
+
+  // leaf 0x15: eax denominator, ebx numerator and ecx the crystal clock frequency in hz
+  auto const tsc_leaf = cpuid(0x15);
+  uint32_t const denominator = tsc_leaf[0];
+  uint32_t const numerator = tsc_leaf[1];
+  uint32_t crystal_hz = tsc_leaf[2];
+
+  if ((denominator == 0) || (numerator == 0))
+  {
+    return 0;
+  }
+
+  if ((crystal_hz == 0) && (max_leaf >= 0x16))
+  {
+    // the crystal frequency is not enumerated, derive it from the base frequency in MHz of leaf 0x16
+    uint64_t const base_mhz = cpuid(0x16)[0] & 0xFFFF;
+    crystal_hz = static_cast<uint32_t>((base_mhz * 1'000'000 * denominator) / numerator);
+  }
+
+  return (static_cast<double>(crystal_hz) * static_cast<double>(numerator)) /
+    (static_cast<double>(denominator) * 1e9);
+#elif defined(__aarch64__)
+  // the frequency of the virtual counter is fixed and available at CNTFRQ_EL0
+  uint64_t counter_hz;
+  __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(counter_hz));
+  return static_cast<double>(counter_hz) / 1e9;
+#else
+  return 0;
+#endif
+}
+} // namespace
+
+/***/
+double RdtscClock::load_cached_ticks_per_ns(std::string const& calibration_cache_path)
+{
+  std::ifstream cache_file{calibration_cache_path};
+
+  std::string line;
+  if (!cache_file.is_open() || !std::getline(cache_file, line))
+  {
+    return 0;
+  }
+
+  double const ticks_per_ns = std::strtod(line.data(), nullptr);
+  return (ticks_per_ns > 0) ? ticks_per_ns : 0;
+}
+
+/***/
+void RdtscClock::store_cached_ticks_per_ns(std::string const& calibration_cache_path, double ticks_per_ns)
+{
+  std::ofstream cache_file{calibration_cache_path, std::ios::trunc};
+
+  if (cache_file.is_open())
+  {
+    cache_file << fmtquill::format("{:.17g}\n", ticks_per_ns);
+  }
+}
+
+/***/
+RdtscClock::RdtscTicks::RdtscTicks(std::string const& calibration_cache_path)
+  : _ns_per_tick(1 / calibrate_ticks_per_ns(cpu_reported_ticks_per_ns(), calibration_cache_path))
+{
 }
 
 /***/
-RdtscClock::RdtscTicks::RdtscTicks()
+double RdtscClock::calibrate_ticks_per_ns(double reported_ticks_per_ns, std::string const& calibration_cache_path)
 {
-  // Convert rdtsc to wall time.
-  // 1. Get real time and rdtsc current count
-  // 2. Calculate how many rdtsc ticks can occur in one
-  // calculate _ticks_per_ns as the median over a number of observations.
-  constexpr std::chrono::milliseconds spin_duration = std::chrono::milliseconds{10};
+  double const cached_ticks_per_ns =
+    calibration_cache_path.empty() ? 0 : load_cached_ticks_per_ns(calibration_cache_path);
+
+  double ticks_per_ns{0};
+
+  if ((reported_ticks_per_ns != 0) || (cached_ticks_per_ns != 0))
+  {
+    // a single quick measurement validates both candidates
+    ticks_per_ns = select_ticks_per_ns(reported_ticks_per_ns, cached_ticks_per_ns,
+                                       _measure_ticks_per_ns(validation_spin_duration, 3));
+  }
+
+  if (ticks_per_ns == 0)
+  {
+    // Convert rdtsc to wall time.
+    // 1. Get real time and rdtsc current count
+    // 2. Calculate how many rdtsc ticks can occur in one
+    // calculate _ticks_per_ns as the median over a number of observations.
+    ticks_per_ns = _measure_ticks_per_ns(std::chrono::milliseconds{10}, 13);
+
+    if (!calibration_cache_path.empty())
+    {
+      store_cached_ticks_per_ns(calibration_cache_path, ticks_per_ns);
+    }
+  }
+
+  return ticks_per_ns;
+}
 
-  constexpr int trials = 13;
-  std::array<double, trials> rates = {{0}};
+/***/
+double RdtscClock::_measure_ticks_per_ns(std::chrono::milliseconds spin_duration, size_t trials)
+{
+  std::vector<double> rates(trials, 0);
 
   for (size_t i = 0; i < trials; ++i)
   {
@@ -48,24 +204,50 @@ RdtscClock::RdtscTicks::RdtscTicks()
       end_tsc = rdtsc();
 
       elapsed_ns = end_ts - beg_ts;       // calculates ns between two timespecs
-    } while (elapsed_ns < spin_duration); // busy spin for 10ms
+    } while (elapsed_ns < spin_duration); // busy spin for spin_duration
 
     rates[i] = static_cast<double>(end_tsc - beg_tsc) / static_cast<double>(elapsed_ns.count());
   }
 
-  std::nth_element(rates.begin(), rates.begin() + trials / 2, rates.end());
+  auto const median = rates.begin() + static_cast<std::ptrdiff_t>(trials / 2);
+  std::nth_element(rates.begin(), median, rates.end());
+  return *median;
+}
+
+/***/
+double RdtscClock::select_ticks_per_ns(double cpu_reported_ticks_per_ns, double cached_ticks_per_ns,
+                                       double measured_ticks_per_ns) noexcept
+{
+  auto const is_accepted = [measured_ticks_per_ns](double ticks_per_ns)
+  {
+    return (ticks_per_ns > 0) &&
+      (std::fabs(measured_ticks_per_ns - ticks_per_ns) <= (ticks_per_ns * max_ticks_per_ns_deviation));
+  };
+
+  if (is_accepted(cpu_reported_ticks_per_ns))
+  {
+    return cpu_reported_ticks_per_ns;
+  }
+
+  if (is_accepted(cached_ticks_per_ns))
+  {
+    return cached_ticks_per_ns;
+  }
 
-  double const ticks_per_ns = rates[trials / 2];
-  _ns_per_tick = 1 / ticks_per_ns;
+  return 0;
 }
 
 /***/
-RdtscClock::RdtscClock(std::chrono::nanoseconds resync_interval /* = std::chrono::seconds{100} */)
-  : _resync_interval_ticks(static_cast<std::int64_t>(static_cast<double>(resync_interval.count()) *
-                                                     RdtscTicks::instance().ns_per_tick())),
+RdtscClock::RdtscClock(std::chrono::nanoseconds resync_interval,
+                       std::string const& calibration_cache_path /* = std::string{} */,
+                       std::chrono::nanoseconds accuracy_target /* = std::chrono::nanoseconds{0} */)
+  : _resync_interval_ticks(static_cast<std::int64_t>(
+      static_cast<double>(resync_interval.count()) / RdtscTicks::instance(calibration_cache_path).ns_per_tick())),
     _resync_interval_original(_resync_interval_ticks),
-    _ns_per_tick(RdtscTicks::instance().ns_per_tick())
-
+    _resync_interval_adapted(_resync_interval_ticks),
+    _accuracy_target_ns(accuracy_target.count()),
+    _ns_per_tick(RdtscTicks::instance(calibration_cache_path).ns_per_tick()),
+    _current_resync_interval_ticks(_resync_interval_ticks)
 {
   bool res = resync(2500);
   if (!res)
@@ -79,6 +261,36 @@ RdtscClock::RdtscClock(std::chrono::nanoseconds resync_interval /* = std::chrono
   }
 }
 
+/***/
+bool RdtscClock::is_tsc_reliable() noexcept
+{
+  static bool const tsc_reliable = []()
+  {
+#if defined(QUILL_HAS_CPUID)
+    // leaf 0x80000007 edx bit 8: invariant tsc
+    if ((cpuid(0x80000000)[0] >= 0x80000007) && ((cpuid(0x80000007)[3] & (1u << 8)) != 0))
+    {
+      return true;
+    }
+
+  #if defined(__linux__)
+    // Hypervisors often hide the invariant tsc bit, but the kernel only picks the tsc as the
+    // clocksource when it considers it stable
+    std::ifstream clocksource{"/sys/devices/system/clocksource/clocksource0/current_clocksource"};
+    std::string current_clocksource;
+    return clocksource.is_open() && std::getline(clocksource, current_clocksource) &&
+      (current_clocksource == "tsc");
+  #else
+    return false;
+  #endif
+#else
+    return true;
+#endif
+  }();
+
+  return tsc_reliable;
+}
+
 /***/
 uint64_t RdtscClock::time_since_epoch(uint64_t rdtsc_value) const noexcept
 {
@@ -142,13 +354,26 @@ bool RdtscClock::resync(uint32_t lag) const noexcept
 
     if (QUILL_LIKELY(end - beg <= lag))
     {
+      uint64_t const tsc = fast_average(beg, end);
+
+      // measure how far the tsc derived time drifted from the wall clock since the last resync
+      auto const current_index = _version.load(std::memory_order_relaxed) & (_base.size() - 1);
+      if (_base[current_index].base_tsc != 0)
+      {
+        auto const elapsed_ticks = static_cast<int64_t>(tsc - _base[current_index].base_tsc);
+        int64_t const tsc_time = _base[current_index].base_time +
+          static_cast<int64_t>(static_cast<double>(elapsed_ticks) * _ns_per_tick);
+        _record_drift(tsc_time - wall_time, elapsed_ticks);
+      }
+
       // update the next index
       auto const index = (_version.load(std::memory_order_relaxed) + 1) & (_base.size() - 1);
       _base[index].base_time = wall_time;
-      _base[index].base_tsc = fast_average(beg, end);
+      _base[index].base_tsc = tsc;
       _version.fetch_add(1, std::memory_order_release);
 
-      _resync_interval_ticks = _resync_interval_original;
+      _resync_interval_ticks = _resync_interval_adapted;
+      _current_resync_interval_ticks.store(_resync_interval_ticks, std::memory_order_relaxed);
       return true;
     }
   }
@@ -156,6 +381,67 @@ bool RdtscClock::resync(uint32_t lag) const noexcept
   // we failed to return earlier and we never resynced, but we don't really want to keep retrying on each call
   // to time_since_epoch() so we do non accurate resync we will increase the resync duration to resync later
   _resync_interval_ticks = _resync_interval_ticks * 2;
+  _current_resync_interval_ticks.store(_resync_interval_ticks, std::memory_order_relaxed);
+  _failed_resync_count.fetch_add(1, std::memory_order_relaxed);
   return false;
 }
+
+/***/
+RdtscClock::DriftStats RdtscClock::drift_stats() const noexcept
+{
+  DriftStats stats;
+  stats.resync_count = _resync_count.load(std::memory_order_relaxed);
+  stats.failed_resync_count = _failed_resync_count.load(std::memory_order_relaxed);
+  stats.max_drift = std::chrono::nanoseconds{_max_drift_ns.load(std::memory_order_relaxed)};
+  stats.last_drift = std::chrono::nanoseconds{_last_drift_ns.load(std::memory_order_relaxed)};
+  stats.resync_interval = resync_interval();
+
+  if (stats.resync_count != 0)
+  {
+    stats.avg_drift = std::chrono::nanoseconds{
+      static_cast<int64_t>(_total_drift_ns.load(std::memory_order_relaxed) / stats.resync_count)};
+  }
+
+  return stats;
+}
+
+/***/
+void RdtscClock::_record_drift(int64_t drift_ns, int64_t elapsed_ticks) const noexcept
+{
+  int64_t const abs_drift_ns = (drift_ns < 0) ? -drift_ns : drift_ns;
+
+  // only the resync thread writes the stats, so there is no need for a read-modify-write
+  if (abs_drift_ns > _max_drift_ns.load(std::memory_order_relaxed))
+  {
+    _max_drift_ns.store(abs_drift_ns, std::memory_order_relaxed);
+  }
+
+  _last_drift_ns.store(drift_ns, std::memory_order_relaxed);
+  _total_drift_ns.store(_total_drift_ns.load(std::memory_order_relaxed) + static_cast<uint64_t>(abs_drift_ns),
+                        std::memory_order_relaxed);
+  _resync_count.store(_resync_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  if ((_accuracy_target_ns == 0) || (elapsed_ticks <= 0))
+  {
+    return;
+  }
+
+  // The drift grows linearly with the elapsed time, find the interval that would have kept it
+  // at the accuracy target
+  int64_t target_interval_ticks = (abs_drift_ns == 0)
+    ? (elapsed_ticks * max_resync_interval_step)
+    : static_cast<int64_t>(static_cast<double>(elapsed_ticks) *
+                           (static_cast<double>(_accuracy_target_ns) / static_cast<double>(abs_drift_ns)));
+
+  // Move gradually towards it, as a single measurement can be noisy
+  target_interval_ticks = (std::max)(target_interval_ticks, _resync_interval_adapted / max_resync_interval_step);
+  target_interval_ticks = (std::min)(target_interval_ticks, _resync_interval_adapted * max_resync_interval_step);
+
+  // and keep it within bounds, the configured interval is also the longest one
+  target_interval_ticks =
+    (std::max)(target_interval_ticks, _resync_interval_original / max_resync_interval_factor);
+  target_interval_ticks = (std::min)(target_interval_ticks, _resync_interval_original);
+
+  _resync_interval_adapted = target_interval_ticks;
+}
 } // namespace quill::detail
\ No newline at end of file
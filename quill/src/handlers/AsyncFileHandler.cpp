@@ -0,0 +1,299 @@
+#include "quill/handlers/AsyncFileHandler.h"
+#include "quill/Fmt.h"                        // for format
+#include "quill/QuillError.h"                 // for QUILL_THROW, QuillError
+#include "quill/detail/misc/AsyncFileWriter.h" // for AsyncFileWriter
+#include "quill/detail/misc/Os.h"             // for alloc_aligned
+#include <algorithm>                          // for min
+#include <cstdio>                             // for fflush
+#include <cstring>                            // for memcpy
+
+#if defined(_WIN32)
+  #include <io.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+constexpr size_t write_buffer_alignment{4096u};
+}
+
+namespace quill
+{
+/***/
+void AsyncFileHandlerConfig::set_write_buffer_size(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"write_buffer_size must be greater than zero"});
+  }
+
+  _write_buffer_size = value;
+}
+
+/***/
+void AsyncFileHandlerConfig::set_max_in_flight(uint32_t value)
+{
+  if (value < 2)
+  {
+    QUILL_THROW(QuillError{"max_in_flight must be at least 2"});
+  }
+
+  _max_in_flight = value;
+}
+
+/***/
+void AsyncFileHandlerConfig::set_use_io_uring(bool value) { _use_io_uring = value; }
+
+/***/
+void AsyncFileHandlerConfig::set_idle_submit_interval(std::chrono::milliseconds value)
+{
+  if (value.count() < 0)
+  {
+    QUILL_THROW(QuillError{"idle_submit_interval can not be negative"});
+  }
+
+  _idle_submit_interval = value;
+}
+
+/***/
+AsyncFileHandler::AsyncFileHandler(fs::path const& filename, AsyncFileHandlerConfig const& config,
+                                   FileEventNotifier file_event_notifier)
+  : FileHandler(filename, static_cast<FileHandlerConfig const&>(config), std::move(file_event_notifier)),
+    _config(config),
+    _buffer_size(((config.write_buffer_size() + write_buffer_alignment - 1) / write_buffer_alignment) *
+                 write_buffer_alignment)
+{
+  _writer = detail::create_async_file_writer(_config.max_in_flight(), _config.use_io_uring());
+
+  _buffers = static_cast<char*>(
+    detail::alloc_aligned(_buffer_size * _config.max_in_flight(), write_buffer_alignment));
+
+  // buffer 0 is the current one, the rest are free
+  _free_buffers.reserve(_config.max_in_flight());
+  for (uint32_t i = _config.max_in_flight() - 1; i > 0; --i)
+  {
+    _free_buffers.push_back(i);
+  }
+
+  _completed.reserve(_config.max_in_flight());
+
+  _prepare_file();
+}
+
+/***/
+AsyncFileHandler::~AsyncFileHandler()
+{
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _submit_buffer();
+    _wait_all();
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH_ALL() {}
+#endif
+
+  // join the writer before releasing the buffers
+  _writer.reset();
+  detail::free_aligned(_buffers);
+
+  if (_file)
+  {
+    // anything written by the before_close callback goes after our writes
+    fseek(_file, 0, SEEK_END);
+  }
+}
+
+/***/
+void AsyncFileHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event)
+{
+  if (QUILL_UNLIKELY(!_pending_error.empty()))
+  {
+    std::string error;
+    error.swap(_pending_error);
+    QUILL_THROW(QuillError{std::move(error)});
+  }
+
+  std::string_view const message = apply_before_write(formatted_log_message);
+  _append(message.data(), message.size());
+
+  if (record_write(formatted_log_message.size(), log_event))
+  {
+    flush();
+  }
+}
+
+/***/
+void AsyncFileHandler::flush() noexcept
+{
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _submit_buffer();
+    _wait_all();
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH(std::exception const& e) { _pending_error = e.what(); }
+  QUILL_CATCH_ALL() { _pending_error = "Caught unhandled exception."; }
+#endif
+
+  fsync_if_needed();
+  reopen_if_deleted();
+}
+
+/***/
+void AsyncFileHandler::idle_flush() noexcept { _flush_without_waiting(); }
+
+/***/
+void AsyncFileHandler::run_loop() noexcept
+{
+  if ((_current_size != 0) || (_in_flight != 0))
+  {
+    _flush_without_waiting();
+  }
+}
+
+/***/
+void AsyncFileHandler::open_file(fs::path const& filename, std::string const& mode)
+{
+  // all the writes to the previous file are complete at this point
+  FileHandler::open_file(filename, mode);
+  _prepare_file();
+}
+
+/***/
+bool AsyncFileHandler::is_io_uring() const noexcept { return _writer->is_io_uring(); }
+
+/***/
+void AsyncFileHandler::_prepare_file()
+{
+  // anything written via the FILE* e.g. by the after_open callback goes first
+  fflush(_file);
+
+#if defined(_WIN32)
+  _fd = _fileno(_file);
+  _file_offset = static_cast<uint64_t>(_lseeki64(_fd, 0, SEEK_END));
+#else
+  _fd = fileno(_file);
+
+  if (_writer->is_io_uring())
+  {
+    // writes completing out of order must land at their own offset
+    int const flags = ::fcntl(_fd, F_GETFL);
+    if ((flags != -1) && ((flags & O_APPEND) != 0))
+    {
+      ::fcntl(_fd, F_SETFL, flags & ~O_APPEND);
+    }
+  }
+
+  _file_offset = static_cast<uint64_t>(::lseek(_fd, 0, SEEK_END));
+#endif
+}
+
+/***/
+void AsyncFileHandler::_append(char const* data, size_t size)
+{
+  while (size != 0)
+  {
+    if (_current_size == 0)
+    {
+      _current_buffer_since = std::chrono::steady_clock::now();
+    }
+
+    size_t const n = (std::min)(size, _buffer_size - _current_size);
+    std::memcpy(_buffer(_current_buffer) + _current_size, data, n);
+
+    _current_size += n;
+    data += n;
+    size -= n;
+
+    if (_current_size == _buffer_size)
+    {
+      _submit_buffer();
+    }
+  }
+}
+
+/***/
+void AsyncFileHandler::_submit_buffer()
+{
+  if (_current_size == 0)
+  {
+    return;
+  }
+
+  _writer->submit(_current_buffer, _buffer(_current_buffer), _current_size, _fd, _file_offset);
+  _file_offset += _current_size;
+  _current_size = 0;
+  ++_in_flight;
+
+  // pick the next buffer, we only block when all the buffers are in flight
+  do
+  {
+    _reap(_free_buffers.empty());
+  } while (_free_buffers.empty());
+
+  _current_buffer = _free_buffers.back();
+  _free_buffers.pop_back();
+}
+
+/***/
+void AsyncFileHandler::_reap(bool wait)
+{
+  _completed.clear();
+  std::string error = _writer->reap(wait, _completed);
+
+  _in_flight -= static_cast<uint32_t>(_completed.size());
+  _free_buffers.insert(_free_buffers.end(), _completed.begin(), _completed.end());
+
+  if (QUILL_UNLIKELY(!error.empty()))
+  {
+    QUILL_THROW(QuillError{std::move(error)});
+  }
+}
+
+/***/
+void AsyncFileHandler::_wait_all()
+{
+  while (_in_flight != 0)
+  {
+    _reap(true);
+  }
+}
+
+/***/
+void AsyncFileHandler::_flush_without_waiting() noexcept
+{
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    if (_in_flight != 0)
+    {
+      _reap(false);
+    }
+
+    // a partial buffer is submitted only when it does not have to wait for a free buffer
+    if ((_current_size != 0) && !_free_buffers.empty() &&
+        (std::chrono::steady_clock::now() - _current_buffer_since >= _config.idle_submit_interval()))
+    {
+      _submit_buffer();
+    }
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH(std::exception const& e) { _pending_error = e.what(); }
+  QUILL_CATCH_ALL() { _pending_error = "Caught unhandled exception."; }
+#endif
+
+  if ((_current_size == 0) && (_in_flight == 0))
+  {
+    // the file can only be synced or reopened once all the writes are complete
+    fsync_if_needed();
+    reopen_if_deleted();
+  }
+}
+} // namespace quill
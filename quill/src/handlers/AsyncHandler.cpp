@@ -0,0 +1,296 @@
+#include "quill/handlers/AsyncHandler.h"
+#include "quill/QuillError.h"       // for QUILL_THROW, QuillError
+#include "quill/detail/misc/Os.h"   // for set_thread_name
+#include <algorithm>                // for min
+#include <cstring>                  // for memcpy, strlen
+#include <utility>                  // for move
+
+namespace
+{
+/**
+ * Checks the capacity before the ring is allocated
+ */
+QUILL_NODISCARD uint32_t checked_capacity(size_t capacity)
+{
+  if ((capacity < 1024u) || (capacity > (size_t{1} << 31u)))
+  {
+    QUILL_THROW(quill::QuillError{"capacity must be between 1024 bytes and 2 GiB"});
+  }
+
+  return static_cast<uint32_t>(capacity);
+}
+
+/***/
+QUILL_NODISCARD size_t string_size(char const* str) noexcept
+{
+  return str ? (std::min)(std::strlen(str), size_t{UINT16_MAX}) : 0;
+}
+} // namespace
+
+namespace quill
+{
+/***/
+AsyncHandler::AsyncHandler(std::shared_ptr<Handler> handler, size_t capacity, OverflowPolicy overflow_policy)
+  : _handler(std::move(handler)), _queue(checked_capacity(capacity), false, 0), _overflow_policy(overflow_policy)
+{
+  if (!_handler)
+  {
+    QUILL_THROW(QuillError{"AsyncHandler requires a handler"});
+  }
+
+  // the writer thread flushes the wrapped handler each time the ring is drained
+  FlushPolicy flush_policy;
+  flush_policy.set_flush_on_idle(false);
+  set_flush_policy(flush_policy);
+
+  _writer_thread = std::thread([this]() { _run(); });
+}
+
+/***/
+AsyncHandler::~AsyncHandler()
+{
+  {
+    std::lock_guard<std::mutex> const lock{_mutex};
+    _stop.store(true, std::memory_order_release);
+  }
+
+  _writer_cv.notify_one();
+  _writer_thread.join();
+}
+
+/***/
+void AsyncHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event)
+{
+  if (QUILL_UNLIKELY(_has_error.load(std::memory_order_acquire)))
+  {
+    std::string error;
+
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+      error.swap(_error);
+      _has_error.store(false, std::memory_order_relaxed);
+    }
+
+    QUILL_THROW(QuillError{error});
+  }
+
+  size_t const thread_id_size = string_size(log_event.thread_id);
+  size_t const thread_name_size = string_size(log_event.thread_name);
+  std::string const& logger_name = log_event.header.logger_details->name();
+  size_t const logger_name_size = (std::min)(logger_name.size(), size_t{UINT16_MAX});
+  size_t const unpadded_size =
+    sizeof(Record) + formatted_log_message.size() + thread_id_size + thread_name_size + logger_name_size;
+  size_t const size = (unpadded_size + alignof(Record) - 1) & ~(alignof(Record) - 1);
+
+  if (QUILL_UNLIKELY(size > _queue.capacity()))
+  {
+    _dropped_messages.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  std::byte* dst = _queue.prepare_write(static_cast<uint32_t>(size));
+
+  if (QUILL_UNLIKELY(!dst))
+  {
+    if (_overflow_policy == OverflowPolicy::Drop)
+    {
+      _dropped_messages.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    _blocked_messages.fetch_add(1, std::memory_order_relaxed);
+
+    do
+    {
+      _wake_writer();
+      std::this_thread::yield();
+      dst = _queue.prepare_write(static_cast<uint32_t>(size));
+    } while (!dst);
+  }
+
+  Record const record{log_event.header,
+                      static_cast<uint32_t>(size),
+                      static_cast<uint32_t>(formatted_log_message.size()),
+                      static_cast<uint16_t>(thread_id_size),
+                      static_cast<uint16_t>(thread_name_size),
+                      static_cast<uint16_t>(logger_name_size),
+                      log_event.header.logger_details->timestamp_clock_type(),
+                      log_event.log_level()};
+
+  std::memcpy(dst, &record, sizeof(Record));
+  dst += sizeof(Record);
+  std::memcpy(dst, formatted_log_message.data(), formatted_log_message.size());
+  dst += formatted_log_message.size();
+  std::memcpy(dst, log_event.thread_id, thread_id_size);
+  dst += thread_id_size;
+  std::memcpy(dst, log_event.thread_name, thread_name_size);
+  dst += thread_name_size;
+  std::memcpy(dst, logger_name.data(), logger_name_size);
+
+  _queue.finish_write(static_cast<uint32_t>(size));
+  _queue.commit_write();
+
+  // pairs with the fence of the writer thread before it checks the ring and goes to sleep
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (_writer_sleeping.load(std::memory_order_relaxed))
+  {
+    _wake_writer();
+  }
+}
+
+/***/
+void AsyncHandler::flush() noexcept
+{
+  uint64_t const flush_sequence = _flush_sequence.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+  std::unique_lock<std::mutex> lock{_mutex};
+  _writer_cv.notify_one();
+  _flushed_cv.wait(lock, [this, flush_sequence]() { return _flushed_sequence >= flush_sequence; });
+}
+
+/***/
+void AsyncHandler::_run()
+{
+  QUILL_TRY { detail::set_thread_name("QuillAsyncHandler"); }
+  QUILL_CATCH_ALL() {}
+
+  bool has_unflushed{false};
+
+  while (true)
+  {
+    // everything written before a flush request or the stop is in the ring by now
+    uint64_t const flush_sequence = _flush_sequence.load(std::memory_order_acquire);
+    bool const stop = _stop.load(std::memory_order_acquire);
+
+    has_unflushed |= _write_records();
+
+    // only this thread modifies _flushed_sequence
+    if (has_unflushed || (flush_sequence != _flushed_sequence))
+    {
+      _handler->flush();
+      has_unflushed = false;
+
+      {
+        std::lock_guard<std::mutex> const lock{_mutex};
+        _flushed_sequence = flush_sequence;
+      }
+
+      _flushed_cv.notify_all();
+    }
+
+    if (stop)
+    {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    _writer_sleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    _writer_cv.wait(lock,
+                    [this, flush_sequence]()
+                    {
+                      return _stop.load(std::memory_order_relaxed) ||
+                        (_flush_sequence.load(std::memory_order_relaxed) != flush_sequence) ||
+                        (_queue.prepare_read() != nullptr);
+                    });
+
+    _writer_sleeping.store(false, std::memory_order_relaxed);
+  }
+}
+
+/***/
+bool AsyncHandler::_write_records()
+{
+  bool written{false};
+
+  while (std::byte* src = _queue.prepare_read())
+  {
+    Record record;
+    std::memcpy(&record, src, sizeof(Record));
+
+    char const* data = reinterpret_cast<char const*>(src) + sizeof(Record);
+    _formatted_log_message.clear();
+    _formatted_log_message.append(data, data + record.message_size);
+    data += record.message_size;
+    _thread_id.assign(data, record.thread_id_size);
+    data += record.thread_id_size;
+    _thread_name.assign(data, record.thread_name_size);
+    data += record.thread_name_size;
+    _logger_name.assign(data, record.logger_name_size);
+
+    _transit_event.header = record.header;
+    _transit_event.header.logger_details = _logger_details(record.timestamp_clock_type);
+    _transit_event.thread_id = _thread_id.data();
+    _transit_event.thread_name = _thread_name.data();
+    _transit_event.log_level_override = record.log_level;
+
+    std::string error;
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+    QUILL_TRY
+    {
+#endif
+      _handler->write(_formatted_log_message, _transit_event);
+#if !defined(QUILL_NO_EXCEPTIONS)
+    }
+    QUILL_CATCH(std::exception const& e) { error = e.what(); }
+    QUILL_CATCH_ALL() { error = "Caught unhandled exception."; }
+#endif
+
+    if (QUILL_UNLIKELY(!error.empty()))
+    {
+      std::lock_guard<std::mutex> const lock{_mutex};
+
+      if (_error.empty())
+      {
+        _error = std::move(error);
+      }
+
+      _has_error.store(true, std::memory_order_release);
+    }
+
+    _queue.finish_read(record.size);
+    _queue.commit_read();
+    written = true;
+  }
+
+  return written;
+}
+
+/***/
+detail::LoggerDetails const* AsyncHandler::_logger_details(TimestampClockType timestamp_clock_type)
+{
+  if (_last_logger && (_last_logger->name() == _logger_name))
+  {
+    return _last_logger;
+  }
+
+  auto search = _loggers.find(_logger_name);
+
+  if (search == _loggers.end())
+  {
+    // the wrapped handler only sees the name and the clock type of the logger
+    search = _loggers
+               .emplace(_logger_name,
+                        std::make_unique<detail::LoggerDetails>(
+                          _logger_name, std::vector<std::shared_ptr<Handler>>{}, timestamp_clock_type))
+               .first;
+  }
+
+  _last_logger = search->second.get();
+  return _last_logger;
+}
+
+/***/
+void AsyncHandler::_wake_writer()
+{
+  {
+    // the writer thread is either before its check of the ring or waiting
+    std::lock_guard<std::mutex> const lock{_mutex};
+  }
+
+  _writer_cv.notify_one();
+}
+} // namespace quill
@@ -0,0 +1,391 @@
+#include "quill/handlers/BufferedFileHandler.h"
+#include "quill/Fmt.h"                  // for format
+#include "quill/QuillError.h"           // for QUILL_THROW, QuillError
+#include "quill/detail/misc/Common.h"   // for QUILL_UNLIKELY
+#include "quill/detail/misc/Os.h"       // for alloc_aligned
+#include <algorithm>                    // for max
+#include <cerrno>                       // for errno, EINTR
+#include <cstdio>                       // for fflush, fseek
+#include <cstring>                      // for memcpy, memmove, strerror
+
+#if defined(_WIN32)
+  #include <io.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+constexpr size_t write_buffer_alignment{4096u};
+
+/***/
+QUILL_NODISCARD size_t align_up(size_t value) noexcept
+{
+  return ((value + write_buffer_alignment - 1) / write_buffer_alignment) * write_buffer_alignment;
+}
+
+/***/
+QUILL_NODISCARD std::string write_error(char const* function)
+{
+  return fmtquill::format("{} failed with error message errno: \"{}\" {}", function, errno,
+                                 strerror(errno));
+}
+
+/**
+ * Writes the whole buffer at the current file position
+ * @return the number of bytes written, less than size when the write failed and errno is set
+ */
+QUILL_NODISCARD size_t write_fully(int fd, char const* data, size_t size) noexcept
+{
+  size_t total_written{0};
+
+  while (total_written != size)
+  {
+#if defined(_WIN32)
+    auto const written =
+      ::_write(fd, data + total_written, static_cast<unsigned int>(size - total_written));
+#else
+    auto const written = ::write(fd, data + total_written, size - total_written);
+#endif
+
+    if (QUILL_UNLIKELY(written < 0))
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      break;
+    }
+
+    total_written += static_cast<size_t>(written);
+  }
+
+  return total_written;
+}
+
+#if defined(__linux__)
+/**
+ * Writes the whole buffer at the given offset
+ */
+void pwrite_fully(int fd, char const* data, size_t size, uint64_t offset)
+{
+  while (size != 0)
+  {
+    auto const written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+
+    if (QUILL_UNLIKELY(written < 0))
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      QUILL_THROW(quill::QuillError{write_error("pwrite")});
+    }
+
+    data += written;
+    size -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+}
+#endif
+} // namespace
+
+namespace quill
+{
+namespace detail
+{
+/***/
+AlignedWriteBuffer::AlignedWriteBuffer(size_t capacity, size_t alignment) : _alignment(alignment)
+{
+  _reallocate(capacity);
+}
+
+/***/
+AlignedWriteBuffer::~AlignedWriteBuffer()
+{
+  if (data())
+  {
+    free_aligned(data());
+  }
+}
+
+/***/
+void AlignedWriteBuffer::grow(size_t capacity) { _reallocate((std::max)(capacity, 2 * this->capacity())); }
+
+/***/
+void AlignedWriteBuffer::_reallocate(size_t capacity)
+{
+  capacity = ((capacity + _alignment - 1) / _alignment) * _alignment;
+
+  auto* new_data = static_cast<char*>(alloc_aligned(capacity, _alignment));
+  char* old_data = data();
+
+  if (size() != 0)
+  {
+    std::memcpy(new_data, old_data, size());
+  }
+
+  set(new_data, capacity);
+
+  if (old_data)
+  {
+    free_aligned(old_data);
+  }
+}
+} // namespace detail
+
+/***/
+void BufferedFileHandlerConfig::set_write_buffer_size(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"write_buffer_size must be greater than zero"});
+  }
+
+  _write_buffer_size = value;
+}
+
+/***/
+void BufferedFileHandlerConfig::set_direct_io(bool value) { _direct_io = value; }
+
+/***/
+BufferedFileHandler::BufferedFileHandler(fs::path const& filename, BufferedFileHandlerConfig const& config,
+                                         FileEventNotifier file_event_notifier)
+  : FileHandler(filename, static_cast<FileHandlerConfig const&>(config), std::move(file_event_notifier)),
+    _config(config),
+    _buffer(align_up(config.write_buffer_size()), write_buffer_alignment),
+    // leave some room at the end so that most messages fit without growing the buffer
+    _write_threshold(_buffer.capacity() - _buffer.capacity() / 8)
+{
+  _prepare_file();
+}
+
+/***/
+BufferedFileHandler::~BufferedFileHandler()
+{
+  // a failure can no longer be reported, a previous one does not stop writing what is left
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _write_buffer(true);
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH_ALL() {}
+#endif
+
+  _disable_direct_io();
+
+  if (_file)
+  {
+    // anything written by the before_close callback goes after our writes
+    fseek(_file, 0, SEEK_END);
+  }
+}
+
+/***/
+void BufferedFileHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event)
+{
+  std::string_view const message = apply_before_write(formatted_log_message);
+  _buffer.append(message.data(), message.data() + message.size());
+
+  _on_append(log_event);
+}
+
+/***/
+fmtquill::detail::buffer<char>* BufferedFileHandler::direct_write_buffer() noexcept
+{
+  // before_write needs the formatted message on its own
+  return has_before_write() ? nullptr : &_buffer;
+}
+
+/***/
+void BufferedFileHandler::on_direct_write(quill::TransitEvent const& log_event)
+{
+  _on_append(log_event);
+}
+
+/***/
+void BufferedFileHandler::flush() noexcept
+{
+  // the buffer is always written, a failure is kept and reported on the next write
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _write_buffer(true);
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH(std::exception const& e) { _pending_error = e.what(); }
+  QUILL_CATCH_ALL() { _pending_error = "Caught unhandled exception."; }
+#endif
+
+  fsync_if_needed();
+  reopen_if_deleted();
+}
+
+/***/
+void BufferedFileHandler::open_file(fs::path const& filename, std::string const& mode)
+{
+  // a partial O_DIRECT block of the previous file may still be in the buffer
+  _buffer.clear();
+  _recorded_size = 0;
+
+  FileHandler::open_file(filename, mode);
+  _prepare_file();
+}
+
+/***/
+void BufferedFileHandler::close_file()
+{
+  // the before_close callback writes via the FILE*
+  _disable_direct_io();
+  FileHandler::close_file();
+}
+
+/***/
+void BufferedFileHandler::_on_append(quill::TransitEvent const& log_event)
+{
+  bool const flush_now = record_write(_buffer.size() - _recorded_size, log_event);
+  _recorded_size = _buffer.size();
+
+  if (_buffer.size() >= _write_threshold)
+  {
+    _write_buffer(false);
+  }
+
+  if (flush_now)
+  {
+    flush();
+  }
+
+  if (QUILL_UNLIKELY(!_pending_error.empty()))
+  {
+    // report a failed flush once, the unwritten data is still in the buffer and retried
+    std::string error;
+    error.swap(_pending_error);
+    QUILL_THROW(QuillError{std::move(error)});
+  }
+}
+
+/***/
+void BufferedFileHandler::_prepare_file()
+{
+  // anything written via the FILE* e.g. by the after_open callback goes first
+  fflush(_file);
+
+#if defined(_WIN32)
+  _fd = _fileno(_file);
+#else
+  _fd = fileno(_file);
+#endif
+
+#if defined(__linux__)
+  if (_config.direct_io())
+  {
+    // O_DIRECT writes need explicit block aligned offsets so O_APPEND is also removed.
+    // This fails on filesystems without O_DIRECT support and we keep using the page cache
+    int const flags = ::fcntl(_fd, F_GETFL);
+    _direct_io = (flags != -1) && (::fcntl(_fd, F_SETFL, (flags | O_DIRECT) & ~O_APPEND) == 0);
+
+    if (_direct_io)
+    {
+      // start from the last block of the file, the partial block is rewritten with our data
+      auto const file_size = static_cast<uint64_t>(::lseek(_fd, 0, SEEK_END));
+      _file_offset = file_size - (file_size % write_buffer_alignment);
+
+      if (size_t const tail = static_cast<size_t>(file_size - _file_offset); tail != 0)
+      {
+        _buffer.try_resize(write_buffer_alignment);
+        auto const res = ::pread(_fd, _buffer.data(), write_buffer_alignment, static_cast<off_t>(_file_offset));
+        _buffer.try_resize(tail);
+
+        if (res != static_cast<ssize_t>(tail))
+        {
+          // can not read back the partial block, keep using the page cache
+          _buffer.clear();
+          _disable_direct_io();
+        }
+      }
+    }
+  }
+#endif
+}
+
+/***/
+void BufferedFileHandler::_disable_direct_io() noexcept
+{
+#if defined(__linux__)
+  if (_direct_io)
+  {
+    int const flags = ::fcntl(_fd, F_GETFL);
+    if (flags != -1)
+    {
+      ::fcntl(_fd, F_SETFL, flags & ~O_DIRECT);
+    }
+
+    // the buffer is always written out before, continue from the end of the file
+    ::lseek(_fd, 0, SEEK_END);
+    _direct_io = false;
+  }
+#endif
+}
+
+/***/
+void BufferedFileHandler::_write_buffer(bool write_tail)
+{
+  if (_buffer.size() == 0)
+  {
+    return;
+  }
+
+#if defined(__linux__)
+  if (_direct_io)
+  {
+    // only whole blocks are written with O_DIRECT, the tail stays in the buffer
+    size_t const aligned_size = _buffer.size() - (_buffer.size() % write_buffer_alignment);
+    size_t const tail = _buffer.size() - aligned_size;
+
+    pwrite_fully(_fd, _buffer.data(), aligned_size, _file_offset);
+
+    if (write_tail && (tail != 0))
+    {
+      // write the tail via the page cache, it will be overwritten once the block is complete
+      int const flags = ::fcntl(_fd, F_GETFL);
+      ::fcntl(_fd, F_SETFL, flags & ~O_DIRECT);
+      pwrite_fully(_fd, _buffer.data() + aligned_size, tail, _file_offset + aligned_size);
+      ::fcntl(_fd, F_SETFL, flags);
+    }
+
+    _file_offset += aligned_size;
+    std::memmove(_buffer.data(), _buffer.data() + aligned_size, tail);
+    _buffer.try_resize(tail);
+    _recorded_size = tail;
+    return;
+  }
+#else
+  (void)write_tail;
+#endif
+
+  size_t const written = write_fully(_fd, _buffer.data(), _buffer.size());
+
+  if (QUILL_UNLIKELY(written != _buffer.size()))
+  {
+    std::string error = write_error("write");
+
+    // keep only what was not written, it is retried by the next write of the buffer
+    size_t const remaining = _buffer.size() - written;
+    std::memmove(_buffer.data(), _buffer.data() + written, remaining);
+    _buffer.try_resize(remaining);
+    _recorded_size = remaining;
+
+    QUILL_THROW(QuillError{std::move(error)});
+  }
+
+  _buffer.clear();
+  _recorded_size = 0;
+}
+} // namespace quill
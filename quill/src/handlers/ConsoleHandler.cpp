@@ -219,18 +219,23 @@ void ConsoleHandler::write(fmt_buffer_t const& formatted_log_message, quill::Tra
 #else
   if (_console_colours.can_use_colours())
   {
-    // Write colour code
+    // Splice the colour codes around the record, so that the FILE lock is taken once.
+    // The stream is shared with the application so it is still written via the locked fwrite
     std::string const& colour_code = _console_colours.colour_code(macro_metadata.level());
 
-    detail::fwrite_fully(colour_code.data(), sizeof(char), colour_code.size(), _file);
-  }
-
-  // Write record to file
-  StreamHandler::write(formatted_log_message, log_event);
+    _colour_buffer.clear();
+    _colour_buffer.append(colour_code.data(), colour_code.data() + colour_code.size());
+    _colour_buffer.append(formatted_log_message.data(),
+                          formatted_log_message.data() + formatted_log_message.size());
+    _colour_buffer.append(ConsoleColours::reset.data(),
+                          ConsoleColours::reset.data() + ConsoleColours::reset.size());
 
-  if (_console_colours.can_use_colours())
+    detail::fwrite_fully(_colour_buffer.data(), sizeof(char), _colour_buffer.size(), _file);
+  }
+  else
   {
-    detail::fwrite_fully(ConsoleColours::reset.data(), sizeof(char), ConsoleColours::reset.size(), _file);
+    // Write record to file
+    StreamHandler::write(formatted_log_message, log_event);
   }
 #endif
 }
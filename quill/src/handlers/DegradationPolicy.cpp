@@ -0,0 +1,19 @@
+#include "quill/handlers/DegradationPolicy.h"
+
+namespace quill
+{
+/***/
+void DegradationPolicy::set_latency_threshold(std::chrono::microseconds value)
+{
+  _latency_threshold = value;
+}
+
+/***/
+void DegradationPolicy::set_min_log_level(LogLevel value) { _min_log_level = value; }
+
+/***/
+void DegradationPolicy::set_degraded_duration(std::chrono::milliseconds value)
+{
+  _degraded_duration = value;
+}
+} // namespace quill
@@ -4,6 +4,10 @@
 #include "quill/detail/misc/Os.h"
 #include <cstdio> // for fclose
 
+#if !defined(_WIN32)
+  #include <sys/stat.h>
+#endif
+
 namespace
 {
 QUILL_NODISCARD quill::fs::path get_appended_filename(quill::fs::path const& filename,
@@ -41,6 +45,24 @@ void FileHandlerConfig::set_timezone(Timezone timezone) { _timezone_value = time
 /***/
 void FileHandlerConfig::set_do_fsync(bool value) { _do_fsync = value; }
 
+/***/
+void FileHandlerConfig::set_fsync_min_bytes(size_t value) { _fsync_min_bytes = value; }
+
+/***/
+void FileHandlerConfig::set_fsync_interval(std::chrono::milliseconds value)
+{
+  _fsync_interval = value;
+}
+
+/***/
+void FileHandlerConfig::set_fsync_log_level(LogLevel value) { _fsync_log_level = value; }
+
+/***/
+void FileHandlerConfig::set_file_check_interval(std::chrono::milliseconds value)
+{
+  _file_check_interval = value;
+}
+
 /***/
 void FileHandlerConfig::set_open_mode(char open_mode) { _open_mode = open_mode; }
 
@@ -112,25 +134,119 @@ void FileHandler::close_file()
 /***/
 FileHandler::~FileHandler() { close_file(); }
 
+/***/
+void FileHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event)
+{
+  StreamHandler::write(formatted_log_message, log_event);
+
+  if (record_write(formatted_log_message.size(), log_event))
+  {
+    flush();
+  }
+}
+
 /***/
 void FileHandler::flush() noexcept
 {
   StreamHandler::flush();
+  fsync_if_needed();
+  reopen_if_deleted();
+}
+
+/***/
+bool FileHandler::record_write(size_t size, quill::TransitEvent const& log_event) noexcept
+{
+  _unsynced_bytes += size;
+
+  if ((_config.fsync_log_level() != LogLevel::None) && (log_event.log_level() >= _config.fsync_log_level()))
+  {
+    _fsync_requested = true;
+  }
+
+  return _fsync_requested;
+}
+
+/***/
+void FileHandler::fsync_if_needed() noexcept
+{
+  bool do_fsync = _config.do_fsync() || _fsync_requested;
 
-  if (_config.do_fsync())
+  if (!do_fsync && (_unsynced_bytes != 0))
   {
-    detail::fsync(_file);
+    if ((_config.fsync_min_bytes() != 0) && (_unsynced_bytes >= _config.fsync_min_bytes()))
+    {
+      do_fsync = true;
+    }
+    else if ((_config.fsync_interval().count() != 0) &&
+             (std::chrono::steady_clock::now() - _last_fsync_time >= _config.fsync_interval()))
+    {
+      do_fsync = true;
+    }
+  }
+
+  if (!do_fsync || !_file)
+  {
+    return;
+  }
+
+  detail::fdatasync(_file);
+
+  _unsynced_bytes = 0;
+  _fsync_requested = false;
+
+  if (_config.fsync_interval().count() != 0)
+  {
+    _last_fsync_time = std::chrono::steady_clock::now();
   }
+}
 
-  if (!fs::exists(_filename))
+/***/
+bool FileHandler::reopen_if_deleted()
+{
+  if (_config.file_check_interval().count() != 0)
   {
-    // after flushing the file we can check if the file still exists. If not we reopen it.
-    // This can happen if a user deletes a file while the application is running
-    close_file();
+    auto const now = std::chrono::steady_clock::now();
+
+    if (now < _next_file_check_time)
+    {
+      return false;
+    }
+
+    _next_file_check_time = now + _config.file_check_interval();
+  }
 
-    // now reopen the file for writing again, it will be a new file
-    open_file(_filename, "w");
+  if (!_is_file_deleted())
+  {
+    return false;
   }
+
+  // This can happen if a user deletes a file while the application is running
+  close_file();
+
+  // now reopen the file for writing again, it will be a new file
+  open_file(_filename, "w");
+  return true;
 }
 
+/***/
+bool FileHandler::_is_file_deleted() const
+{
+  if (!_file)
+  {
+    return false;
+  }
+
+#if defined(_WIN32)
+  return !fs::exists(_filename);
+#else
+  // the open file is unlinked when its last name is removed, no path lookup is needed
+  struct stat st;
+  if (::fstat(fileno(_file), &st) != 0)
+  {
+    return false;
+  }
+
+  return st.st_nlink == 0;
+#endif
+}
 } // namespace quill
@@ -0,0 +1,265 @@
+#include "quill/handlers/FlightRecorderHandler.h"
+#include "quill/Fmt.h"        // for format
+#include "quill/QuillError.h" // for QUILL_THROW, QuillError
+#include <algorithm>          // for min
+#include <cerrno>             // for errno
+#include <cstring>            // for memcpy, memcmp, strerror
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+constexpr char flight_recorder_magic[8] = {'Q', 'U', 'I', 'L', 'L', 'F', 'R', '1'};
+constexpr uint32_t flight_recorder_version{1};
+
+/***/
+QUILL_NODISCARD std::string mmap_error(char const* function, quill::fs::path const& filename)
+{
+  return fmtquill::format("{} failed for file {} with error message errno: \"{}\" {}", function,
+                          filename.string(), errno, strerror(errno));
+}
+
+/***/
+QUILL_NODISCARD bool is_valid_header(quill::FlightRecorderHeader const* header, uint64_t file_size) noexcept
+{
+  return (std::memcmp(header->magic, flight_recorder_magic, sizeof(flight_recorder_magic)) == 0) &&
+    (header->version == flight_recorder_version) && (header->header_size == sizeof(quill::FlightRecorderHeader)) &&
+    (header->capacity != 0) && (file_size >= header->header_size + header->capacity);
+}
+
+/**
+ * Copies the bytes [begin, end) of the ring, the range is at most capacity bytes
+ */
+void copy_from_ring(char const* ring, uint64_t capacity, uint64_t begin, uint64_t end, std::string& out)
+{
+  auto const size = static_cast<size_t>(end - begin);
+  auto const offset = static_cast<size_t>(begin % capacity);
+  size_t const first = (std::min)(size, static_cast<size_t>(capacity) - offset);
+
+  out.append(ring + offset, first);
+  out.append(ring, size - first);
+}
+} // namespace
+
+namespace quill
+{
+/***/
+void FlightRecorderHandlerConfig::set_capacity(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"capacity must be greater than zero"});
+  }
+
+  _capacity = value;
+}
+
+/***/
+void FlightRecorderHandlerConfig::set_open_mode(char open_mode) { _open_mode = open_mode; }
+
+/***/
+void FlightRecorderHandlerConfig::set_pattern(std::string const& log_pattern,
+                                              std::string const& time_format /* = std::string{"%H:%M:%S.%Qns"} */)
+{
+  _log_pattern = log_pattern;
+  _time_format = time_format;
+}
+
+/***/
+FlightRecorderHandler::FlightRecorderHandler(fs::path const& filename, FlightRecorderHandlerConfig const& config)
+  : _filename(filename), _capacity(config.capacity())
+{
+  if (!config.log_pattern().empty())
+  {
+    set_pattern(config.log_pattern(), config.time_format());
+  }
+
+#if defined(_WIN32)
+  QUILL_THROW(QuillError{"FlightRecorderHandler is not supported on windows"});
+#else
+  int const fd = ::open(_filename.string().data(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+  if (fd == -1)
+  {
+    QUILL_THROW(QuillError{mmap_error("open", _filename)});
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0)
+  {
+    ::close(fd);
+    QUILL_THROW(QuillError{mmap_error("fstat", _filename)});
+  }
+
+  _mapped_size = static_cast<size_t>(sizeof(FlightRecorderHeader) + _capacity);
+  bool reuse = (config.open_mode() == 'a') && (static_cast<uint64_t>(st.st_size) == _mapped_size);
+
+  if (!reuse)
+  {
+    // start from an empty file, the ring reads as zeros
+    if ((::ftruncate(fd, 0) != 0) || (::ftruncate(fd, static_cast<off_t>(_mapped_size)) != 0))
+    {
+      ::close(fd);
+      QUILL_THROW(QuillError{mmap_error("ftruncate", _filename)});
+    }
+  }
+
+  #if defined(__linux__)
+  // reserve real blocks so that a full disk does not end up as SIGBUS in write(), best effort
+  ::posix_fallocate(fd, 0, static_cast<off_t>(_mapped_size));
+  #endif
+
+  void* mapping = ::mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+
+  if (mapping == MAP_FAILED)
+  {
+    QUILL_THROW(QuillError{mmap_error("mmap", _filename)});
+  }
+
+  _header = static_cast<FlightRecorderHeader*>(mapping);
+  _ring = static_cast<char*>(mapping) + sizeof(FlightRecorderHeader);
+
+  reuse = reuse && is_valid_header(_header, _mapped_size) && (_header->capacity == _capacity);
+
+  if (reuse)
+  {
+    // continue after the last published log message, a message torn by a crash is overwritten
+    _write_position = _header->write_position.load(std::memory_order_relaxed);
+    _sequence = _header->sequence.load(std::memory_order_relaxed);
+    _header->reserved_position.store(_write_position, std::memory_order_relaxed);
+  }
+  else
+  {
+    _header->version = flight_recorder_version;
+    _header->header_size = static_cast<uint32_t>(sizeof(FlightRecorderHeader));
+    _header->capacity = _capacity;
+    _header->write_position.store(0, std::memory_order_relaxed);
+    _header->reserved_position.store(0, std::memory_order_relaxed);
+    _header->sequence.store(0, std::memory_order_relaxed);
+
+    // the magic goes last, a reader never sees a partially initialised header as valid
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(_header->magic, flight_recorder_magic, sizeof(flight_recorder_magic));
+  }
+#endif
+}
+
+/***/
+FlightRecorderHandler::~FlightRecorderHandler()
+{
+#if !defined(_WIN32)
+  if (_header)
+  {
+    ::munmap(_header, _mapped_size);
+  }
+#endif
+}
+
+/***/
+void FlightRecorderHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const&)
+{
+  char const* data = formatted_log_message.data();
+  auto size = static_cast<uint64_t>(formatted_log_message.size());
+  uint64_t position = _write_position;
+
+  if (QUILL_UNLIKELY(size > _capacity))
+  {
+    // only the end of the log message fits
+    position += size - _capacity;
+    data += size - _capacity;
+    size = _capacity;
+  }
+
+  uint64_t const end_position = position + size;
+
+  // the bytes about to be overwritten are no longer valid for a concurrent reader
+  _header->reserved_position.store(end_position, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  auto const offset = static_cast<size_t>(position % _capacity);
+  size_t const first = (std::min)(static_cast<size_t>(size), static_cast<size_t>(_capacity) - offset);
+
+  std::memcpy(_ring + offset, data, first);
+  std::memcpy(_ring, data + first, static_cast<size_t>(size) - first);
+
+  _write_position = end_position;
+  _header->write_position.store(end_position, std::memory_order_release);
+  _header->sequence.store(++_sequence, std::memory_order_release);
+}
+
+/***/
+std::string FlightRecorderHandler::read(fs::path const& filename)
+{
+  std::string result;
+
+#if defined(_WIN32)
+  (void)filename;
+  QUILL_THROW(QuillError{"FlightRecorderHandler is not supported on windows"});
+#else
+  int const fd = ::open(filename.string().data(), O_RDONLY | O_CLOEXEC);
+
+  if (fd == -1)
+  {
+    QUILL_THROW(QuillError{mmap_error("open", filename)});
+  }
+
+  struct stat st;
+  if ((::fstat(fd, &st) != 0) || (static_cast<size_t>(st.st_size) < sizeof(FlightRecorderHeader)))
+  {
+    ::close(fd);
+    QUILL_THROW(QuillError{"not a flight recorder file " + filename.string()});
+  }
+
+  auto const file_size = static_cast<size_t>(st.st_size);
+  void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+
+  if (mapping == MAP_FAILED)
+  {
+    QUILL_THROW(QuillError{mmap_error("mmap", filename)});
+  }
+
+  auto const* header = static_cast<FlightRecorderHeader const*>(mapping);
+
+  if (!is_valid_header(header, file_size))
+  {
+    ::munmap(mapping, file_size);
+    QUILL_THROW(QuillError{"not a flight recorder file " + filename.string()});
+  }
+
+  char const* ring = static_cast<char const*>(mapping) + header->header_size;
+  uint64_t const capacity = header->capacity;
+
+  uint64_t const write_position = header->write_position.load(std::memory_order_acquire);
+  uint64_t const begin = (write_position > capacity) ? (write_position - capacity) : 0;
+
+  copy_from_ring(ring, capacity, begin, write_position, result);
+
+  // drop anything the writer overwrote while we were copying
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t const reserved_position = header->reserved_position.load(std::memory_order_relaxed);
+  uint64_t const valid_begin = (reserved_position > capacity) ? (reserved_position - capacity) : 0;
+
+  ::munmap(mapping, file_size);
+
+  size_t skip = (valid_begin > begin) ? static_cast<size_t>(valid_begin - begin) : 0;
+
+  if ((skip != 0) || (begin != 0))
+  {
+    // the oldest log message was partially overwritten
+    size_t const eol = result.find('\n', (std::min)(skip, result.size()));
+    skip = (eol == std::string::npos) ? result.size() : eol + 1;
+  }
+
+  result.erase(0, (std::min)(skip, result.size()));
+#endif
+
+  return result;
+}
+} // namespace quill
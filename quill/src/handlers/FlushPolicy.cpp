@@ -0,0 +1,16 @@
+#include "quill/handlers/FlushPolicy.h"
+
+namespace quill
+{
+/***/
+void FlushPolicy::set_flush_log_level(LogLevel value) { _flush_log_level = value; }
+
+/***/
+void FlushPolicy::set_flush_bytes(size_t value) { _flush_bytes = value; }
+
+/***/
+void FlushPolicy::set_flush_interval(std::chrono::milliseconds value) { _flush_interval = value; }
+
+/***/
+void FlushPolicy::set_flush_on_idle(bool value) { _flush_on_idle = value; }
+} // namespace quill
@@ -39,6 +39,24 @@ QUILL_NODISCARD bool Handler::apply_filters(char const* thread_id, std::chrono::
     return false;
   }
 
+  _update_local_filters();
+
+  return std::all_of(
+    _local_filters.begin(), _local_filters.end(),
+    [thread_id, log_message_timestamp, &metadata, &formatted_record](FilterBase* filter_elem)
+    { return filter_elem->filter(thread_id, log_message_timestamp, metadata, formatted_record); });
+}
+
+/***/
+bool Handler::has_filters()
+{
+  _update_local_filters();
+  return !_local_filters.empty();
+}
+
+/***/
+void Handler::_update_local_filters()
+{
   // Update our local collection of the filters
   if (QUILL_UNLIKELY(_new_filter.load(std::memory_order_relaxed)))
   {
@@ -54,11 +72,134 @@ QUILL_NODISCARD bool Handler::apply_filters(char const* thread_id, std::chrono::
     // all filters loaded so change to false
     _new_filter.store(false, std::memory_order_relaxed);
   }
+}
 
-  return std::all_of(
-    _local_filters.begin(), _local_filters.end(),
-    [thread_id, log_message_timestamp, &metadata, &formatted_record](FilterBase* filter_elem)
-    { return filter_elem->filter(thread_id, log_message_timestamp, metadata, formatted_record); });
+/***/
+bool Handler::record_unflushed_write(size_t bytes, LogLevel log_level) noexcept
+{
+  bool const has_interval = _flush_policy.flush_interval().count() != 0;
+
+  if (!_has_unflushed_writes)
+  {
+    _has_unflushed_writes = true;
+
+    if (has_interval)
+    {
+      _unflushed_since = std::chrono::steady_clock::now();
+    }
+  }
+
+  _unflushed_bytes += bytes;
+
+  if (log_level >= _flush_policy.flush_log_level())
+  {
+    return true;
+  }
+
+  if ((_flush_policy.flush_bytes() != 0) && (_unflushed_bytes >= _flush_policy.flush_bytes()))
+  {
+    return true;
+  }
+
+  // only read the clock when needed
+  return has_interval &&
+    (std::chrono::steady_clock::now() - _unflushed_since >= _flush_policy.flush_interval());
+}
+
+/***/
+bool Handler::should_flush_on_idle(std::chrono::steady_clock::time_point now) const noexcept
+{
+  if (!_has_unflushed_writes)
+  {
+    return false;
+  }
+
+  return _flush_policy.flush_on_idle() ||
+    ((_flush_policy.flush_interval().count() != 0) && (now - _unflushed_since >= _flush_policy.flush_interval()));
 }
 
+/***/
+bool Handler::record_write_latency(std::chrono::steady_clock::time_point write_start,
+                                   std::chrono::steady_clock::time_point write_end) noexcept
+{
+  // exponential moving average, a single slow write does not degrade the handler. It is also
+  // updated by the log messages that are still written while degraded
+  _write_latency += ((write_end - write_start) - _write_latency) / 8;
+
+  if (_degraded)
+  {
+    if (_probe_pending)
+    {
+      // the first write after the degraded duration elapsed
+      _probe_latency = write_end - write_start;
+      _probe_pending = false;
+      _has_probe_latency = true;
+    }
+
+    return false;
+  }
+
+  if (_write_latency <= _degradation_policy.latency_threshold())
+  {
+    return false;
+  }
+
+  _degraded = true;
+  _degraded_until = write_end + _degradation_policy.degraded_duration();
+  _degraded_skipped_messages = 0;
+  return true;
+}
+
+/***/
+bool Handler::skip_degraded_write(LogLevel log_level) noexcept
+{
+  if (!_degraded || (log_level >= _degradation_policy.min_log_level()) || _probe_pending)
+  {
+    // a probe is written to measure the latency when no other log messages are written
+    return false;
+  }
+
+  ++_degraded_skipped_messages;
+  return true;
+}
+
+/***/
+bool Handler::leave_degraded_mode(std::chrono::steady_clock::time_point now, size_t& skipped_messages) noexcept
+{
+  if (!_degraded || (now < _degraded_until))
+  {
+    return false;
+  }
+
+  auto const latency_threshold = _degradation_policy.latency_threshold();
+
+  if (_write_latency > latency_threshold)
+  {
+    if (!_has_probe_latency)
+    {
+      // measure a single write, the average may not have been updated while degraded
+      _probe_pending = true;
+      return false;
+    }
+
+    _has_probe_latency = false;
+
+    if (_probe_latency > latency_threshold)
+    {
+      // still slow, stay degraded for another degraded duration
+      _degraded_until = now + _degradation_policy.degraded_duration();
+      return false;
+    }
+
+    // the probe is fast, start the average again from it
+    _write_latency = _probe_latency;
+  }
+
+  skipped_messages = _degraded_skipped_messages;
+  _degraded = false;
+  _degraded_skipped_messages = 0;
+  _probe_pending = false;
+  _has_probe_latency = false;
+  return true;
+}
 } // namespace quill
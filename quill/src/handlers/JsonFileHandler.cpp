@@ -16,9 +16,24 @@ void JsonFileHandler::write(fmt_buffer_t const& formatted_log_message, quill::Tr
     macro_metadata.filename(), macro_metadata.lineno(), log_event.thread_id,
     log_event.header.logger_details->name(), log_event.log_level_as_str(), macro_metadata.message_format()));
 
+  Sanitizer* sanitizer = this->sanitizer();
+
   for (auto const& [key, value] : log_event.structured_kvs)
   {
-    _json_message.append(fmtquill::format(R"(, "{}": "{}")", key, value));
+    if (sanitizer)
+    {
+      // the message is not written, only the structured values carry the logged data
+      _structured_value.clear();
+      _structured_value.append(value.data(), value.data() + value.size());
+      fmtquill::detail::buffer<char> const& sanitized_value = sanitizer->sanitize(_structured_value);
+
+      _json_message.append(fmtquill::format(R"(, "{}": "{}")", key,
+                                            std::string_view{sanitized_value.data(), sanitized_value.size()}));
+    }
+    else
+    {
+      _json_message.append(fmtquill::format(R"(, "{}": "{}")", key, value));
+    }
   }
 
   _json_message.append(std::string_view{" }\n"});
@@ -0,0 +1,309 @@
+#include "quill/handlers/MmapFileHandler.h"
+#include "quill/Fmt.h"                // for format
+#include "quill/QuillError.h"         // for QUILL_THROW, QuillError
+#include "quill/detail/misc/Common.h" // for QUILL_UNLIKELY
+#include <algorithm>                  // for min
+#include <cerrno>                     // for errno
+#include <cstdio>                     // for fflush, fseek
+#include <cstring>                    // for memcpy, strerror
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+/***/
+QUILL_NODISCARD size_t page_size() noexcept
+{
+#if defined(_WIN32)
+  return 4096u;
+#else
+  static size_t const value = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  return value;
+#endif
+}
+
+/***/
+QUILL_NODISCARD quill::RotatingFileHandlerConfig rotating_config(quill::MmapFileHandlerConfig const& config)
+{
+  quill::RotatingFileHandlerConfig rotating_config = config;
+
+  // the mapping is tied to the open file, it can not be switched by the rotation worker
+  rotating_config.set_async_rotation(false);
+  rotating_config.set_preallocate(false);
+
+  // the messages are copied to the mapping as they are
+  if (rotating_config.compression() == quill::RotatingFileHandlerConfig::Compression::GzipStream)
+  {
+    rotating_config.set_compression(quill::RotatingFileHandlerConfig::Compression::None);
+  }
+
+  return rotating_config;
+}
+
+/***/
+QUILL_NODISCARD std::string mmap_error(char const* function)
+{
+  return fmtquill::format("{} failed with error message errno: \"{}\" {}", function, errno, strerror(errno));
+}
+} // namespace
+
+namespace quill
+{
+/***/
+void MmapFileHandlerConfig::set_chunk_size(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"chunk_size must be greater than zero"});
+  }
+
+  _chunk_size = value;
+}
+
+/***/
+void MmapFileHandlerConfig::set_sync_policy(SyncPolicy value) { _sync_policy = value; }
+
+/***/
+MmapFileHandler::MmapFileHandler(fs::path const& filename, MmapFileHandlerConfig const& config,
+                                 FileEventNotifier file_event_notifier,
+                                 std::chrono::system_clock::time_point start_time /* = std::chrono::system_clock::now() */)
+  : RotatingFileHandler(filename, rotating_config(config), std::move(file_event_notifier), start_time),
+    _config(config),
+    _chunk_size(((config.chunk_size() + page_size() - 1) / page_size()) * page_size())
+{
+  // the file was opened by the base class constructor
+  _map_file();
+}
+
+/***/
+MmapFileHandler::~MmapFileHandler()
+{
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    close_file();
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH_ALL() {}
+#endif
+}
+
+/***/
+void MmapFileHandler::flush() noexcept
+{
+  _sync_window();
+  FileHandler::flush();
+}
+
+/***/
+void MmapFileHandler::write_to_file(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event)
+{
+  if (QUILL_UNLIKELY(!_window))
+  {
+    // e.g. /dev/null can not be mapped
+    RotatingFileHandler::write_to_file(formatted_log_message, log_event);
+    return;
+  }
+
+  std::string_view const message = apply_before_write(formatted_log_message);
+  _append(message.data(), message.size());
+
+  if (record_write(formatted_log_message.size(), log_event))
+  {
+    flush();
+  }
+}
+
+/***/
+void MmapFileHandler::open_file(fs::path const& filename, std::string const& mode)
+{
+  FileHandler::open_file(filename, mode);
+  _map_file();
+}
+
+/***/
+void MmapFileHandler::close_file()
+{
+  _unmap_file();
+  FileHandler::close_file();
+}
+
+/***/
+void MmapFileHandler::_map_file()
+{
+#if !defined(_WIN32)
+  if (is_null() || !_file)
+  {
+    return;
+  }
+
+  // anything written via the FILE* e.g. by the after_open callback goes first
+  fflush(_file);
+
+  // the FILE* is write only but a shared writable mapping needs a read write descriptor
+  _fd = ::open(_filename.string().data(), O_RDWR | O_CLOEXEC);
+
+  if (_fd == -1)
+  {
+    QUILL_THROW(QuillError{mmap_error("open")});
+  }
+
+  auto const file_size = ::lseek(_fd, 0, SEEK_END);
+
+  if (file_size < 0)
+  {
+    QUILL_THROW(QuillError{mmap_error("lseek")});
+  }
+
+  _allocated_size = static_cast<uint64_t>(file_size);
+  _map_window(static_cast<uint64_t>(file_size));
+#endif
+}
+
+/***/
+void MmapFileHandler::_unmap_file()
+{
+#if !defined(_WIN32)
+  if (!_window)
+  {
+    return;
+  }
+
+  uint64_t const file_size = _window_offset + _window_pos;
+
+  _sync_window();
+  ::munmap(_window, _chunk_size);
+  _window = nullptr;
+
+  // drop the preallocated part that was not written
+  int const res = ::ftruncate(_fd, static_cast<off_t>(file_size));
+  ::close(_fd);
+  _fd = -1;
+
+  if (res != 0)
+  {
+    QUILL_THROW(QuillError{mmap_error("ftruncate")});
+  }
+
+  // anything written by the before_close callback goes after our writes
+  fseek(_file, 0, SEEK_END);
+#endif
+}
+
+/***/
+void MmapFileHandler::_map_window(uint64_t file_offset)
+{
+#if !defined(_WIN32)
+  _window_offset = file_offset - (file_offset % page_size());
+  _window_pos = static_cast<size_t>(file_offset - _window_offset);
+
+  uint64_t const window_end = _window_offset + _chunk_size;
+
+  if (window_end > _allocated_size)
+  {
+    // the file must be extended before the mapping is written, otherwise we get SIGBUS
+    _preallocate(window_end);
+  }
+
+  void* window = ::mmap(nullptr, _chunk_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd,
+                        static_cast<off_t>(_window_offset));
+
+  if (window == MAP_FAILED)
+  {
+    QUILL_THROW(QuillError{mmap_error("mmap")});
+  }
+
+  ::madvise(window, _chunk_size, MADV_SEQUENTIAL);
+  _window = static_cast<char*>(window);
+#else
+  (void)file_offset;
+#endif
+}
+
+/***/
+void MmapFileHandler::_advance_window()
+{
+#if !defined(_WIN32)
+  uint64_t const next_offset = _window_offset + _chunk_size;
+
+  _sync_window();
+  ::munmap(_window, _chunk_size);
+  _window = nullptr;
+
+  _map_window(next_offset);
+#endif
+}
+
+/***/
+void MmapFileHandler::_sync_window() noexcept
+{
+#if !defined(_WIN32)
+  if (!_window || (_config.sync_policy() == MmapFileHandlerConfig::SyncPolicy::None))
+  {
+    return;
+  }
+
+  ::msync(_window, _window_pos,
+          (_config.sync_policy() == MmapFileHandlerConfig::SyncPolicy::Sync) ? MS_SYNC : MS_ASYNC);
+#endif
+}
+
+/***/
+void MmapFileHandler::_preallocate(uint64_t size)
+{
+#if !defined(_WIN32)
+  int res{-1};
+
+  #if defined(__linux__)
+  // reserve real extents so that a full disk fails here instead of with SIGBUS later
+  do
+  {
+    res = ::fallocate(_fd, 0, static_cast<off_t>(_allocated_size),
+                      static_cast<off_t>(size - _allocated_size));
+  } while ((res != 0) && (errno == EINTR));
+
+  if ((res != 0) && (errno != EOPNOTSUPP) && (errno != ENOSYS))
+  {
+    QUILL_THROW(QuillError{mmap_error("fallocate")});
+  }
+  #endif
+
+  if (res != 0)
+  {
+    // fallocate is not supported, extend the file sparsely instead
+    if (::ftruncate(_fd, static_cast<off_t>(size)) != 0)
+    {
+      QUILL_THROW(QuillError{mmap_error("ftruncate")});
+    }
+  }
+
+  _allocated_size = size;
+#else
+  (void)size;
+#endif
+}
+
+/***/
+void MmapFileHandler::_append(char const* data, size_t size)
+{
+  while (size != 0)
+  {
+    size_t const n = (std::min)(size, _chunk_size - _window_pos);
+    std::memcpy(_window + _window_pos, data, n);
+
+    _window_pos += n;
+    data += n;
+    size -= n;
+
+    if (_window_pos == _chunk_size)
+    {
+      _advance_window();
+    }
+  }
+}
+} // namespace quill
@@ -1,12 +1,40 @@
 #include "quill/handlers/RotatingFileHandler.h"
 #include "quill/QuillError.h"                // for QUILL_THROW, QuillError
 #include "quill/detail/misc/Common.h"        // for QUILL_UNLIKELY
+#include "quill/detail/misc/Compression.h"   // for GzipCompressor, gzip_compress_file
 #include "quill/detail/misc/FileUtilities.h" // for append_index_to_filename
 #include "quill/detail/misc/Os.h"            // for rename_file
 #include "quill/handlers/StreamHandler.h"    // for StreamHandler
 
+#if defined(__linux__)
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 namespace
 {
+/**
+ * Releases the blocks preallocated beyond the end of the file
+ */
+void release_preallocation(FILE* file) noexcept
+{
+#if defined(__linux__)
+  fflush(file);
+
+  int const fd = fileno(file);
+  struct stat st;
+
+  if (::fstat(fd, &st) == 0)
+  {
+    // truncating to the current size frees the blocks allocated with FALLOC_FL_KEEP_SIZE
+    [[maybe_unused]] int const res = ::ftruncate(fd, st.st_size);
+  }
+#else
+  (void)file;
+#endif
+}
+
 /***/
 std::pair<std::chrono::hours, std::chrono::minutes> default_rotation_time_daily() noexcept
 {
@@ -215,6 +243,45 @@ void RotatingFileHandlerConfig::set_rotation_naming_scheme(RotationNamingScheme
   _rotation_naming_scheme = value;
 }
 
+/***/
+void RotatingFileHandlerConfig::set_async_rotation(bool value) { _async_rotation = value; }
+
+/***/
+void RotatingFileHandlerConfig::set_compression(Compression value)
+{
+  if ((value != Compression::None) && !detail::is_gzip_supported())
+  {
+    QUILL_THROW(QuillError{"gzip compression requires quill to be built with QUILL_ENABLE_GZIP"});
+  }
+
+  _compression = value;
+}
+
+/***/
+void RotatingFileHandlerConfig::set_preallocate(bool value) { _preallocate = value; }
+
+/***/
+void RotatingFileHandlerConfig::set_compression_frame_size(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"compression_frame_size must be greater than zero"});
+  }
+
+  _compression_frame_size = value;
+}
+
+/***/
+void RotatingFileHandlerConfig::set_compression_frame_interval(std::chrono::milliseconds value)
+{
+  if (value.count() < 0)
+  {
+    QUILL_THROW(QuillError{"compression_frame_interval can not be negative"});
+  }
+
+  _compression_frame_interval = value;
+}
+
 /***/
 RotatingFileHandler::RotatingFileHandler(
   fs::path const& filename, RotatingFileHandlerConfig const& config, FileEventNotifier file_event_notifier,
@@ -246,6 +313,62 @@ RotatingFileHandler::RotatingFileHandler(
   if (!is_null())
   {
     _file_size = detail::file_size(_filename);
+
+    if (_config.compression() == RotatingFileHandlerConfig::Compression::GzipStream)
+    {
+      _compressor = std::make_unique<detail::GzipCompressor>();
+    }
+  }
+
+  bool const rotation_enabled = (_config.rotation_max_file_size() != 0) ||
+    (_config.rotation_frequency() != RotatingFileHandlerConfig::RotationFrequency::Disabled);
+
+  if (rotation_enabled && !is_null())
+  {
+#if !defined(_WIN32)
+    // an open file can not be renamed on windows
+    _async_rotation = _config.async_rotation();
+#endif
+
+    if (_async_rotation || (_config.compression() == RotatingFileHandlerConfig::Compression::Gzip))
+    {
+      _rotation_worker = std::make_unique<detail::BackgroundWorker>("QuillRotation");
+    }
+
+    if (_async_rotation)
+    {
+      _next_filename = detail::append_string_to_filename(_filename, "next");
+      _rotation_worker->enqueue([this]() { _prepare_next_file(); });
+    }
+  }
+}
+
+/***/
+RotatingFileHandler::~RotatingFileHandler()
+{
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _write_frame();
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH_ALL() {}
+#endif
+
+  // complete any pending rotation, the worker may still use the file event notifier
+  _rotation_worker.reset();
+
+  if (FILE* next_file = _next_file.exchange(nullptr))
+  {
+    fclose(next_file);
+    detail::remove_file(_next_filename);
+  }
+
+  if (_file && _config.preallocate())
+  {
+    // the file is closed by the FileHandler destructor
+    release_preallocation(_file);
   }
 }
 
@@ -258,6 +381,21 @@ void RotatingFileHandler::write(fmt_buffer_t const& formatted_log_message, quill
     return;
   }
 
+  if (QUILL_UNLIKELY(!_pending_error.empty()))
+  {
+    std::string error;
+    error.swap(_pending_error);
+    QUILL_THROW(QuillError{std::move(error)});
+  }
+
+  if (_rotation_worker)
+  {
+    if (std::string error = _rotation_worker->take_error(); QUILL_UNLIKELY(!error.empty()))
+    {
+      QUILL_THROW(QuillError{std::move(error)});
+    }
+  }
+
   bool time_rotation = false;
 
   if (_config.rotation_frequency() != RotatingFileHandlerConfig::RotationFrequency::Disabled)
@@ -273,10 +411,89 @@ void RotatingFileHandler::write(fmt_buffer_t const& formatted_log_message, quill
   }
 
   // write to file
-  StreamHandler::write(formatted_log_message, log_event);
+  write_to_file(formatted_log_message, log_event);
   _file_size += formatted_log_message.size();
 }
 
+/***/
+void RotatingFileHandler::flush() noexcept
+{
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _write_frame();
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH(std::exception const& e) { _pending_error = e.what(); }
+  QUILL_CATCH_ALL() { _pending_error = "Caught unhandled exception."; }
+#endif
+
+  FileHandler::flush();
+}
+
+/***/
+void RotatingFileHandler::idle_flush() noexcept
+{
+  (void)_write_frame_if_expired();
+  FileHandler::flush();
+}
+
+/***/
+void RotatingFileHandler::run_loop() noexcept
+{
+  if (_write_frame_if_expired())
+  {
+    FileHandler::flush();
+  }
+}
+
+/***/
+void RotatingFileHandler::write_to_file(fmt_buffer_t const& formatted_log_message,
+                                        quill::TransitEvent const& log_event)
+{
+  if (_config.compression() != RotatingFileHandlerConfig::Compression::GzipStream)
+  {
+    FileHandler::write(formatted_log_message, log_event);
+    return;
+  }
+
+  if (_frame_buffer.empty())
+  {
+    _frame_since = std::chrono::steady_clock::now();
+  }
+
+  _frame_buffer.append(apply_before_write(formatted_log_message));
+
+  if (_frame_buffer.size() >= _config.compression_frame_size())
+  {
+    _write_frame();
+  }
+
+  if (record_write(formatted_log_message.size(), log_event))
+  {
+    flush();
+  }
+}
+
+/***/
+void RotatingFileHandler::open_file(fs::path const& filename, std::string const& mode)
+{
+  FileHandler::open_file(filename, mode);
+  _preallocate_file(_file);
+}
+
+/***/
+void RotatingFileHandler::close_file()
+{
+  if (_file && _config.preallocate())
+  {
+    release_preallocation(_file);
+  }
+
+  FileHandler::close_file();
+}
+
 /***/
 bool RotatingFileHandler::_time_rotation(uint64_t record_timestamp_ns)
 {
@@ -308,6 +525,15 @@ void RotatingFileHandler::_rotate_files(uint64_t record_timestamp_ns)
     return;
   }
 
+  // the rotated file must end with a complete gzip member
+  _write_frame();
+
+  if (_async_rotation)
+  {
+    _rotate_files_async(record_timestamp_ns);
+    return;
+  }
+
   FileHandler::flush();
 
   if (detail::file_size(_filename) <= 0)
@@ -318,6 +544,120 @@ void RotatingFileHandler::_rotate_files(uint64_t record_timestamp_ns)
 
   close_file();
 
+  RotationPlan const plan = _plan_rotation(_filename);
+
+  if (_rotation_worker)
+  {
+    // the backup files are renamed once the worker has finished compressing them
+    _rotation_worker->wait_idle();
+  }
+
+  _execute_rotation_plan(plan);
+
+  if (!plan.compressed_file.empty())
+  {
+    _rotation_worker->enqueue([compressed_file = plan.compressed_file]()
+                              { _compress_file(compressed_file); });
+  }
+
+  // Open file for logging
+  open_file(_filename, "w");
+  _open_file_timestamp = record_timestamp_ns;
+  _file_size = 0;
+}
+
+/***/
+void RotatingFileHandler::_rotate_files_async(uint64_t record_timestamp_ns)
+{
+  if (_file_size == 0)
+  {
+    // nothing was written to the current file
+    return;
+  }
+
+  FILE* next_file = _next_file.exchange(nullptr);
+
+  if (!next_file)
+  {
+    // rotating again before the worker has finished the previous rotation
+    _rotation_worker->wait_idle();
+    next_file = _next_file.exchange(nullptr);
+
+    if (!next_file)
+    {
+      // the worker failed to create the file, the error is reported on the next write
+      return;
+    }
+  }
+
+  StreamHandler::flush();
+
+  // the rotated file keeps a unique temporary name until the worker renames the backup files
+  fs::path const rotated_filename =
+    detail::append_string_to_filename(_filename, "rotating" + std::to_string(++_rotation_count));
+
+  if (!detail::rename_file(_filename, rotated_filename))
+  {
+    _next_file.store(next_file);
+    return;
+  }
+
+  if (!detail::rename_file(_next_filename, _filename))
+  {
+    detail::rename_file(rotated_filename, _filename);
+    _next_file.store(next_file);
+    return;
+  }
+
+  // the backup file names use the timestamp of the rotated file
+  RotationPlan plan = _plan_rotation(rotated_filename);
+
+  FILE* rotated_file = _file;
+  _file = next_file;
+
+  if (StreamHandler::_file_event_notifier.after_open)
+  {
+    StreamHandler::_file_event_notifier.after_open(_filename, _file);
+  }
+
+  _open_file_timestamp = record_timestamp_ns;
+  _file_size = 0;
+
+  _rotation_worker->enqueue(
+    [this, rotated_file, plan = std::move(plan)]()
+    {
+      if (StreamHandler::_file_event_notifier.before_close)
+      {
+        StreamHandler::_file_event_notifier.before_close(_filename, rotated_file);
+      }
+
+      if (_config.preallocate())
+      {
+        release_preallocation(rotated_file);
+      }
+
+      fclose(rotated_file);
+
+      if (StreamHandler::_file_event_notifier.after_close)
+      {
+        StreamHandler::_file_event_notifier.after_close(_filename);
+      }
+
+      _execute_rotation_plan(plan);
+      _prepare_next_file();
+
+      if (!plan.compressed_file.empty())
+      {
+        _compress_file(plan.compressed_file);
+      }
+    });
+}
+
+/***/
+RotatingFileHandler::RotationPlan RotatingFileHandler::_plan_rotation(fs::path const& current_file)
+{
+  RotationPlan plan;
+
   // datetime_suffix will be empty if we are using the default naming scheme
   std::string datetime_suffix;
   if (_config.rotation_naming_scheme() == RotatingFileHandlerConfig::RotationNamingScheme::Date)
@@ -337,7 +677,9 @@ void RotatingFileHandler::_rotate_files(uint64_t record_timestamp_ns)
     fs::path existing_file;
     fs::path renamed_file;
 
-    existing_file = get_filename(it->base_filename, it->index, it->date_time);
+    // the front of the queue is the file we are rotating, which might have a temporary name
+    bool const is_current_file = (std::next(it) == _created_files.rend());
+    existing_file = is_current_file ? current_file : _backup_filename(*it);
 
     // increment the index if needed and rename the file
     uint32_t index_to_use = it->index;
@@ -348,24 +690,32 @@ void RotatingFileHandler::_rotate_files(uint64_t record_timestamp_ns)
       // we are rotating and incrementing the index, or we have another file with the same date_time suffix
       index_to_use += 1;
 
-      renamed_file = get_filename(it->base_filename, index_to_use, datetime_suffix);
-
       it->index = index_to_use;
       it->date_time = datetime_suffix;
 
-      quill::detail::rename_file(existing_file, renamed_file);
+      // the current file is compressed after it is renamed
+      renamed_file = is_current_file ? get_filename(it->base_filename, index_to_use, datetime_suffix)
+                                     : _backup_filename(*it);
+
+      plan.renames.emplace_back(existing_file, renamed_file);
     }
     else if (it->date_time.empty())
     {
       // we are renaming the latest file
       index_to_use = it->index;
 
-      renamed_file = get_filename(it->base_filename, index_to_use, datetime_suffix);
-
       it->index = index_to_use;
       it->date_time = datetime_suffix;
 
-      quill::detail::rename_file(existing_file, renamed_file);
+      renamed_file = is_current_file ? get_filename(it->base_filename, index_to_use, datetime_suffix)
+                                     : _backup_filename(*it);
+
+      plan.renames.emplace_back(existing_file, renamed_file);
+    }
+
+    if (is_current_file && (_config.compression() == RotatingFileHandlerConfig::Compression::Gzip))
+    {
+      plan.compressed_file = renamed_file;
     }
   }
 
@@ -373,19 +723,131 @@ void RotatingFileHandler::_rotate_files(uint64_t record_timestamp_ns)
   if (_created_files.size() > _config.max_backup_files())
   {
     // remove_file that file from the system and also pop it from the queue
-    fs::path const removed_file = get_filename(
-      _created_files.back().base_filename, _created_files.back().index, _created_files.back().date_time);
-    detail::remove_file(removed_file);
+    plan.removed_file = _backup_filename(_created_files.back());
     _created_files.pop_back();
   }
 
   // add the current file back to the list with index 0
   _created_files.emplace_front(_filename, 0, std::string{});
 
-  // Open file for logging
-  open_file(_filename, "w");
-  _open_file_timestamp = record_timestamp_ns;
-  _file_size = 0;
+  return plan;
+}
+
+/***/
+void RotatingFileHandler::_prepare_next_file()
+{
+  if (StreamHandler::_file_event_notifier.before_open)
+  {
+    StreamHandler::_file_event_notifier.before_open(_filename);
+  }
+
+  FILE* next_file = detail::open_file(_next_filename, "w");
+  _preallocate_file(next_file);
+  _next_file.store(next_file);
+}
+
+/***/
+void RotatingFileHandler::_preallocate_file(FILE* file) const noexcept
+{
+#if defined(__linux__)
+  if (!file || !_config.preallocate() || (_config.rotation_max_file_size() == 0) || is_null())
+  {
+    return;
+  }
+
+  // best effort, e.g. not every filesystem supports fallocate
+  [[maybe_unused]] int const res = ::fallocate(fileno(file), FALLOC_FL_KEEP_SIZE, 0,
+                                               static_cast<off_t>(_config.rotation_max_file_size()));
+#else
+  (void)file;
+#endif
+}
+
+/***/
+void RotatingFileHandler::_write_frame()
+{
+  if (_frame_buffer.empty())
+  {
+    return;
+  }
+
+  _compressed_frame.clear();
+  _compressor->compress(_frame_buffer.data(), _frame_buffer.size(), _compressed_frame);
+  _frame_buffer.clear();
+
+  detail::fwrite_fully(_compressed_frame.data(), sizeof(char), _compressed_frame.size(), _file);
+}
+
+/***/
+bool RotatingFileHandler::_write_frame_if_expired() noexcept
+{
+  if (_frame_buffer.empty() ||
+      (std::chrono::steady_clock::now() - _frame_since < _config.compression_frame_interval()))
+  {
+    return false;
+  }
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+  QUILL_TRY
+  {
+#endif
+    _write_frame();
+#if !defined(QUILL_NO_EXCEPTIONS)
+  }
+  QUILL_CATCH(std::exception const& e) { _pending_error = e.what(); }
+  QUILL_CATCH_ALL() { _pending_error = "Caught unhandled exception."; }
+#endif
+
+  return true;
+}
+
+/***/
+fs::path RotatingFileHandler::_backup_filename(FileInfo const& file_info) const
+{
+  fs::path filename = get_filename(file_info.base_filename, file_info.index, file_info.date_time);
+
+  if (_config.compression() == RotatingFileHandlerConfig::Compression::Gzip)
+  {
+    filename += ".gz";
+  }
+
+  return filename;
+}
+
+/***/
+fs::path RotatingFileHandler::_strip_compression_extension(fs::path const& filename) const
+{
+  if ((_config.compression() == RotatingFileHandlerConfig::Compression::Gzip) &&
+      (filename.extension() == ".gz"))
+  {
+    return filename.parent_path() / filename.stem();
+  }
+
+  return filename;
+}
+
+/***/
+void RotatingFileHandler::_compress_file(fs::path const& filename)
+{
+  fs::path compressed_filename = filename;
+  compressed_filename += ".gz";
+
+  detail::gzip_compress_file(filename, compressed_filename);
+  detail::remove_file(filename);
+}
+
+/***/
+void RotatingFileHandler::_execute_rotation_plan(RotationPlan const& plan)
+{
+  for (auto const& [existing_file, renamed_file] : plan.renames)
+  {
+    quill::detail::rename_file(existing_file, renamed_file);
+  }
+
+  if (!plan.removed_file.empty())
+  {
+    detail::remove_file(plan.removed_file);
+  }
 }
 
 /***/
@@ -405,14 +867,17 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
   {
     for (const auto& entry : fs::directory_iterator(fs::current_path() / filename.parent_path()))
     {
-      if (entry.path().extension().string() != filename.extension().string())
+      // compressed backup files are matched by their uncompressed name
+      fs::path const entry_path = _strip_compression_extension(entry.path());
+
+      if (entry_path.extension().string() != filename.extension().string())
       {
         // we only check for the files of the same extension to remove
         continue;
       }
 
       // is_directory() does not exist in std::experimental::filesystem
-      if (entry.path().filename().string().find(filename.stem().string() + ".") != 0)
+      if (entry_path.filename().string().find(filename.stem().string() + ".") != 0)
       {
         // expect to find filename.stem().string() exactly at the start of the filename
         continue;
@@ -426,7 +891,7 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
       {
         // Find the first dot in the filename
         // stem will be something like `logfile.1`
-        size_t pos = entry.path().stem().string().find_last_of('.');
+        size_t pos = entry_path.stem().string().find_last_of('.');
         if (pos != std::string::npos)
         {
           // Get the today's date, we won't remove the files of the previous dates as they won't collide
@@ -434,7 +899,7 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
             quill::detail::get_datetime_string(today_timestamp_ns, _config.timezone(), false);
 
           std::string const index_or_date =
-            entry.path().stem().string().substr(pos + 1, entry.path().stem().string().length());
+            entry_path.stem().string().substr(pos + 1, entry_path.stem().string().length());
 
           if ((index_or_date.length() >= 8) && (index_or_date == today_date))
           {
@@ -448,7 +913,7 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
           {
             // assume it is an index
             // Find the second last dot to get the date
-            std::string const filename_with_date = entry.path().filename().string().substr(0, pos);
+            std::string const filename_with_date = entry_path.filename().string().substr(0, pos);
             size_t second_last = filename_with_date.find_last_of('.');
 
             if (second_last != std::string::npos)
@@ -471,33 +936,36 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
     // we need to recover the index from the existing files
     for (const auto& entry : fs::directory_iterator(fs::current_path() / filename.parent_path()))
     {
+      // compressed backup files are matched by their uncompressed name
+      fs::path const entry_path = _strip_compression_extension(entry.path());
+
       // is_directory() does not exist in std::experimental::filesystem
-      if (entry.path().extension().string() != filename.extension().string())
+      if (entry_path.extension().string() != filename.extension().string())
       {
         // we only check for the files of the same extension to remove
         continue;
       }
 
       // is_directory() does not exist in std::experimental::filesystem
-      if (entry.path().filename().string().find(filename.stem().string() + ".") != 0)
+      if (entry_path.filename().string().find(filename.stem().string() + ".") != 0)
       {
         // expect to find filename.stem().string() exactly at the start of the filename
         continue;
       }
 
-      std::string const extension = entry.path().extension().string(); // e.g. ".log"
+      std::string const extension = entry_path.extension().string(); // e.g. ".log"
 
       // stem will be something like `logfile.1`
-      size_t pos = entry.path().stem().string().find_last_of('.');
+      size_t pos = entry_path.stem().string().find_last_of('.');
       if (pos != std::string::npos)
       {
         if (_config.rotation_naming_scheme() == RotatingFileHandlerConfig::RotationNamingScheme::Index)
         {
           std::string const index =
-            entry.path().stem().string().substr(pos + 1, entry.path().stem().string().length());
+            entry_path.stem().string().substr(pos + 1, entry_path.stem().string().length());
 
-          std::string const current_filename = entry.path().filename().string().substr(0, pos) + extension;
-          fs::path current_file = entry.path().parent_path();
+          std::string const current_filename = entry_path.filename().string().substr(0, pos) + extension;
+          fs::path current_file = entry_path.parent_path();
           current_file.append(current_filename);
 
           // Attempt to convert the index to a number
@@ -514,13 +982,13 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
             quill::detail::get_datetime_string(today_timestamp_ns, _config.timezone(), false);
 
           std::string const index_or_date =
-            entry.path().stem().string().substr(pos + 1, entry.path().stem().string().length());
+            entry_path.stem().string().substr(pos + 1, entry_path.stem().string().length());
 
           if ((index_or_date.length() >= 8) && (index_or_date == today_date))
           {
             // assume it is a date, no need to find the index
-            std::string const current_filename = entry.path().filename().string().substr(0, pos) + extension;
-            fs::path current_file = entry.path().parent_path();
+            std::string const current_filename = entry_path.filename().string().substr(0, pos) + extension;
+            fs::path current_file = entry_path.parent_path();
             current_file.append(current_filename);
 
             _created_files.emplace_front(current_file, 0, index_or_date);
@@ -529,7 +997,7 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
           {
             // assume it is an index
             // Find the second last dot to get the date
-            std::string const filename_with_date = entry.path().filename().string().substr(0, pos);
+            std::string const filename_with_date = entry_path.filename().string().substr(0, pos);
             size_t second_last = filename_with_date.find_last_of('.');
 
             if (second_last != std::string::npos)
@@ -540,7 +1008,7 @@ void RotatingFileHandler::_clean_and_recover_files(fs::path const& filename, std
               if (date_part == today_date)
               {
                 std::string const current_filename = filename_with_date.substr(0, second_last) + extension;
-                fs::path current_file = entry.path().parent_path();
+                fs::path current_file = entry_path.parent_path();
                 current_file.append(current_filename);
 
                 // Attempt to convert the index to a number
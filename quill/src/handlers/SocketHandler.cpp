@@ -0,0 +1,510 @@
+#include "quill/handlers/SocketHandler.h"
+#include "quill/QuillError.h"         // for QUILL_THROW, QuillError
+#include "quill/detail/misc/Common.h" // for QUILL_UNLIKELY
+#include <algorithm>                  // for min, lower_bound, upper_bound
+#include <cerrno>                     // for errno
+#include <cstddef>                    // for offsetof, ptrdiff_t
+#include <cstring>                    // for memcpy, memmove
+
+#if !defined(_WIN32)
+  #include <arpa/inet.h>
+  #include <fcntl.h>
+  #include <netinet/in.h>
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+/** maximum number of datagrams sent with a single sendmmsg */
+constexpr size_t max_batch_frames{32u};
+
+/** interval between connection attempts */
+constexpr std::chrono::seconds reconnect_interval{1};
+
+#if !defined(_WIN32)
+  #if defined(MSG_NOSIGNAL)
+constexpr int send_flags{MSG_NOSIGNAL | MSG_DONTWAIT};
+  #else
+constexpr int send_flags{MSG_DONTWAIT};
+  #endif
+
+/***/
+QUILL_NODISCARD bool is_would_block(int error) noexcept
+{
+  return (error == EAGAIN) || (error == EWOULDBLOCK) || (error == ENOBUFS);
+}
+#endif
+} // namespace
+
+namespace quill
+{
+/***/
+void SocketHandlerConfig::set_socket_type(SocketType value) { _socket_type = value; }
+
+/***/
+void SocketHandlerConfig::set_address(std::string value) { _address = std::move(value); }
+
+/***/
+void SocketHandlerConfig::set_port(uint16_t value) { _port = value; }
+
+/***/
+void SocketHandlerConfig::set_max_frame_size(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"max_frame_size must be greater than zero"});
+  }
+
+  _max_frame_size = value;
+}
+
+/***/
+void SocketHandlerConfig::set_buffer_size(size_t value)
+{
+  if (value == 0)
+  {
+    QUILL_THROW(QuillError{"buffer_size must be greater than zero"});
+  }
+
+  _buffer_size = value;
+}
+
+/***/
+void SocketHandlerConfig::set_overflow_policy(OverflowPolicy value) { _overflow_policy = value; }
+
+/***/
+void SocketHandlerConfig::set_pattern(std::string const& log_pattern,
+                                      std::string const& time_format /* = std::string{"%H:%M:%S.%Qns"} */)
+{
+  _log_pattern = log_pattern;
+  _time_format = time_format;
+}
+
+/***/
+SocketHandler::SocketHandler(SocketHandlerConfig const& config) : _config(config)
+{
+#if defined(_WIN32)
+  QUILL_THROW(QuillError{"SocketHandler is not supported on windows"});
+#else
+  if (_config.socket_type() != SocketHandlerConfig::SocketType::Udp)
+  {
+    if (_config.address().size() >= sizeof(sockaddr_un::sun_path))
+    {
+      QUILL_THROW(QuillError{"socket path is too long: " + _config.address()});
+    }
+  }
+  else
+  {
+    in_addr addr{};
+    if (::inet_pton(AF_INET, _config.address().data(), &addr) != 1)
+    {
+      QUILL_THROW(QuillError{"invalid IPv4 address: " + _config.address()});
+    }
+  }
+#endif
+
+  if (!_config.log_pattern().empty())
+  {
+    set_pattern(_config.log_pattern(), _config.time_format());
+  }
+
+  _buffer.reserve((std::min)(_config.buffer_size(), 2 * _config.max_frame_size()));
+
+  _connect();
+}
+
+/***/
+SocketHandler::~SocketHandler()
+{
+  _close_frame();
+  _send_pending(_config.overflow_policy() == SocketHandlerConfig::OverflowPolicy::Block);
+  _disconnect();
+}
+
+/***/
+void SocketHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const&)
+{
+  size_t const size = formatted_log_message.size();
+  bool const is_stream = _config.socket_type() == SocketHandlerConfig::SocketType::UnixStream;
+
+  if (QUILL_UNLIKELY(!is_stream && (size > _config.max_frame_size())))
+  {
+    // can never fit in a datagram
+    ++_dropped_messages;
+    return;
+  }
+
+  if (QUILL_UNLIKELY(_buffer.size() + size > _config.buffer_size()))
+  {
+    // make room by sending what we have
+    _close_frame();
+    _send_pending(_config.overflow_policy() == SocketHandlerConfig::OverflowPolicy::Block);
+    _compact(true);
+
+    if (_buffer.size() + size > _config.buffer_size())
+    {
+      ++_dropped_messages;
+      return;
+    }
+  }
+
+  size_t const open_frame_size = _buffer.size() - _frame_start(_frame_ends.size());
+
+  if (!is_stream && (open_frame_size + size > _config.max_frame_size()))
+  {
+    // a log message is never split across datagrams
+    _close_frame();
+  }
+
+  _buffer.append(formatted_log_message.data(), size);
+
+  if (is_stream)
+  {
+    _message_ends.push_back(_buffer.size());
+  }
+
+  if (_buffer.size() - _frame_start(_frame_ends.size()) >= _config.max_frame_size())
+  {
+    _close_frame();
+  }
+
+  // a full stream frame is sent right away, datagrams are sent in batches
+  size_t const pending_frames = _frame_ends.size() - _sent_frames;
+
+  if ((is_stream && (pending_frames != 0)) || (pending_frames >= max_batch_frames))
+  {
+    _send_pending(false);
+  }
+}
+
+/***/
+void SocketHandler::flush() noexcept
+{
+  _close_frame();
+  _send_pending(false);
+}
+
+/***/
+void SocketHandler::_connect() noexcept
+{
+#if !defined(_WIN32)
+  _next_connect_time = std::chrono::steady_clock::now() + reconnect_interval;
+
+  sockaddr_storage storage{};
+  socklen_t addr_len{0};
+  int domain{AF_UNIX};
+  int type{SOCK_DGRAM};
+
+  if (_config.socket_type() == SocketHandlerConfig::SocketType::Udp)
+  {
+    auto* addr = reinterpret_cast<sockaddr_in*>(&storage);
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(_config.port());
+    ::inet_pton(AF_INET, _config.address().data(), &addr->sin_addr);
+    addr_len = sizeof(sockaddr_in);
+    domain = AF_INET;
+  }
+  else
+  {
+    auto* addr = reinterpret_cast<sockaddr_un*>(&storage);
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, _config.address().data(), _config.address().size());
+    addr_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + _config.address().size() + 1);
+
+    if (_config.socket_type() == SocketHandlerConfig::SocketType::UnixStream)
+    {
+      type = SOCK_STREAM;
+    }
+  }
+
+  int const fd = ::socket(domain, type, 0);
+
+  if (fd == -1)
+  {
+    return;
+  }
+
+  ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+  #if defined(SO_NOSIGPIPE)
+  int const one{1};
+  ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+  #endif
+
+  // the socket is non-blocking before connecting, a unix stream connect fails with EAGAIN instead
+  // of blocking the backend thread when the backlog of the collector is full
+  ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  int res;
+  do
+  {
+    res = ::connect(fd, reinterpret_cast<sockaddr const*>(&storage), addr_len);
+  } while ((res != 0) && (errno == EINTR));
+
+  if (res != 0)
+  {
+    // EINPROGRESS, EAGAIN or the collector is not there, retried after the reconnect interval
+    ::close(fd);
+    return;
+  }
+
+  _fd = fd;
+
+  if (_frame_sent_bytes != 0)
+  {
+    // the log message that was cut by the previous connection can not be completed, the
+    // rest of it is dropped and sending resumes at the next log message
+    size_t const sent_end = _frame_start(_sent_frames) + _frame_sent_bytes;
+    size_t const resume_at = *std::lower_bound(_message_ends.begin(), _message_ends.end(), sent_end);
+
+    if (resume_at != sent_end)
+    {
+      ++_dropped_messages;
+    }
+
+    while ((_sent_frames != _frame_ends.size()) && (_frame_ends[_sent_frames] <= resume_at))
+    {
+      ++_sent_frames;
+    }
+
+    _frame_sent_bytes = resume_at - _frame_start(_sent_frames);
+  }
+#endif
+}
+
+/***/
+void SocketHandler::_disconnect() noexcept
+{
+#if !defined(_WIN32)
+  if (_fd != -1)
+  {
+    ::close(_fd);
+    _fd = -1;
+  }
+#endif
+}
+
+/***/
+void SocketHandler::_close_frame() noexcept
+{
+  if (_buffer.size() != _frame_start(_frame_ends.size()))
+  {
+    _frame_ends.push_back(_buffer.size());
+  }
+}
+
+/***/
+void SocketHandler::_send_pending(bool block) noexcept
+{
+  while (_sent_frames != _frame_ends.size())
+  {
+    if (_fd == -1)
+    {
+      if (std::chrono::steady_clock::now() < _next_connect_time)
+      {
+        break;
+      }
+
+      _connect();
+
+      if (_fd == -1)
+      {
+        break;
+      }
+    }
+
+    if (_send_frames())
+    {
+      continue;
+    }
+
+    if (!block || (_fd == -1) || !_wait_writable())
+    {
+      break;
+    }
+  }
+
+  _compact();
+}
+
+/***/
+bool SocketHandler::_send_frames() noexcept
+{
+#if !defined(_WIN32)
+  if (_config.socket_type() == SocketHandlerConfig::SocketType::UnixStream)
+  {
+    // all the pending frames are contiguous, a single send covers them
+    size_t const start = _frame_start(_sent_frames) + _frame_sent_bytes;
+    size_t const end = _frame_ends.back();
+
+    ssize_t const sent = ::send(_fd, _buffer.data() + start, end - start, send_flags);
+
+    if (sent < 0)
+    {
+      int const error = errno;
+
+      if ((error != EINTR) && !is_would_block(error))
+      {
+        // the connection is lost, the buffered frames are sent after reconnecting
+        _disconnect();
+      }
+      return error == EINTR;
+    }
+
+    size_t const sent_end = start + static_cast<size_t>(sent);
+
+    while ((_sent_frames != _frame_ends.size()) && (_frame_ends[_sent_frames] <= sent_end))
+    {
+      ++_sent_frames;
+    }
+
+    _frame_sent_bytes = sent_end - _frame_start(_sent_frames);
+    return true;
+  }
+
+  size_t sent_frames{0};
+  int error{0};
+
+  #if defined(__linux__)
+  mmsghdr messages[max_batch_frames];
+  iovec iovs[max_batch_frames];
+
+  size_t const count = (std::min)(_frame_ends.size() - _sent_frames, max_batch_frames);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t const start = _frame_start(_sent_frames + i);
+    iovs[i].iov_base = _buffer.data() + start;
+    iovs[i].iov_len = _frame_ends[_sent_frames + i] - start;
+
+    messages[i] = mmsghdr{};
+    messages[i].msg_hdr.msg_iov = &iovs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int const res = ::sendmmsg(_fd, messages, static_cast<unsigned int>(count), send_flags);
+
+  if (res > 0)
+  {
+    sent_frames = static_cast<size_t>(res);
+  }
+  else
+  {
+    error = errno;
+  }
+  #else
+  size_t const start = _frame_start(_sent_frames);
+  ssize_t const res = ::send(_fd, _buffer.data() + start, _frame_ends[_sent_frames] - start, send_flags);
+
+  if (res >= 0)
+  {
+    sent_frames = 1;
+  }
+  else
+  {
+    error = errno;
+  }
+  #endif
+
+  if (sent_frames != 0)
+  {
+    _sent_frames += sent_frames;
+    return true;
+  }
+
+  if (error == EINTR)
+  {
+    return true;
+  }
+
+  if (is_would_block(error))
+  {
+    return false;
+  }
+
+  if ((error == EMSGSIZE) ||
+      ((error == ECONNREFUSED) && (_config.socket_type() == SocketHandlerConfig::SocketType::Udp)))
+  {
+    // the datagram can never be sent or the error belongs to an earlier datagram without a
+    // receiver, skip the frame and continue
+    ++_sent_frames;
+    return true;
+  }
+
+  // e.g. the receiver of the unix datagram socket was closed
+  _disconnect();
+  return false;
+#else
+  return false;
+#endif
+}
+
+/***/
+bool SocketHandler::_wait_writable() noexcept
+{
+#if !defined(_WIN32)
+  pollfd pfd{};
+  pfd.fd = _fd;
+  pfd.events = POLLOUT;
+
+  int res;
+  do
+  {
+    res = ::poll(&pfd, 1, -1);
+  } while ((res < 0) && (errno == EINTR));
+
+  return (res > 0) && ((pfd.revents & POLLOUT) != 0);
+#else
+  return false;
+#endif
+}
+
+/***/
+void SocketHandler::_compact(bool force) noexcept
+{
+  // the sent frames stay at the front of the buffer and are skipped by offset
+  size_t const sent_bytes = _frame_start(_sent_frames);
+
+  if (sent_bytes == 0)
+  {
+    return;
+  }
+
+  if (sent_bytes == _buffer.size())
+  {
+    // everything was sent, nothing to move
+    _buffer.clear();
+    _frame_ends.clear();
+    _message_ends.clear();
+    _sent_frames = 0;
+    return;
+  }
+
+  if (!force && (sent_bytes * 2 < _buffer.size()))
+  {
+    // move the unsent bytes only once the sent ones are at least half of the buffer
+    return;
+  }
+
+  _buffer.erase(0, sent_bytes);
+  _frame_ends.erase(_frame_ends.begin(), _frame_ends.begin() + static_cast<std::ptrdiff_t>(_sent_frames));
+
+  for (size_t& frame_end : _frame_ends)
+  {
+    frame_end -= sent_bytes;
+  }
+
+  auto const sent_messages = std::upper_bound(_message_ends.begin(), _message_ends.end(), sent_bytes);
+  _message_ends.erase(_message_ends.begin(), sent_messages);
+
+  for (size_t& message_end : _message_ends)
+  {
+    message_end -= sent_bytes;
+  }
+
+  _sent_frames = 0;
+}
+} // namespace quill
@@ -71,17 +71,28 @@ StreamHandler::StreamHandler(fs::path stream, FILE* file /* = nullptr */,
 /***/
 void StreamHandler::write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event)
 {
-  if (_file_event_notifier.before_write)
-  {
-    std::string const modified_message = _file_event_notifier.before_write(
-      std::string_view{formatted_log_message.data(), formatted_log_message.size()});
+  std::string_view const message = apply_before_write(formatted_log_message);
+  detail::fwrite_fully(message.data(), sizeof(char), message.size(), _file);
+}
+
+/***/
+std::string_view StreamHandler::apply_before_write(fmt_buffer_t const& formatted_log_message)
+{
+  std::string_view const message{formatted_log_message.data(), formatted_log_message.size()};
 
-    detail::fwrite_fully(modified_message.data(), sizeof(char), modified_message.size(), _file);
+  if (_file_event_notifier.before_write_view)
+  {
+    _before_write_buffer.clear();
+    return _file_event_notifier.before_write_view(message, _before_write_buffer);
   }
-  else
+
+  if (_file_event_notifier.before_write)
   {
-    detail::fwrite_fully(formatted_log_message.data(), sizeof(char), formatted_log_message.size(), _file);
+    _before_write_message = _file_event_notifier.before_write(message);
+    return _before_write_message;
   }
+
+  return message;
 }
 
 /***/
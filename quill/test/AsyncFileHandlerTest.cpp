@@ -0,0 +1,177 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/QuillError.h"
+#include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/FileUtilities.h"
+#include "quill/handlers/AsyncFileHandler.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+TEST_SUITE_BEGIN("AsyncFileHandler");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+void test_write_in_order(fs::path const& filename, bool use_io_uring)
+{
+  {
+    AsyncFileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_write_buffer_size(4096);
+    cfg.set_max_in_flight(3);
+    cfg.set_use_io_uring(use_io_uring);
+
+    auto afh = AsyncFileHandler{filename, cfg, FileEventNotifier{}};
+
+    if (!use_io_uring)
+    {
+      REQUIRE_FALSE(afh.is_io_uring());
+    }
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      std::string s{"Record [" + std::to_string(i) + "]"};
+
+      if (i == 1000)
+      {
+        // a message bigger than a write buffer
+        s.append(10000, 'x');
+      }
+
+      s.append("\n");
+
+      fmt_buffer_t formatted_log_message;
+      formatted_log_message.append(s.data(), s.data() + s.size());
+      afh.write(formatted_log_message, quill::TransitEvent{});
+    }
+
+    afh.flush();
+
+    std::vector<std::string> const file_contents = testing::file_contents(filename);
+    REQUIRE_EQ(file_contents.size(), 2000);
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      std::string expected{"Record [" + std::to_string(i) + "]"};
+
+      if (i == 1000)
+      {
+        expected.append(10000, 'x');
+      }
+
+      REQUIRE_EQ(file_contents[i], expected);
+    }
+
+    // write one more record that is only written on destruction
+    std::string const s{"Last record\n"};
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    afh.write(formatted_log_message, quill::TransitEvent{});
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 2001);
+  REQUIRE_EQ(file_contents.back(), std::string{"Last record"});
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("write_in_order_io_uring")
+{
+  // falls back to the writer thread when io_uring is not available
+  test_write_in_order("write_in_order_io_uring.log", true);
+}
+
+/***/
+TEST_CASE("write_in_order_writer_thread")
+{
+  test_write_in_order("write_in_order_writer_thread.log", false);
+}
+
+/***/
+TEST_CASE("append_to_existing_file")
+{
+  fs::path const filename = "async_append_to_existing_file.log";
+
+  {
+    FILE* f = fopen(filename.string().data(), "w");
+    fputs("Existing record\n", f);
+    fclose(f);
+  }
+
+  {
+    FileEventNotifier file_event_notifier;
+    file_event_notifier.after_open = [](fs::path const&, FILE* f) { fputs("Header\n", f); };
+    file_event_notifier.before_close = [](fs::path const&, FILE* f) { fputs("Footer\n", f); };
+
+    auto afh = AsyncFileHandler{filename, AsyncFileHandlerConfig{}, std::move(file_event_notifier)};
+
+    std::string const s{"New record\n"};
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    afh.write(formatted_log_message, quill::TransitEvent{});
+    afh.flush();
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 4);
+  REQUIRE_EQ(file_contents[0], std::string{"Existing record"});
+  REQUIRE_EQ(file_contents[1], std::string{"Header"});
+  REQUIRE_EQ(file_contents[2], std::string{"New record"});
+  REQUIRE_EQ(file_contents[3], std::string{"Footer"});
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("idle_flush_submits_after_interval")
+{
+  fs::path const filename = "async_idle_flush_submits_after_interval.log";
+
+  {
+    AsyncFileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_use_io_uring(false);
+    cfg.set_idle_submit_interval(std::chrono::milliseconds{50});
+
+    auto afh = AsyncFileHandler{filename, cfg, FileEventNotifier{}};
+
+    std::string const s{"Idle record\n"};
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    afh.write(formatted_log_message, quill::TransitEvent{});
+
+    // the partial buffer is younger than the interval and is kept
+    afh.idle_flush();
+    afh.run_loop();
+    REQUIRE(testing::file_contents(filename).empty());
+
+    // once the interval passes the buffer is submitted and reaped from the run loop
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    std::vector<std::string> file_contents;
+    while (file_contents.empty() && (std::chrono::steady_clock::now() < deadline))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{5});
+      afh.run_loop();
+      file_contents = testing::file_contents(filename);
+    }
+
+    REQUIRE_EQ(file_contents.size(), 1);
+    REQUIRE_EQ(file_contents[0], std::string{"Idle record"});
+  }
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("invalid_idle_submit_interval")
+{
+  AsyncFileHandlerConfig cfg;
+  REQUIRE_THROWS_AS(cfg.set_idle_submit_interval(std::chrono::milliseconds{-1}), quill::QuillError);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,221 @@
+#include "doctest/doctest.h"
+
+#include "quill/QuillError.h"
+#include "quill/detail/LoggerDetails.h"
+#include "quill/handlers/AsyncHandler.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("AsyncHandler");
+
+using namespace quill;
+
+namespace
+{
+/**
+ * Keeps the written log messages, optionally slowly
+ */
+class RecordingHandler : public Handler
+{
+public:
+  void write(fmt_buffer_t const& formatted_log_message, quill::TransitEvent const& log_event) override
+  {
+    if (write_delay.count() != 0)
+    {
+      std::this_thread::sleep_for(write_delay);
+    }
+
+    if (throw_on_write)
+    {
+      QUILL_THROW(QuillError{"write failed"});
+    }
+
+    std::lock_guard<std::mutex> const lock{mutex};
+    messages.emplace_back(formatted_log_message.data(), formatted_log_message.size());
+    thread_ids.emplace_back(log_event.thread_id);
+    thread_names.emplace_back(log_event.thread_name);
+    logger_names.emplace_back(log_event.header.logger_details->name());
+    log_levels.push_back(log_event.log_level());
+  }
+
+  void flush() noexcept override
+  {
+    std::lock_guard<std::mutex> const lock{mutex};
+    flushed_messages = messages.size();
+  }
+
+  std::chrono::milliseconds write_delay{0};
+  bool throw_on_write{false};
+
+  std::mutex mutex;
+  std::vector<std::string> messages;
+  std::vector<std::string> thread_ids;
+  std::vector<std::string> thread_names;
+  std::vector<std::string> logger_names;
+  std::vector<LogLevel> log_levels;
+  size_t flushed_messages{0};
+};
+
+/***/
+detail::LoggerDetails const test_logger_details{"test_logger", std::vector<std::shared_ptr<Handler>>{},
+                                                TimestampClockType::System};
+
+/***/
+void write_message(AsyncHandler& handler, std::string const& message, LogLevel log_level = LogLevel::Info,
+                   detail::LoggerDetails const* logger_details = &test_logger_details)
+{
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(message.data(), message.data() + message.size());
+
+  TransitEvent transit_event;
+  transit_event.header.logger_details = logger_details;
+  transit_event.thread_id = "123";
+  transit_event.thread_name = "worker";
+  transit_event.log_level_override = log_level;
+
+  handler.write(formatted_log_message, transit_event);
+}
+} // namespace
+
+/***/
+TEST_CASE("async_handler_writes_in_order")
+{
+  auto recording_handler = std::make_shared<RecordingHandler>();
+
+  {
+    AsyncHandler handler{recording_handler, 64 * 1024, AsyncHandler::OverflowPolicy::Block};
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      write_message(handler, "Message " + std::to_string(i) + "\n", (i % 2) ? LogLevel::Error : LogLevel::Info);
+    }
+
+    // flush waits for the writer thread
+    handler.flush();
+
+    std::lock_guard<std::mutex> const lock{recording_handler->mutex};
+    REQUIRE_EQ(recording_handler->messages.size(), 10000);
+    REQUIRE_EQ(recording_handler->flushed_messages, 10000);
+
+    for (size_t i = 0; i < 10000; ++i)
+    {
+      REQUIRE_EQ(recording_handler->messages[i], "Message " + std::to_string(i) + "\n");
+      REQUIRE_EQ(recording_handler->log_levels[i], (i % 2) ? LogLevel::Error : LogLevel::Info);
+    }
+
+    REQUIRE_EQ(recording_handler->thread_ids.back(), std::string{"123"});
+    REQUIRE_EQ(recording_handler->thread_names.back(), std::string{"worker"});
+    REQUIRE_EQ(recording_handler->logger_names.back(), std::string{"test_logger"});
+    REQUIRE_EQ(handler.dropped_messages(), 0);
+  }
+}
+
+/***/
+TEST_CASE("async_handler_drops_when_full")
+{
+  auto recording_handler = std::make_shared<RecordingHandler>();
+  recording_handler->write_delay = std::chrono::milliseconds{5};
+
+  AsyncHandler handler{recording_handler, 1024, AsyncHandler::OverflowPolicy::Drop};
+
+  auto const start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < 200; ++i)
+  {
+    write_message(handler, std::string(100, 'a') + "\n");
+  }
+
+  // the slow handler does not hold up the caller
+  REQUIRE_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds{500});
+
+  // a log message bigger than the ring is always dropped
+  write_message(handler, std::string(2000, 'b') + "\n");
+
+  handler.flush();
+
+  std::lock_guard<std::mutex> const lock{recording_handler->mutex};
+  REQUIRE_GT(handler.dropped_messages(), 0);
+  REQUIRE_EQ(recording_handler->messages.size() + handler.dropped_messages(), 201);
+}
+
+/***/
+TEST_CASE("async_handler_blocks_when_full")
+{
+  auto recording_handler = std::make_shared<RecordingHandler>();
+  recording_handler->write_delay = std::chrono::milliseconds{1};
+
+  AsyncHandler handler{recording_handler, 1024, AsyncHandler::OverflowPolicy::Block};
+
+  for (size_t i = 0; i < 50; ++i)
+  {
+    write_message(handler, std::string(100, 'a') + "\n");
+  }
+
+  handler.flush();
+
+  std::lock_guard<std::mutex> const lock{recording_handler->mutex};
+  REQUIRE_EQ(recording_handler->messages.size(), 50);
+  REQUIRE_GT(handler.blocked_messages(), 0);
+  REQUIRE_EQ(handler.dropped_messages(), 0);
+}
+
+/***/
+TEST_CASE("async_handler_reports_errors")
+{
+  auto recording_handler = std::make_shared<RecordingHandler>();
+  recording_handler->throw_on_write = true;
+
+  AsyncHandler handler{recording_handler, 4096, AsyncHandler::OverflowPolicy::Block};
+
+  write_message(handler, "Message\n");
+  handler.flush();
+
+  // the error of the writer thread is reported on the next write
+  REQUIRE_THROWS_AS(write_message(handler, "Message\n"), QuillError);
+
+  recording_handler->throw_on_write = false;
+  handler.flush();
+  write_message(handler, "Message\n");
+  handler.flush();
+}
+
+/***/
+TEST_CASE("async_handler_outlives_the_logger")
+{
+  auto recording_handler = std::make_shared<RecordingHandler>();
+  recording_handler->write_delay = std::chrono::milliseconds{1};
+
+  AsyncHandler handler{recording_handler, 64 * 1024, AsyncHandler::OverflowPolicy::Block};
+
+  for (size_t i = 0; i < 20; ++i)
+  {
+    // the logger is removed while its log messages are still in the ring
+    auto logger_details = std::make_unique<detail::LoggerDetails>(
+      "logger_" + std::to_string(i % 3), std::vector<std::shared_ptr<Handler>>{}, TimestampClockType::System);
+
+    write_message(handler, "Message " + std::to_string(i) + "\n", LogLevel::Info, logger_details.get());
+  }
+
+  handler.flush();
+
+  std::lock_guard<std::mutex> const lock{recording_handler->mutex};
+  REQUIRE_EQ(recording_handler->logger_names.size(), 20);
+
+  for (size_t i = 0; i < 20; ++i)
+  {
+    REQUIRE_EQ(recording_handler->logger_names[i], "logger_" + std::to_string(i % 3));
+  }
+}
+
+/***/
+TEST_CASE("async_handler_invalid_config")
+{
+  REQUIRE_THROWS_AS(AsyncHandler(std::make_shared<RecordingHandler>(), 100, AsyncHandler::OverflowPolicy::Drop), QuillError);
+  REQUIRE_THROWS_AS(AsyncHandler(nullptr, 4096, AsyncHandler::OverflowPolicy::Drop), QuillError);
+}
+
+TEST_SUITE_END();
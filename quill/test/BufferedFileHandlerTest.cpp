@@ -0,0 +1,218 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/FileUtilities.h"
+#include "quill/QuillError.h"
+#include "quill/handlers/BufferedFileHandler.h"
+#include <cstdio>
+
+#if defined(__linux__)
+  #include <csignal>
+  #include <sys/resource.h>
+#endif
+
+TEST_SUITE_BEGIN("BufferedFileHandler");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+void test_write_in_order(fs::path const& filename, bool direct_io)
+{
+  {
+    FILE* f = fopen(filename.string().data(), "w");
+    fputs("Existing record\n", f);
+    fclose(f);
+  }
+
+  {
+    BufferedFileHandlerConfig cfg;
+    cfg.set_write_buffer_size(4096);
+    cfg.set_direct_io(direct_io);
+
+    FileEventNotifier file_event_notifier;
+    file_event_notifier.before_close = [](fs::path const&, FILE* f) { fputs("Footer\n", f); };
+
+    auto bfh = BufferedFileHandler{filename, cfg, std::move(file_event_notifier)};
+
+    if (!direct_io)
+    {
+      REQUIRE_FALSE(bfh.is_direct_io());
+    }
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      std::string s{"Record [" + std::to_string(i) + "]"};
+
+      if (i == 1000)
+      {
+        // a message bigger than the write buffer
+        s.append(10000, 'x');
+      }
+
+      s.append("\n");
+
+      if (i % 2 == 0)
+      {
+        fmt_buffer_t formatted_log_message;
+        formatted_log_message.append(s.data(), s.data() + s.size());
+        bfh.write(formatted_log_message, quill::TransitEvent{});
+      }
+      else
+      {
+        // format directly into the handler's buffer
+        fmtquill::detail::buffer<char>* buffer = bfh.direct_write_buffer();
+        REQUIRE(buffer);
+        buffer->append(s.data(), s.data() + s.size());
+        bfh.on_direct_write(quill::TransitEvent{});
+      }
+    }
+
+    bfh.flush();
+
+    std::vector<std::string> const file_contents = testing::file_contents(filename);
+    REQUIRE_EQ(file_contents.size(), 2001);
+    REQUIRE_EQ(file_contents[0], std::string{"Existing record"});
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      std::string expected{"Record [" + std::to_string(i) + "]"};
+
+      if (i == 1000)
+      {
+        expected.append(10000, 'x');
+      }
+
+      REQUIRE_EQ(file_contents[i + 1], expected);
+    }
+
+    // write one more record that is only written on destruction
+    std::string const s{"Last record\n"};
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    bfh.write(formatted_log_message, quill::TransitEvent{});
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 2003);
+  REQUIRE_EQ(file_contents[2001], std::string{"Last record"});
+  REQUIRE_EQ(file_contents[2002], std::string{"Footer"});
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("write_in_order")
+{
+  test_write_in_order("buffered_write_in_order.log", false);
+}
+
+/***/
+TEST_CASE("write_in_order_direct_io")
+{
+  // falls back to the page cache when the filesystem does not support O_DIRECT
+  test_write_in_order("buffered_write_in_order_direct_io.log", true);
+}
+
+#if defined(__linux__) && !defined(QUILL_NO_EXCEPTIONS)
+/***/
+TEST_CASE("failed_flush_is_retried")
+{
+  fs::path const filename = "buffered_failed_flush.log";
+
+  auto write_record = [](BufferedFileHandler& bfh, size_t i)
+  {
+    std::string const s{"Record [" + std::to_string(i) + "]\n"};
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    bfh.write(formatted_log_message, quill::TransitEvent{});
+  };
+
+  // writes past the file size limit fail with EFBIG instead of raising SIGXFSZ
+  auto const previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+
+  rlimit original_limit{};
+  REQUIRE_EQ(::getrlimit(RLIMIT_FSIZE, &original_limit), 0);
+
+  {
+    BufferedFileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+
+    auto bfh = BufferedFileHandler{filename, cfg, FileEventNotifier{}};
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      write_record(bfh, i);
+    }
+
+    // only a part of the buffer fits in the file
+    rlimit limit = original_limit;
+    limit.rlim_cur = 100;
+    REQUIRE_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+    bfh.flush();
+
+    // the failure is reported once by the next write, the record is still buffered
+    REQUIRE_THROWS_AS(write_record(bfh, 100), QuillError);
+    REQUIRE_NOTHROW(write_record(bfh, 101));
+
+    // the failed flush did not stop later flushes from writing the buffer
+    REQUIRE_EQ(::setrlimit(RLIMIT_FSIZE, &original_limit), 0);
+    bfh.flush();
+
+    std::vector<std::string> const file_contents = testing::file_contents(filename);
+    REQUIRE_EQ(file_contents.size(), 102);
+
+    for (size_t i = 0; i < 102; ++i)
+    {
+      REQUIRE_EQ(file_contents[i], std::string{"Record [" + std::to_string(i) + "]"});
+    }
+
+    // a failed flush does not drop the buffer on destruction
+    limit.rlim_cur = 0;
+    REQUIRE_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+    write_record(bfh, 102);
+    bfh.flush();
+    REQUIRE_EQ(::setrlimit(RLIMIT_FSIZE, &original_limit), 0);
+  }
+
+  std::signal(SIGXFSZ, previous_handler);
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 103);
+  REQUIRE_EQ(file_contents[102], std::string{"Record [102]"});
+
+  remove_file(filename);
+}
+#endif
+
+/***/
+TEST_CASE("before_write_disables_direct_formatting")
+{
+  fs::path const filename = "buffered_before_write.log";
+
+  {
+    BufferedFileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+
+    FileEventNotifier file_event_notifier;
+    file_event_notifier.before_write = [](std::string_view message)
+    { return std::string{"Modified "} + std::string{message}; };
+
+    auto bfh = BufferedFileHandler{filename, cfg, std::move(file_event_notifier)};
+    REQUIRE_EQ(bfh.direct_write_buffer(), nullptr);
+
+    std::string const s{"Record\n"};
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    bfh.write(formatted_log_message, quill::TransitEvent{});
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 1);
+  REQUIRE_EQ(file_contents[0], std::string{"Modified Record"});
+
+  remove_file(filename);
+}
+
+TEST_SUITE_END();
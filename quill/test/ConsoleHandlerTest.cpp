@@ -0,0 +1,125 @@
+#include "doctest/doctest.h"
+
+#include "quill/handlers/ConsoleHandler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <termios.h>
+  #include <unistd.h>
+#endif
+
+TEST_SUITE_BEGIN("ConsoleHandler");
+
+using namespace quill;
+
+#if !defined(_WIN32)
+namespace
+{
+/***/
+std::pair<MacroMetadata, std::pair<detail::FormatToFn, detail::PrintfFormatToFn>> info_metadata()
+{
+  return std::make_pair(MacroMetadata{"1", "ConsoleHandlerTest.cpp", "ConsoleHandlerTest.cpp:1", "info_metadata",
+                                      "{}", LogLevel::Info, MacroMetadata::Event::Log, false, false},
+                        std::make_pair(nullptr, nullptr));
+}
+
+/***/
+std::pair<MacroMetadata, std::pair<detail::FormatToFn, detail::PrintfFormatToFn>> error_metadata()
+{
+  return std::make_pair(MacroMetadata{"1", "ConsoleHandlerTest.cpp", "ConsoleHandlerTest.cpp:1", "error_metadata",
+                                      "{}", LogLevel::Error, MacroMetadata::Event::Log, false, false},
+                        std::make_pair(nullptr, nullptr));
+}
+
+/***/
+void write_record(ConsoleHandler& handler, std::string const& record, detail::MetadataFormatFn metadata)
+{
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(record.data(), record.data() + record.size());
+
+  TransitEvent transit_event;
+  transit_event.header.metadata_and_format_fn = metadata;
+  handler.write(formatted_log_message, transit_event);
+}
+
+/***/
+std::string read_terminal(int fd, size_t expected_bytes)
+{
+  std::string received;
+  char buffer[1024];
+
+  while (received.size() < expected_bytes)
+  {
+    // never wait forever in the tests
+    pollfd pfd{fd, POLLIN, 0};
+    REQUIRE_EQ(::poll(&pfd, 1, 5000), 1);
+
+    auto const res = ::read(fd, buffer, sizeof(buffer));
+    REQUIRE_GT(res, 0);
+    received.append(buffer, static_cast<size_t>(res));
+  }
+
+  return received;
+}
+} // namespace
+
+/***/
+TEST_CASE("console_colours_written_around_each_record")
+{
+  // a pseudo terminal is a colour terminal to the handler, the colours are then always used
+  int const terminal = ::posix_openpt(O_RDWR | O_NOCTTY);
+  REQUIRE_NE(terminal, -1);
+  REQUIRE_EQ(::grantpt(terminal), 0);
+  REQUIRE_EQ(::unlockpt(terminal), 0);
+
+  FILE* console = std::fopen(::ptsname(terminal), "w");
+  REQUIRE(console);
+
+  // raw mode, the newlines are not translated
+  termios attributes{};
+  REQUIRE_EQ(::tcgetattr(fileno(console), &attributes), 0);
+  ::cfmakeraw(&attributes);
+  REQUIRE_EQ(::tcsetattr(fileno(console), TCSANOW, &attributes), 0);
+
+  char const* term = std::getenv("TERM");
+  std::string const previous_term{term ? term : ""};
+  ::setenv("TERM", "xterm", 1);
+
+  ConsoleColours console_colours;
+  console_colours.set_default_colours();
+
+  {
+    ConsoleHandler handler{"console_colours_terminal", console, console_colours};
+
+    if (term)
+    {
+      ::setenv("TERM", previous_term.data(), 1);
+    }
+    else
+    {
+      ::unsetenv("TERM");
+    }
+
+    // the second record is shorter and reuses the buffer of the first one
+    write_record(handler, "first log message with a longer text\n", info_metadata);
+    write_record(handler, "second\n", error_metadata);
+    handler.flush();
+
+    std::string const expected = console_colours.colour_code(LogLevel::Info) +
+      "first log message with a longer text\n" + ConsoleColours::reset +
+      console_colours.colour_code(LogLevel::Error) + "second\n" + ConsoleColours::reset;
+
+    REQUIRE_EQ(read_terminal(terminal, expected.size()), expected);
+  }
+
+  std::fclose(console);
+  ::close(terminal);
+}
+#endif
+
+TEST_SUITE_END();
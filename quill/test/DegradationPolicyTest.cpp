@@ -0,0 +1,169 @@
+#include "doctest/doctest.h"
+
+#include "quill/handlers/DegradationPolicy.h"
+#include "quill/handlers/Handler.h"
+#include <chrono>
+
+TEST_SUITE_BEGIN("DegradationPolicy");
+
+using namespace quill;
+
+namespace
+{
+/**
+ * Does nothing, the latency is given to the handler by the test
+ */
+class NoopHandler : public Handler
+{
+public:
+  void write(fmt_buffer_t const&, quill::TransitEvent const&) override {}
+  void flush() noexcept override {}
+};
+} // namespace
+
+/***/
+TEST_CASE("default_degradation_policy")
+{
+  NoopHandler handler;
+
+  REQUIRE_EQ(handler.degradation_policy().latency_threshold().count(), 0);
+  REQUIRE_EQ(handler.degradation_policy().min_log_level(), LogLevel::Warning);
+  REQUIRE_FALSE(handler.is_degraded());
+  REQUIRE_FALSE(handler.skip_degraded_write(LogLevel::TraceL3));
+}
+
+/***/
+TEST_CASE("degrade_slow_handler")
+{
+  NoopHandler handler;
+
+  DegradationPolicy degradation_policy;
+  degradation_policy.set_latency_threshold(std::chrono::microseconds{100});
+  degradation_policy.set_min_log_level(LogLevel::Error);
+  degradation_policy.set_degraded_duration(std::chrono::milliseconds{50});
+  handler.set_degradation_policy(degradation_policy);
+
+  auto const start = std::chrono::steady_clock::now();
+
+  // fast writes
+  for (size_t i = 0; i < 100; ++i)
+  {
+    REQUIRE_FALSE(handler.record_write_latency(start, start + std::chrono::microseconds{10}));
+  }
+
+  // a single slow write is averaged out
+  REQUIRE_FALSE(handler.record_write_latency(start, start + std::chrono::microseconds{500}));
+  REQUIRE_FALSE(handler.is_degraded());
+
+  // the handler keeps being slow
+  bool degraded{false};
+  for (size_t i = 0; (i < 100) && !degraded; ++i)
+  {
+    degraded = handler.record_write_latency(start, start + std::chrono::milliseconds{1});
+  }
+
+  REQUIRE(degraded);
+  REQUIRE(handler.is_degraded());
+  REQUIRE_GT(handler.write_latency(), std::chrono::microseconds{100});
+
+  REQUIRE(handler.skip_degraded_write(LogLevel::Info));
+  REQUIRE(handler.skip_degraded_write(LogLevel::Warning));
+  REQUIRE_FALSE(handler.skip_degraded_write(LogLevel::Error));
+  REQUIRE_FALSE(handler.skip_degraded_write(LogLevel::Critical));
+
+  // stays degraded for the degraded duration
+  size_t skipped_messages{0};
+  REQUIRE_FALSE(handler.leave_degraded_mode(start + std::chrono::milliseconds{10}, skipped_messages));
+
+  // the log messages still written while degraded are fast again
+  for (size_t i = 0; i < 100; ++i)
+  {
+    REQUIRE_FALSE(handler.record_write_latency(start, start + std::chrono::microseconds{10}));
+  }
+
+  REQUIRE(handler.is_degraded());
+  REQUIRE_LE(handler.write_latency(), std::chrono::microseconds{100});
+
+  REQUIRE(handler.leave_degraded_mode(start + std::chrono::milliseconds{100}, skipped_messages));
+  REQUIRE_EQ(skipped_messages, 2);
+  REQUIRE_FALSE(handler.is_degraded());
+  REQUIRE_GT(handler.write_latency().count(), 0);
+  REQUIRE_FALSE(handler.skip_degraded_write(LogLevel::TraceL3));
+}
+
+/***/
+TEST_CASE("slow_handler_stays_degraded")
+{
+  NoopHandler handler;
+
+  DegradationPolicy degradation_policy;
+  degradation_policy.set_latency_threshold(std::chrono::microseconds{100});
+  degradation_policy.set_min_log_level(LogLevel::Error);
+  degradation_policy.set_degraded_duration(std::chrono::milliseconds{50});
+  handler.set_degradation_policy(degradation_policy);
+
+  size_t degraded_notifications{0};
+  size_t recovered_notifications{0};
+  size_t written_messages{0};
+  size_t skipped_messages{0};
+
+  // the same steps as the backend thread, an info log message every millisecond for ten degraded durations
+  auto write_log_message = [&](std::chrono::steady_clock::time_point now, std::chrono::nanoseconds latency)
+  {
+    if (handler.is_degraded())
+    {
+      if (handler.leave_degraded_mode(now, skipped_messages))
+      {
+        ++recovered_notifications;
+      }
+      else if (handler.skip_degraded_write(LogLevel::Info))
+      {
+        return;
+      }
+    }
+
+    ++written_messages;
+    if (handler.record_write_latency(now, now + latency))
+    {
+      ++degraded_notifications;
+    }
+  };
+
+  auto now = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < 500; ++i)
+  {
+    now += std::chrono::milliseconds{1};
+    write_log_message(now, std::chrono::milliseconds{1});
+  }
+
+  // degraded only once, a single probe is written after each degraded duration
+  REQUIRE(handler.is_degraded());
+  REQUIRE_EQ(degraded_notifications, 1);
+  REQUIRE_EQ(recovered_notifications, 0);
+  REQUIRE_LT(written_messages, 100);
+  REQUIRE_GT(handler.write_latency(), std::chrono::microseconds{100});
+
+  // the sink is fast again, the next probe ends the degraded mode
+  for (size_t i = 0; (i < 100) && handler.is_degraded(); ++i)
+  {
+    now += std::chrono::milliseconds{1};
+    write_log_message(now, std::chrono::microseconds{10});
+  }
+
+  REQUIRE_FALSE(handler.is_degraded());
+  REQUIRE_EQ(degraded_notifications, 1);
+  REQUIRE_EQ(recovered_notifications, 1);
+  REQUIRE_GT(skipped_messages, 0);
+
+  // the average starts from the fast probe, the handler is not degraded again
+  for (size_t i = 0; i < 100; ++i)
+  {
+    now += std::chrono::milliseconds{1};
+    write_log_message(now, std::chrono::microseconds{10});
+  }
+
+  REQUIRE_FALSE(handler.is_degraded());
+  REQUIRE_EQ(degraded_notifications, 1);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,154 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/detail/misc/FileUtilities.h"
+#include "quill/handlers/AsyncFileHandler.h"
+#include "quill/handlers/FileHandler.h"
+#include <chrono>
+
+TEST_SUITE_BEGIN("FileHandler");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+void write_record(Handler& handler, std::string const& record)
+{
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(record.data(), record.data() + record.size());
+  handler.write(formatted_log_message, quill::TransitEvent{});
+}
+
+/***/
+TEST_CASE("recreate_deleted_file")
+{
+  fs::path const filename = "recreate_deleted_file.log";
+
+  {
+    FileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_file_check_interval(std::chrono::milliseconds{0});
+    cfg.set_fsync_min_bytes(16);
+
+    auto fh = FileHandler{filename, cfg, FileEventNotifier{}};
+
+    write_record(fh, "Record [1]\n");
+    fh.flush();
+
+    REQUIRE(fs::remove(filename));
+    REQUIRE_FALSE(fs::exists(filename));
+
+    // the first flush notices the deleted file and creates a new one
+    write_record(fh, "Record [2]\n");
+    fh.flush();
+    REQUIRE(fs::exists(filename));
+
+    write_record(fh, "Record [3]\n");
+    fh.flush();
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 1);
+  REQUIRE_EQ(file_contents[0], std::string{"Record [3]"});
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("file_check_interval")
+{
+  fs::path const filename = "file_check_interval.log";
+
+  {
+    FileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_file_check_interval(std::chrono::hours{1});
+
+    auto fh = FileHandler{filename, cfg, FileEventNotifier{}};
+
+    // the first flush checks the file, the next check is an hour later
+    fh.flush();
+
+    REQUIRE(fs::remove(filename));
+
+    write_record(fh, "Record [1]\n");
+    fh.flush();
+    REQUIRE_FALSE(fs::exists(filename));
+  }
+}
+
+/***/
+TEST_CASE("async_file_handler_recreate_deleted_file")
+{
+  fs::path const filename = "async_recreate_deleted_file.log";
+
+  {
+    AsyncFileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_file_check_interval(std::chrono::milliseconds{0});
+    cfg.set_fsync_interval(std::chrono::milliseconds{1});
+
+    auto afh = AsyncFileHandler{filename, cfg, FileEventNotifier{}};
+
+    write_record(afh, "Record [1]\n");
+    afh.flush();
+
+    REQUIRE(fs::remove(filename));
+
+    write_record(afh, "Record [2]\n");
+    afh.flush();
+    REQUIRE(fs::exists(filename));
+
+    write_record(afh, "Record [3]\n");
+    afh.flush();
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 1);
+  REQUIRE_EQ(file_contents[0], std::string{"Record [3]"});
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("before_write_view")
+{
+  fs::path const filename = "before_write_view.log";
+
+  {
+    FileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+
+    FileEventNotifier file_event_notifier;
+    file_event_notifier.before_write_view = [](std::string_view message, fmt_buffer_t& output)
+    {
+      if (message.find("secret") == std::string_view::npos)
+      {
+        // unchanged, nothing is copied
+        return message;
+      }
+
+      output.append(std::string_view{"[masked]\n"});
+      return std::string_view{output.data(), output.size()};
+    };
+
+    // before_write_view takes precedence
+    file_event_notifier.before_write = [](std::string_view) { return std::string{"Wrong\n"}; };
+
+    auto fh = FileHandler{filename, cfg, std::move(file_event_notifier)};
+
+    write_record(fh, "Record [1]\n");
+    write_record(fh, "Record secret\n");
+    write_record(fh, "Record [2]\n");
+  }
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 3);
+  REQUIRE_EQ(file_contents[0], std::string{"Record [1]"});
+  REQUIRE_EQ(file_contents[1], std::string{"[masked]"});
+  REQUIRE_EQ(file_contents[2], std::string{"Record [2]"});
+
+  remove_file(filename);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,151 @@
+#include "doctest/doctest.h"
+
+#include "quill/detail/misc/Common.h"
+#include "quill/handlers/FlightRecorderHandler.h"
+#include <string>
+
+TEST_SUITE_BEGIN("FlightRecorderHandler");
+
+using namespace quill;
+
+#if !defined(_WIN32)
+namespace
+{
+/***/
+void write_record(FlightRecorderHandler& handler, std::string const& record)
+{
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(record.data(), record.data() + record.size());
+  handler.write(formatted_log_message, quill::TransitEvent{});
+}
+} // namespace
+
+/***/
+TEST_CASE("flight_recorder_keeps_latest_records")
+{
+  fs::path const filename = "flight_recorder_keeps_latest_records.ring";
+
+  FlightRecorderHandlerConfig cfg;
+  cfg.set_capacity(4096);
+  cfg.set_open_mode('w');
+
+  {
+    FlightRecorderHandler handler{filename, cfg};
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      write_record(handler, "Record [" + std::to_string(i) + "]\n");
+    }
+
+    // readable while the handler is still writing
+    std::string const contents = FlightRecorderHandler::read(filename);
+
+    REQUIRE_LE(contents.size(), 4096);
+    REQUIRE_GT(contents.size(), 4096 - 32);
+
+    // complete records only, oldest first
+    REQUIRE_EQ(contents.rfind("Record [999]\n"), contents.size() - 13);
+    REQUIRE_EQ(contents.find("Record ["), 0);
+
+    size_t const first = std::stoul(contents.substr(8));
+    std::string expected;
+    for (size_t i = first; i < 1000; ++i)
+    {
+      expected += "Record [" + std::to_string(i) + "]\n";
+    }
+
+    REQUIRE_EQ(contents, expected);
+  }
+
+  // the file outlives the process and the mapping
+  REQUIRE_EQ(fs::file_size(filename), 4096 + sizeof(FlightRecorderHeader));
+  REQUIRE_EQ(FlightRecorderHandler::read(filename).rfind("Record [999]\n"),
+             FlightRecorderHandler::read(filename).size() - 13);
+
+  fs::remove(filename);
+}
+
+/***/
+TEST_CASE("flight_recorder_continues_existing_ring")
+{
+  fs::path const filename = "flight_recorder_continues_existing_ring.ring";
+
+  FlightRecorderHandlerConfig cfg;
+  cfg.set_capacity(8192);
+  cfg.set_open_mode('w');
+
+  {
+    FlightRecorderHandler handler{filename, cfg};
+    write_record(handler, "First run\n");
+  }
+
+  cfg.set_open_mode('a');
+
+  {
+    FlightRecorderHandler handler{filename, cfg};
+    write_record(handler, "Second run\n");
+  }
+
+  REQUIRE_EQ(FlightRecorderHandler::read(filename), std::string{"First run\nSecond run\n"});
+
+  // a different capacity resets the ring
+  cfg.set_capacity(16384);
+
+  {
+    FlightRecorderHandler handler{filename, cfg};
+    write_record(handler, "Third run\n");
+  }
+
+  REQUIRE_EQ(FlightRecorderHandler::read(filename), std::string{"Third run\n"});
+
+  cfg.set_open_mode('w');
+
+  {
+    FlightRecorderHandler handler{filename, cfg};
+  }
+
+  REQUIRE(FlightRecorderHandler::read(filename).empty());
+
+  fs::remove(filename);
+}
+
+/***/
+TEST_CASE("flight_recorder_record_bigger_than_capacity")
+{
+  fs::path const filename = "flight_recorder_record_bigger_than_capacity.ring";
+
+  FlightRecorderHandlerConfig cfg;
+  cfg.set_capacity(1024);
+  cfg.set_open_mode('w');
+
+  {
+    FlightRecorderHandler handler{filename, cfg};
+    write_record(handler, "Small\n");
+    write_record(handler, std::string(2000, 'x') + "\n");
+    write_record(handler, "Last\n");
+  }
+
+  // the oversized record is partially overwritten and skipped
+  REQUIRE_EQ(FlightRecorderHandler::read(filename), std::string{"Last\n"});
+
+  fs::remove(filename);
+}
+
+/***/
+TEST_CASE("flight_recorder_invalid_file")
+{
+  fs::path const filename = "flight_recorder_invalid_file.ring";
+
+  {
+    FILE* f = fopen(filename.string().data(), "w");
+    fputs("not a ring\n", f);
+    fclose(f);
+  }
+
+  REQUIRE_THROWS_AS((void)FlightRecorderHandler::read(filename), QuillError);
+
+  fs::remove(filename);
+}
+#endif
+
+TEST_SUITE_END();
@@ -0,0 +1,108 @@
+#include "doctest/doctest.h"
+
+#include "quill/handlers/FlushPolicy.h"
+#include "quill/handlers/Handler.h"
+#include <chrono>
+#include <thread>
+
+TEST_SUITE_BEGIN("FlushPolicy");
+
+using namespace quill;
+
+namespace
+{
+/**
+ * Counts the flushes
+ */
+class FlushCountingHandler : public Handler
+{
+public:
+  void write(fmt_buffer_t const&, quill::TransitEvent const&) override {}
+  void flush() noexcept override { ++flush_count; }
+
+  size_t flush_count{0};
+};
+} // namespace
+
+/***/
+TEST_CASE("default_flush_policy")
+{
+  FlushCountingHandler handler;
+
+  REQUIRE_FALSE(handler.should_flush_on_idle(std::chrono::steady_clock::now()));
+
+  // only flushed when idle
+  REQUIRE_FALSE(handler.record_unflushed_write(1000000, LogLevel::Critical));
+  REQUIRE(handler.should_flush_on_idle(std::chrono::steady_clock::now()));
+  REQUIRE_FALSE(handler.has_pending_flush_interval());
+
+  handler.flush_by_backend();
+  REQUIRE_EQ(handler.flush_count, 1);
+  REQUIRE_FALSE(handler.should_flush_on_idle(std::chrono::steady_clock::now()));
+}
+
+/***/
+TEST_CASE("flush_on_log_level")
+{
+  FlushCountingHandler handler;
+
+  FlushPolicy flush_policy;
+  flush_policy.set_flush_log_level(LogLevel::Error);
+  handler.set_flush_policy(flush_policy);
+
+  REQUIRE_FALSE(handler.record_unflushed_write(10, LogLevel::Info));
+  REQUIRE_FALSE(handler.record_unflushed_write(10, LogLevel::Warning));
+  REQUIRE(handler.record_unflushed_write(10, LogLevel::Error));
+  REQUIRE(handler.record_unflushed_write(10, LogLevel::Critical));
+}
+
+/***/
+TEST_CASE("flush_on_bytes")
+{
+  FlushCountingHandler handler;
+
+  FlushPolicy flush_policy;
+  flush_policy.set_flush_bytes(100);
+  flush_policy.set_flush_on_idle(false);
+  handler.set_flush_policy(flush_policy);
+
+  REQUIRE_FALSE(handler.record_unflushed_write(40, LogLevel::Info));
+  REQUIRE_FALSE(handler.record_unflushed_write(40, LogLevel::Info));
+  REQUIRE(handler.record_unflushed_write(40, LogLevel::Info));
+
+  handler.flush_by_backend();
+
+  // the byte count starts again after a flush
+  REQUIRE_FALSE(handler.record_unflushed_write(40, LogLevel::Info));
+
+  // not flushed when idle
+  REQUIRE_FALSE(handler.should_flush_on_idle(std::chrono::steady_clock::now()));
+  REQUIRE_FALSE(handler.has_pending_flush_interval());
+}
+
+/***/
+TEST_CASE("flush_on_interval")
+{
+  FlushCountingHandler handler;
+
+  FlushPolicy flush_policy;
+  flush_policy.set_flush_interval(std::chrono::milliseconds{20});
+  flush_policy.set_flush_on_idle(false);
+  handler.set_flush_policy(flush_policy);
+
+  auto const start = std::chrono::steady_clock::now();
+  REQUIRE_FALSE(handler.record_unflushed_write(10, LogLevel::Info));
+  REQUIRE(handler.has_pending_flush_interval());
+
+  // the interval is also checked when idle
+  REQUIRE_FALSE(handler.should_flush_on_idle(start));
+  REQUIRE(handler.should_flush_on_idle(start + std::chrono::milliseconds{50}));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{30});
+  REQUIRE(handler.record_unflushed_write(10, LogLevel::Info));
+
+  handler.flush_by_backend();
+  REQUIRE_FALSE(handler.has_pending_flush_interval());
+}
+
+TEST_SUITE_END();
@@ -184,4 +184,33 @@ TEST_CASE("subscribe_get_active_different_handlers")
   std::remove("create_get_file_handler_2");
 }
 
+/***/
+TEST_CASE("active_handlers_version")
+{
+  HandlerCollection hc;
+  uint64_t const initial_version = hc.active_handlers_version();
+
+  std::shared_ptr<Handler> handler = hc.stdout_console_handler();
+  REQUIRE_EQ(hc.active_handlers_version(), initial_version);
+
+  // only a change of the active handlers increments the version
+  hc.subscribe_handler(handler);
+  uint64_t const subscribed_version = hc.active_handlers_version();
+  REQUIRE_NE(subscribed_version, initial_version);
+
+  hc.subscribe_handler(handler);
+  REQUIRE_EQ(hc.active_handlers_version(), subscribed_version);
+
+  hc.remove_unused_handlers();
+  REQUIRE_EQ(hc.active_handlers_version(), subscribed_version);
+
+  handler.reset();
+  hc.remove_unused_handlers();
+  REQUIRE_NE(hc.active_handlers_version(), subscribed_version);
+
+  std::vector<std::weak_ptr<Handler>> ahc;
+  hc.active_handlers(ahc);
+  REQUIRE(ahc.empty());
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "doctest/doctest.h"
+
+#include "quill/detail/misc/HugePagesArena.h"
+#include <cstdint>
+#include <cstdlib>
+
+TEST_SUITE_BEGIN("HugePagesArena");
+
+using namespace quill::detail;
+
+#if defined(__linux__)
+/***/
+TEST_CASE("allocate_until_exhausted")
+{
+  // normal pages are used as huge pages might not be available
+  HugePagesArena arena{false};
+  REQUIRE_FALSE(arena.is_reserved());
+  REQUIRE_EQ(arena.allocate(4096, 64), nullptr);
+
+  arena.reserve(1);
+  REQUIRE(arena.is_reserved());
+  REQUIRE_EQ(arena.capacity(), 2u * 1024u * 1024u);
+
+  void* first = arena.allocate(1024u * 1024u, 64);
+  REQUIRE_NE(first, nullptr);
+  REQUIRE_EQ(reinterpret_cast<uintptr_t>(first) % 4096, 0);
+
+  void* second = arena.allocate(1024u * 1024u - 1, 4096);
+  REQUIRE_NE(second, nullptr);
+  REQUIRE_EQ(arena.used(), arena.capacity());
+
+  // exhausted
+  REQUIRE_EQ(arena.allocate(1, 8), nullptr);
+
+  REQUIRE(arena.deallocate(first));
+  REQUIRE(arena.deallocate(second));
+  REQUIRE_EQ(arena.used(), 0);
+}
+
+/***/
+TEST_CASE("deallocate_merges_free_blocks")
+{
+  HugePagesArena arena{false};
+  arena.reserve(2u * 1024u * 1024u);
+
+  size_t constexpr block_size{512u * 1024u};
+  void* blocks[4];
+
+  for (auto& block : blocks)
+  {
+    block = arena.allocate(block_size, 64);
+    REQUIRE_NE(block, nullptr);
+  }
+
+  REQUIRE_EQ(arena.allocate(1, 8), nullptr);
+
+  // free out of order, the blocks are merged back into a single block
+  REQUIRE(arena.deallocate(blocks[1]));
+  REQUIRE(arena.deallocate(blocks[3]));
+  REQUIRE(arena.deallocate(blocks[2]));
+  REQUIRE(arena.deallocate(blocks[0]));
+  REQUIRE_EQ(arena.used(), 0);
+
+  void* whole = arena.allocate(arena.capacity(), 64);
+  REQUIRE_EQ(whole, blocks[0]);
+  REQUIRE(arena.deallocate(whole));
+}
+
+/***/
+TEST_CASE("deallocate_foreign_pointer")
+{
+  HugePagesArena arena{false};
+
+  void* ptr = std::malloc(64);
+  REQUIRE_FALSE(arena.deallocate(ptr));
+
+  arena.reserve(4096);
+  REQUIRE_FALSE(arena.deallocate(ptr));
+  std::free(ptr);
+
+  // alignments bigger than a page are not supported
+  REQUIRE_EQ(arena.allocate(4096, 8192), nullptr);
+}
+#endif
+
+TEST_SUITE_END();
@@ -0,0 +1,159 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Config.h"
+#include "quill/detail/LogMacros.h"
+#include "quill/detail/LogManager.h"
+#include "quill/detail/ThreadContext.h"
+#include "quill/detail/misc/FileUtilities.h"
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("LoadShedding");
+
+using namespace quill;
+using namespace quill::detail;
+
+namespace
+{
+/**
+ * Writes nbytes to the queue without reading them
+ */
+void write_bytes(BoundedQueue& queue, uint32_t nbytes)
+{
+  std::byte* write_buffer = queue.prepare_write(nbytes);
+  REQUIRE(write_buffer);
+  std::memset(write_buffer, 0, nbytes);
+  queue.finish_write(nbytes);
+  queue.commit_write();
+}
+
+/**
+ * Reads nbytes from the queue
+ */
+void read_bytes(BoundedQueue& queue, uint32_t nbytes)
+{
+  REQUIRE(queue.prepare_read());
+  queue.finish_read(nbytes);
+  queue.commit_read();
+}
+} // namespace
+
+/***/
+TEST_CASE("min_log_level_follows_queue_occupancy")
+{
+  Config config;
+  config.enable_load_shedding = true;
+
+  ThreadContext thread_context{QueueType::BoundedNonBlocking, 1024, 1, false};
+  BoundedQueue& queue = thread_context.spsc_queue<QueueType::BoundedNonBlocking>();
+
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::TraceL3);
+
+  // 50% debug watermark
+  write_bytes(queue, 512);
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::Info);
+
+  // 75% info watermark
+  write_bytes(queue, 256);
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::Warning);
+
+  // 62.5%, still above the info watermark minus the hysteresis
+  read_bytes(queue, 128);
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::Warning);
+
+  // 50%
+  read_bytes(queue, 128);
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::Info);
+
+  // 37.5%, still above the debug watermark minus the hysteresis
+  read_bytes(queue, 128);
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::Info);
+
+  // 25%
+  read_bytes(queue, 128);
+  thread_context.update_min_log_level(queue, config);
+  REQUIRE_EQ(thread_context.min_log_level(), LogLevel::TraceL3);
+}
+
+/***/
+TEST_CASE("shed_message_counter")
+{
+  ThreadContext thread_context{QueueType::BoundedNonBlocking, 1024, 1, false};
+
+  REQUIRE_EQ(thread_context.get_and_reset_shed_message_counter(), 0);
+
+  thread_context.increment_shed_message_counter();
+  thread_context.increment_shed_message_counter();
+  REQUIRE_EQ(thread_context.get_and_reset_shed_message_counter(), 2);
+  REQUIRE_EQ(thread_context.get_and_reset_shed_message_counter(), 0);
+}
+
+/***/
+TEST_CASE("shed_log_level_restored_after_the_queue_is_drained")
+{
+  fs::path const filename{"load_shedding_restored.log"};
+
+  {
+    LogManager lm;
+
+    quill::Config cfg;
+    cfg.enable_load_shedding = true;
+    cfg.default_queue_capacity = 4096;
+    cfg.default_handlers.emplace_back(lm.handler_collection().create_handler<FileHandler>(
+      filename.string(),
+      []()
+      {
+        quill::FileHandlerConfig cfg;
+        cfg.set_open_mode('w');
+        cfg.set_pattern("%(message)");
+        return cfg;
+      }(),
+      FileEventNotifier{}));
+
+    lm.configure(cfg);
+
+    std::thread frontend(
+      [&lm, &filename]()
+      {
+        Logger* logger = lm.logger_collection().get_logger();
+
+        // the backend is not running yet, the queue fills up until Info is shed
+        size_t logged{0};
+        while (logger->should_log<LogLevel::Info>())
+        {
+          LOG_INFO(logger, "Before drain {}", logged);
+          ++logged;
+          REQUIRE_LT(logged, 4096);
+        }
+
+        REQUIRE_GT(logged, 0);
+
+        // this thread only logs Info, it never pushes a message that would update its level
+        lm.start_backend_worker(false, std::initializer_list<int32_t>{});
+        lm.flush();
+
+        REQUIRE(logger->should_log<LogLevel::Info>());
+        LOG_INFO(logger, "After drain");
+        lm.flush();
+
+        std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+        REQUIRE_EQ(file_contents.size(), logged + 1);
+        REQUIRE_EQ(file_contents.back(), std::string{"After drain"});
+      });
+
+    frontend.join();
+  }
+
+  quill::detail::remove_file(filename);
+}
+
+TEST_SUITE_END();
@@ -5,6 +5,10 @@
 #include "quill/detail/LoggerCollection.h"
 #include "quill/detail/ThreadContextCollection.h"
 #include "quill/handlers/StreamHandler.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_SUITE_BEGIN("LoggerCollection");
 
@@ -148,4 +152,66 @@ TEST_CASE("create_logger_from_default_logger")
   REQUIRE_EQ(default_logger->log_level(), LogLevel::Info);
 }
 
+/***/
+TEST_CASE("get_logger_while_creating_loggers")
+{
+  Config cfg;
+  HandlerCollection hc;
+  ThreadContextCollection tc{cfg};
+  LoggerCollection logger_collection{cfg, tc, hc};
+
+  auto stream_handler = hc.stdout_console_handler();
+  Logger* logger_0 = logger_collection.create_logger("logger_0", stream_handler, TimestampClockType::Tsc, nullptr);
+
+  std::atomic<bool> done{false};
+
+  // lookups do not lock while the lookup table grows
+  std::thread reader(
+    [&logger_collection, &done, logger_0]()
+    {
+      while (!done.load())
+      {
+        REQUIRE_EQ(logger_collection.get_logger("logger_0"), logger_0);
+      }
+    });
+
+  std::vector<Logger*> loggers;
+  for (size_t i = 1; i < 500; ++i)
+  {
+    loggers.push_back(logger_collection.create_logger("logger_" + std::to_string(i), stream_handler,
+                                                      TimestampClockType::Tsc, nullptr));
+  }
+
+  done.store(true);
+  reader.join();
+
+  for (size_t i = 1; i < 500; ++i)
+  {
+    REQUIRE_EQ(logger_collection.get_logger(("logger_" + std::to_string(i)).data()), loggers[i - 1]);
+  }
+
+  REQUIRE_EQ(logger_collection.get_all_loggers().size(), 501);
+}
+
+/***/
+TEST_CASE("get_removed_logger")
+{
+  Config cfg;
+  HandlerCollection hc;
+  ThreadContextCollection tc{cfg};
+  LoggerCollection logger_collection{cfg, tc, hc};
+
+  auto stream_handler = hc.stdout_console_handler();
+  Logger* logger = logger_collection.create_logger("logger_1", stream_handler, TimestampClockType::Tsc, nullptr);
+
+  logger_collection.remove_logger(logger);
+  REQUIRE(logger_collection.remove_invalidated_loggers([]() { return true; }));
+  REQUIRE_THROWS_AS(QUILL_MAYBE_UNUSED auto removed_logger = logger_collection.get_logger("logger_1"),
+                    quill::QuillError);
+
+  // the name can be used again
+  Logger* new_logger = logger_collection.create_logger("logger_1", stream_handler, TimestampClockType::Tsc, nullptr);
+  REQUIRE_EQ(logger_collection.get_logger("logger_1"), new_logger);
+}
+
 TEST_SUITE_END();
\ No newline at end of file
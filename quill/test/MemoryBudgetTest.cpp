@@ -0,0 +1,129 @@
+#include "doctest/doctest.h"
+
+#include "quill/detail/backend/TransitEventBuffer.h"
+#include "quill/detail/misc/MemoryBudget.h"
+#include "quill/detail/spsc_queue/UnboundedQueue.h"
+#include <cstring>
+
+TEST_SUITE_BEGIN("MemoryBudget");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+TEST_CASE("no_limit")
+{
+  MemoryBudget memory_budget;
+
+  REQUIRE(memory_budget.try_acquire(1024u * 1024u * 1024u, LogLevel::TraceL3));
+  REQUIRE_EQ(memory_budget.usage(), 1024u * 1024u * 1024u);
+
+  memory_budget.release(1024u * 1024u * 1024u);
+  REQUIRE_EQ(memory_budget.usage(), 0);
+}
+
+/***/
+TEST_CASE("stop_growing")
+{
+  MemoryBudget memory_budget;
+  memory_budget.configure(1000, MemoryBudgetPolicy::StopGrowing);
+
+  REQUIRE(memory_budget.try_acquire(600, LogLevel::Debug));
+  REQUIRE_FALSE(memory_budget.try_acquire(600, LogLevel::Critical));
+  REQUIRE(memory_budget.try_acquire(400, LogLevel::Info));
+  REQUIRE_EQ(memory_budget.usage(), 1000);
+
+  // always succeeds
+  memory_budget.acquire(100);
+  REQUIRE_EQ(memory_budget.usage(), 1100);
+  REQUIRE_FALSE(memory_budget.try_acquire(1, LogLevel::Critical));
+}
+
+/***/
+TEST_CASE("drop_lowest_levels_first")
+{
+  MemoryBudget memory_budget;
+  memory_budget.configure(1000, MemoryBudgetPolicy::DropLowestLevelsFirst);
+
+  REQUIRE(memory_budget.try_acquire(500, LogLevel::TraceL3));
+  REQUIRE_FALSE(memory_budget.try_acquire(1, LogLevel::Debug));
+
+  REQUIRE(memory_budget.try_acquire(250, LogLevel::Info));
+  REQUIRE_FALSE(memory_budget.try_acquire(1, LogLevel::Info));
+
+  REQUIRE(memory_budget.try_acquire(250, LogLevel::Warning));
+  REQUIRE_FALSE(memory_budget.try_acquire(1, LogLevel::Critical));
+}
+
+/***/
+TEST_CASE("unbounded_queue_stops_growing")
+{
+  size_t const initial_usage = MemoryBudget::instance().usage();
+
+  {
+    UnboundedQueue queue{1024};
+    REQUIRE_EQ(MemoryBudget::instance().usage(), initial_usage + 2048);
+
+    // allow the queue to grow once
+    MemoryBudget::instance().configure(initial_usage + 2048 + 4096, MemoryBudgetPolicy::StopGrowing);
+
+    uint32_t constexpr message_size{512};
+    uint32_t written{0};
+
+    while (std::byte* write_buffer = queue.prepare_write(message_size, LogLevel::Info))
+    {
+      std::memset(write_buffer, 0, message_size);
+      queue.finish_write(message_size);
+      queue.commit_write();
+      ++written;
+    }
+
+    // two messages fit in the first queue and four in the second one
+    REQUIRE(queue.memory_budget_exceeded());
+    REQUIRE_EQ(written, 6);
+    REQUIRE_EQ(MemoryBudget::instance().usage(), initial_usage + 2048 + 4096);
+
+    // the first queue is freed once the consumer switches to the second one
+    uint32_t read{0};
+    while (queue.prepare_read().first)
+    {
+      queue.finish_read(message_size);
+      queue.commit_read();
+      ++read;
+    }
+
+    REQUIRE_EQ(read, written);
+    REQUIRE_EQ(MemoryBudget::instance().usage(), initial_usage + 4096);
+  }
+
+  REQUIRE_EQ(MemoryBudget::instance().usage(), initial_usage);
+  MemoryBudget::instance().configure(0, MemoryBudgetPolicy::Block);
+}
+
+/***/
+TEST_CASE("transit_event_buffer_stops_growing")
+{
+  size_t const initial_usage = MemoryBudget::instance().usage();
+
+  {
+    UnboundedTransitEventBuffer transit_event_buffer{4};
+    MemoryBudget::instance().configure(MemoryBudget::instance().usage(), MemoryBudgetPolicy::Block);
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      REQUIRE(transit_event_buffer.back());
+      transit_event_buffer.push_back();
+    }
+
+    // the backend thread never blocks
+    REQUIRE_EQ(transit_event_buffer.back(), nullptr);
+
+    transit_event_buffer.pop_front();
+    REQUIRE(transit_event_buffer.back());
+  }
+
+  REQUIRE_EQ(MemoryBudget::instance().usage(), initial_usage);
+  MemoryBudget::instance().configure(0, MemoryBudgetPolicy::Block);
+}
+
+TEST_SUITE_END();
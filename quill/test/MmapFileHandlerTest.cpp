@@ -0,0 +1,129 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/detail/misc/Common.h"
+#include "quill/detail/misc/FileUtilities.h"
+#include "quill/handlers/MmapFileHandler.h"
+#include <cstdio>
+
+TEST_SUITE_BEGIN("MmapFileHandler");
+
+using namespace quill;
+using namespace quill::detail;
+
+/***/
+TEST_CASE("mmap_write_across_windows")
+{
+  fs::path const filename = "mmap_write_across_windows.log";
+  size_t expected_size{0};
+
+  {
+    FILE* f = fopen(filename.string().data(), "w");
+    fputs("Existing record\n", f);
+    fclose(f);
+    expected_size += 16;
+  }
+
+  {
+    MmapFileHandlerConfig cfg;
+    cfg.set_chunk_size(8192);
+    cfg.set_sync_policy(MmapFileHandlerConfig::SyncPolicy::Async);
+
+    FileEventNotifier file_event_notifier;
+    file_event_notifier.before_close = [](fs::path const&, FILE* f) { fputs("Footer\n", f); };
+
+    auto mfh = MmapFileHandler{filename, cfg, std::move(file_event_notifier)};
+
+#if !defined(_WIN32)
+    REQUIRE(mfh.is_mapped());
+#endif
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      std::string s{"Record [" + std::to_string(i) + "]"};
+
+      if (i == 1000)
+      {
+        // a message bigger than the mapped window
+        s.append(20000, 'x');
+      }
+
+      s.append("\n");
+      expected_size += s.size();
+
+      fmt_buffer_t formatted_log_message;
+      formatted_log_message.append(s.data(), s.data() + s.size());
+      mfh.write(formatted_log_message, quill::TransitEvent{});
+    }
+
+    mfh.flush();
+  }
+
+  expected_size += 7;
+
+  // the preallocated part is truncated on close
+  REQUIRE_EQ(fs::file_size(filename), expected_size);
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 2002);
+  REQUIRE_EQ(file_contents[0], std::string{"Existing record"});
+
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    std::string expected{"Record [" + std::to_string(i) + "]"};
+
+    if (i == 1000)
+    {
+      expected.append(20000, 'x');
+    }
+
+    REQUIRE_EQ(file_contents[i + 1], expected);
+  }
+
+  REQUIRE_EQ(file_contents[2001], std::string{"Footer"});
+
+  remove_file(filename);
+}
+
+/***/
+TEST_CASE("mmap_size_rotation")
+{
+  fs::path const filename = "mmap_size_rotation.log";
+  fs::path const filename_1 = "mmap_size_rotation.1.log";
+  fs::path const filename_2 = "mmap_size_rotation.2.log";
+
+  {
+    MmapFileHandlerConfig cfg;
+    cfg.set_open_mode('w');
+    cfg.set_chunk_size(4096);
+    cfg.set_rotation_max_file_size(1024);
+
+    auto mfh = MmapFileHandler{filename, cfg, FileEventNotifier{}};
+
+    // each record is 600 bytes so each file holds one record
+    for (size_t i = 0; i < 3; ++i)
+    {
+      std::string s{"Record [" + std::to_string(i) + "]"};
+      s.resize(599, ' ');
+      s.append("\n");
+
+      fmt_buffer_t formatted_log_message;
+      formatted_log_message.append(s.data(), s.data() + s.size());
+      mfh.write(formatted_log_message, quill::TransitEvent{});
+    }
+  }
+
+  REQUIRE_EQ(fs::file_size(filename), 600);
+  REQUIRE_EQ(fs::file_size(filename_1), 600);
+  REQUIRE_EQ(fs::file_size(filename_2), 600);
+
+  REQUIRE(testing::file_contains(testing::file_contents(filename), "Record [2]"));
+  REQUIRE(testing::file_contains(testing::file_contents(filename_1), "Record [1]"));
+  REQUIRE(testing::file_contains(testing::file_contents(filename_2), "Record [0]"));
+
+  remove_file(filename);
+  remove_file(filename_1);
+  remove_file(filename_2);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,81 @@
+#include "doctest/doctest.h"
+
+#include "misc/TestUtilities.h"
+#include "quill/Quill.h"
+#include "quill/detail/misc/FileUtilities.h"
+#include <cstdio>
+#include <string>
+
+TEST_SUITE_BEGIN("QuillLogBoundedQueue");
+
+// Note: This target is compiled with QUILL_USE_BOUNDED_BLOCKING_QUEUE, it makes sure the hot path
+// builds and logs with a bounded queue as the other tests use the default unbounded queue
+
+/***/
+TEST_CASE("log_from_multiple_threads_bounded_blocking_queue")
+{
+  static_assert(QUILL_QUEUE_TYPE == quill::detail::QueueType::BoundedBlocking);
+
+  static constexpr uint32_t number_of_messages = 500u;
+  static constexpr int number_of_threads = 4;
+  static constexpr char const* filename = "log_from_multiple_threads_bounded_blocking_queue.log";
+
+  quill::Config cfg;
+  cfg.default_queue_capacity = 1024;
+  cfg.enable_load_shedding = false;
+  quill::configure(cfg);
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(
+      [i]()
+      {
+        std::shared_ptr<quill::Handler> file_handler = quill::file_handler(filename,
+                                                                           []()
+                                                                           {
+                                                                             quill::FileHandlerConfig cfg;
+                                                                             cfg.set_open_mode('w');
+                                                                             return cfg;
+                                                                           }());
+
+        std::string logger_name = "logger_bounded_" + std::to_string(i);
+        quill::Logger* logger = quill::create_logger(logger_name, std::move(file_handler));
+
+        for (uint32_t j = 0; j < number_of_messages; ++j)
+        {
+          LOG_INFO(logger, "Hello from thread {} this is message {}", i, j);
+          LOG_DYNAMIC(logger, quill::LogLevel::Warning, "Dynamic from thread {} message {}", i, j);
+        }
+      });
+  }
+
+  for (auto& elem : threads)
+  {
+    elem.join();
+  }
+
+  quill::flush();
+
+  // Read file and check, the blocking queue never drops
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), 2 * number_of_messages * number_of_threads);
+
+  for (int i = 0; i < number_of_threads; ++i)
+  {
+    for (uint32_t j = 0; j < number_of_messages; ++j)
+    {
+      std::string const expected_string = "logger_bounded_" + std::to_string(i) +
+        " Hello from thread " + std::to_string(i) + " this is message " + std::to_string(j);
+      REQUIRE(quill::testing::file_contains(file_contents, expected_string));
+    }
+  }
+
+  quill::detail::remove_file(filename);
+}
+
+TEST_SUITE_END();
@@ -687,4 +687,400 @@ TEST_CASE("log_enums_with_overloaded_insertion_operator")
   REQUIRE_EQ(results, "Test1,Test2,Test3,Test4,Test5,Test6\n");
 }
 
+/***/
+TEST_CASE("log_using_coarse_clock")
+{
+  static constexpr char const* filename = "log_using_coarse_clock.log";
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::thread frontend(
+    []()
+    {
+      quill::FileHandlerConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_pattern("%(ascii_time) %(message)", "%Qepoch_ns");
+      std::shared_ptr<quill::Handler> file_handler = quill::file_handler(filename, cfg);
+
+      quill::Logger* logger = quill::create_logger("coarse_logger", std::move(file_handler),
+                                                   quill::TimestampClockType::Coarse);
+
+      auto const begin_ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+
+      LOG_INFO(logger, "Hello from coarse clock");
+
+      auto const end_ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+
+      quill::flush();
+
+      std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+      REQUIRE_EQ(file_contents.size(), 1);
+      REQUIRE(quill::testing::file_contains(file_contents, "Hello from coarse clock"));
+
+      // the coarse clock lags the system clock by at most a kernel tick
+      int64_t const logged_ts = std::stoll(file_contents[0].substr(0, file_contents[0].find(' ')));
+      REQUIRE_GE(logged_ts, begin_ts - 50'000'000);
+      REQUIRE_LE(logged_ts, end_ts);
+
+      quill::remove_logger(logger);
+    });
+
+  frontend.join();
+
+  quill::detail::remove_file(filename);
+}
+
+/***/
+TEST_CASE("log_using_coarse_clock_strict_timestamp_order")
+{
+  static constexpr char const* filename = "log_using_coarse_clock_strict_timestamp_order.log";
+  static constexpr size_t number_of_messages = 2000;
+  static constexpr size_t number_of_threads = 3;
+
+  // Start the logging backend thread, backend_thread_strict_log_timestamp_order is on by default
+  quill::start();
+
+  quill::FileHandlerConfig cfg;
+  cfg.set_open_mode('w');
+  cfg.set_pattern("%(ascii_time) %(message)", "%Qepoch_ns");
+  std::shared_ptr<quill::Handler> file_handler = quill::file_handler(filename, cfg);
+
+  std::vector<std::thread> frontends;
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    frontends.emplace_back(
+      [i, file_handler]()
+      {
+        quill::Logger* logger = quill::create_logger("coarse_order_logger_" + std::to_string(i),
+                                                     std::shared_ptr<quill::Handler>{file_handler},
+                                                     quill::TimestampClockType::Coarse);
+
+        for (size_t j = 0; j < number_of_messages; ++j)
+        {
+          LOG_INFO(logger, "Coarse message {} {}", i, j);
+        }
+      });
+  }
+
+  for (auto& frontend : frontends)
+  {
+    frontend.join();
+  }
+
+  quill::flush();
+
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+  REQUIRE_EQ(file_contents.size(), number_of_messages * number_of_threads);
+
+  // the coarse timestamps are compared against the coarse clock, the output stays in order
+  int64_t previous_ts{0};
+  for (auto const& line : file_contents)
+  {
+    int64_t const logged_ts = std::stoll(line.substr(0, line.find(' ')));
+    REQUIRE_GE(logged_ts, previous_ts);
+    previous_ts = logged_ts;
+  }
+
+  for (size_t i = 0; i < number_of_threads; ++i)
+  {
+    quill::remove_logger(quill::get_logger(("coarse_order_logger_" + std::to_string(i)).data()));
+  }
+
+  quill::detail::remove_file(filename);
+}
+
+/***/
+struct FixedClockPolicy
+{
+  static constexpr quill::TimestampClockType clock_type = quill::TimestampClockType::Custom;
+  static uint64_t now() noexcept { return 1'000'000'000ull; }
+};
+
+/***/
+TEST_CASE("log_using_compile_time_clock_policy")
+{
+  static constexpr char const* filename = "log_using_compile_time_clock_policy.log";
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::thread frontend(
+    []()
+    {
+      quill::FileHandlerConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_pattern("%(ascii_time) %(logger_name) %(message)", "%Qepoch_ns");
+      std::shared_ptr<quill::Handler> file_handler = quill::file_handler(filename, cfg);
+
+      quill::LoggerT<FixedClockPolicy>* fixed_logger =
+        quill::create_logger<FixedClockPolicy>("fixed_policy_logger", std::move(file_handler));
+
+      quill::LoggerT<quill::SystemClockPolicy>* system_logger =
+        quill::create_logger<quill::SystemClockPolicy>(
+          "system_policy_logger", quill::file_handler(filename, quill::FileHandlerConfig{}));
+
+      REQUIRE_EQ(system_logger->timestamp_clock_type(), quill::TimestampClockType::System);
+
+      // requesting the same logger with the same policy returns the existing one
+      REQUIRE_EQ(quill::create_logger<FixedClockPolicy>("fixed_policy_logger"), fixed_logger);
+
+      // requesting the same logger with a different policy throws
+      REQUIRE_THROWS_AS(
+        static_cast<void>(quill::create_logger<quill::SystemClockPolicy>("fixed_policy_logger")),
+        quill::QuillError);
+
+      // a logger created with the same clock type is returned for the built-in policies
+      quill::Logger* plain_logger = quill::create_logger(
+        "plain_system_logger", quill::file_handler(filename, quill::FileHandlerConfig{}),
+        quill::TimestampClockType::System);
+
+      REQUIRE_EQ(quill::create_logger<quill::SystemClockPolicy>("plain_system_logger"), plain_logger);
+      REQUIRE_THROWS_AS(static_cast<void>(quill::create_logger<quill::CoarseClockPolicy>("plain_system_logger")),
+                        quill::QuillError);
+
+      auto const begin_ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+
+      LOG_INFO(fixed_logger, "Hello from fixed clock");
+      LOG_INFO(system_logger, "Hello from system clock");
+
+      auto const end_ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count();
+
+      quill::flush();
+
+      std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+      REQUIRE_EQ(file_contents.size(), 2);
+      REQUIRE(quill::testing::file_contains(
+        file_contents, std::string{"1000000000 fixed_policy_logger Hello from fixed clock"}));
+
+      for (auto const& line : file_contents)
+      {
+        if (line.find("system_policy_logger") != std::string::npos)
+        {
+          int64_t const logged_ts = std::stoll(line.substr(0, line.find(' ')));
+          REQUIRE_GE(logged_ts, begin_ts);
+          REQUIRE_LE(logged_ts, end_ts);
+        }
+      }
+
+      quill::remove_logger(fixed_logger);
+      quill::remove_logger(system_logger);
+    });
+
+  frontend.join();
+
+  quill::detail::remove_file(filename);
+}
+
+/***/
+TEST_CASE("log_using_buffered_file_handler")
+{
+  static constexpr char const* filename = "log_using_buffered_file_handler.log";
+  static constexpr char const* filtered_filename = "log_using_buffered_file_handler_filtered.log";
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::thread frontend(
+    []()
+    {
+      quill::BufferedFileHandlerConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_pattern("%(logger_name) %(message)");
+
+      // the first handler receives the messages formatted directly into its buffer
+      std::shared_ptr<quill::Handler> file_handler = quill::buffered_file_handler(filename, cfg);
+
+      // a handler with a filter receives them via write()
+      std::shared_ptr<quill::Handler> filtered_file_handler =
+        quill::buffered_file_handler(filtered_filename, cfg);
+
+      class FilterOdd : public quill::FilterBase
+      {
+      public:
+        FilterOdd() : quill::FilterBase("FilterOdd") {}
+
+        QUILL_NODISCARD bool filter(char const*, std::chrono::nanoseconds, quill::MacroMetadata const&,
+                                    quill::fmt_buffer_t const& formatted_record) noexcept override
+        {
+          std::string_view const record{formatted_record.data(), formatted_record.size()};
+          return record.find("odd") == std::string_view::npos;
+        }
+      };
+
+      filtered_file_handler->add_filter(std::make_unique<FilterOdd>());
+
+      quill::Logger* logger = quill::create_logger(
+        "buffered_logger", {std::move(file_handler), std::move(filtered_file_handler)});
+
+      for (size_t i = 0; i < 100; ++i)
+      {
+        LOG_INFO(logger, "Hello {} {}", (i % 2 == 0) ? "even" : "odd", i);
+      }
+
+      quill::flush();
+
+      std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+      REQUIRE_EQ(file_contents.size(), 100);
+      REQUIRE_EQ(file_contents[0], std::string{"buffered_logger Hello even 0"});
+      REQUIRE_EQ(file_contents[99], std::string{"buffered_logger Hello odd 99"});
+
+      std::vector<std::string> const filtered_file_contents = quill::testing::file_contents(filtered_filename);
+      REQUIRE_EQ(filtered_file_contents.size(), 50);
+      REQUIRE_EQ(filtered_file_contents[49], std::string{"buffered_logger Hello even 98"});
+
+      quill::remove_logger(logger);
+    });
+
+  frontend.join();
+
+  quill::detail::remove_file(filename);
+  quill::detail::remove_file(filtered_filename);
+}
+
+/***/
+TEST_CASE("log_using_sanitizer")
+{
+  static constexpr char const* filename = "log_using_sanitizer.log";
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::thread frontend(
+    []()
+    {
+      quill::BufferedFileHandlerConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_pattern("%(logger_name) %(message)");
+
+      // the sanitized message is still formatted directly into the handler buffer
+      std::shared_ptr<quill::Handler> file_handler = quill::buffered_file_handler(filename, cfg);
+
+      quill::SanitizerConfig sanitizer_cfg;
+      sanitizer_cfg.set_redacted_digit_run(13);
+      file_handler->set_sanitizer(sanitizer_cfg);
+
+      quill::Logger* logger = quill::create_logger("sanitized_logger", std::move(file_handler));
+
+      LOG_INFO(logger, "user input {}", "name\nsanitized_logger fake record");
+      LOG_INFO(logger, "card {}", "4111 1111 1111 1111");
+
+      quill::flush();
+
+      std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+      REQUIRE_EQ(file_contents.size(), 2);
+      REQUIRE_EQ(file_contents[0], std::string{"sanitized_logger user input name\\nsanitized_logger fake record"});
+      REQUIRE_EQ(file_contents[1], std::string{"sanitized_logger card ****"});
+
+      quill::remove_logger(logger);
+    });
+
+  frontend.join();
+
+  quill::detail::remove_file(filename);
+}
+
+/***/
+TEST_CASE("log_using_sanitizer_epoch_timestamp")
+{
+  static constexpr char const* filename = "log_using_sanitizer_epoch_timestamp.log";
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::thread frontend(
+    []()
+    {
+      quill::FileHandlerConfig cfg;
+      cfg.set_open_mode('w');
+      cfg.set_pattern("%(ascii_time) %(message)", "%Qepoch_ns");
+
+      std::shared_ptr<quill::Handler> file_handler = quill::file_handler(filename, cfg);
+
+      quill::SanitizerConfig sanitizer_cfg;
+      sanitizer_cfg.set_redacted_digit_run(13);
+      file_handler->set_sanitizer(sanitizer_cfg);
+
+      quill::Logger* logger = quill::create_logger("sanitized_epoch_logger", std::move(file_handler));
+
+      LOG_INFO(logger, "card {}", "4111111111111111");
+      LOG_INFO(logger, "multi\nline");
+
+      quill::flush();
+
+      std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+      REQUIRE_EQ(file_contents.size(), 2);
+
+      // the 19 digits of the timestamp are not redacted, only the log message is sanitized
+      for (std::string const& line : file_contents)
+      {
+        REQUIRE_GT(line.size(), 20);
+        REQUIRE_EQ(line.find_first_not_of("0123456789"), 19);
+      }
+
+      REQUIRE_EQ(file_contents[0].substr(19), std::string{" card ****"});
+      REQUIRE_EQ(file_contents[1].substr(19), std::string{" multi\\nline"});
+
+      quill::remove_logger(logger);
+    });
+
+  frontend.join();
+
+  quill::detail::remove_file(filename);
+}
+
+/***/
+TEST_CASE("log_using_async_handler")
+{
+  static constexpr char const* filename = "log_using_async_handler.log";
+
+  // Start the logging backend thread
+  quill::start();
+
+  std::thread frontend(
+    []()
+    {
+      quill::FileHandlerConfig cfg;
+      cfg.set_open_mode('w');
+
+      std::shared_ptr<quill::Handler> async_handler = quill::async_handler(quill::file_handler(filename, cfg));
+
+      // the backend thread formats with the pattern of the async handler
+      async_handler->set_pattern("%(logger_name) %(message)");
+
+      quill::Logger* logger = quill::create_logger("async_logger", std::shared_ptr<quill::Handler>{async_handler});
+
+      for (size_t i = 0; i < 1000; ++i)
+      {
+        LOG_INFO(logger, "Hello from async handler {}", i);
+      }
+
+      // flush waits for the writer thread of the async handler
+      quill::flush();
+
+      std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+      REQUIRE_EQ(file_contents.size(), 1000);
+      REQUIRE_EQ(file_contents[0], std::string{"async_logger Hello from async handler 0"});
+      REQUIRE_EQ(file_contents[999], std::string{"async_logger Hello from async handler 999"});
+
+      auto const* handler = static_cast<quill::AsyncHandler const*>(async_handler.get());
+      REQUIRE_EQ(handler->dropped_messages(), 0);
+
+      quill::remove_logger(logger);
+    });
+
+  frontend.join();
+
+  quill::detail::remove_file(filename);
+}
+
 TEST_SUITE_END();
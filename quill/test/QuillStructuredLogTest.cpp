@@ -132,4 +132,53 @@ TEST_CASE("log_json_from_multiple_threads")
   test_quill_log(test_id, filename, filename_s, number_of_threads, number_of_messages);
 }
 
+/***/
+TEST_CASE("log_json_sanitized_structured_values")
+{
+  static constexpr char const* filename = "log_json_sanitized_structured_values.log";
+
+  quill::start();
+
+  std::shared_ptr<quill::Handler> json_handler =
+    quill::json_file_handler(filename,
+                             []()
+                             {
+                               quill::JsonFileHandlerConfig cfg;
+                               cfg.set_open_mode('w');
+                               return cfg;
+                             }());
+
+  quill::SanitizerConfig sanitizer_config;
+  sanitizer_config.add_redacted_literal("secret-api-key");
+  sanitizer_config.set_redacted_digit_run(12);
+  json_handler->set_sanitizer(sanitizer_config);
+
+  std::thread frontend(
+    [json_handler]() mutable
+    {
+      quill::Logger* logger = quill::create_logger("jlogger_sanitized", std::move(json_handler));
+
+      LOG_INFO(logger, "Payment with {card} and {api_key} by {user}", "4111 1111 1111 1111",
+               "secret-api-key", "line\nbreak");
+
+      // Let all log get flushed to the file
+      quill::flush();
+    });
+
+  json_handler.reset();
+  frontend.join();
+
+  quill::remove_logger(quill::get_logger("jlogger_sanitized"));
+
+  std::vector<std::string> const file_contents = quill::testing::file_contents(filename);
+
+  REQUIRE_EQ(file_contents.size(), 1);
+  REQUIRE(quill::testing::file_contains(
+    file_contents,
+    std::string{"\"message\": \"Payment with {card} and {api_key} by {user}\", \"card\": \"****\", "
+                "\"api_key\": \"****\", \"user\": \"line\\nbreak\""}));
+
+  quill::detail::remove_file(filename);
+}
+
 TEST_SUITE_END();
\ No newline at end of file
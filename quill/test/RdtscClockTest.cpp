@@ -1,8 +1,13 @@
 #include "doctest/doctest.h"
 
+#include "quill/detail/misc/Common.h"
 #include "quill/detail/misc/RdtscClock.h"
 #include "quill/detail/misc/Rdtsc.h"
 #include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <string>
 #include <thread>
 
 TEST_SUITE_BEGIN("RdtscClock");
@@ -25,6 +30,89 @@ void check_wall_time_now(quill::detail::RdtscClock const& tsc_clock)
   }
 }
 
+/**
+ * The calibration cache file is kept out of the working directory
+ */
+std::string calibration_cache_path(char const* filename)
+{
+  return (quill::fs::temp_directory_path() / filename).string();
+}
+
+TEST_CASE("wall_time_with_calibration_cache")
+{
+  // this test runs first as the tsc calibration happens only once per process
+  std::string const calibration_cache_path = ::calibration_cache_path("quill_wall_time_calibration_cache.txt");
+  std::remove(calibration_cache_path.data());
+
+  {
+    quill::detail::RdtscClock tsc_clock{std::chrono::milliseconds{700}, calibration_cache_path};
+    check_wall_time_now(tsc_clock);
+
+    // when the frequency was not reported by the cpu the calibration is cached
+    std::ifstream cache_file{calibration_cache_path};
+    if (cache_file.is_open())
+    {
+      double cached_ticks_per_ns{0};
+      cache_file >> cached_ticks_per_ns;
+      REQUIRE_EQ(doctest::Approx(1 / cached_ticks_per_ns), tsc_clock.nanoseconds_per_tick());
+    }
+  }
+
+  std::remove(calibration_cache_path.data());
+}
+
+TEST_CASE("calibration_cache_round_trip")
+{
+  using quill::detail::RdtscClock;
+
+  std::string const calibration_cache_path = ::calibration_cache_path("quill_round_trip_calibration_cache.txt");
+  std::remove(calibration_cache_path.data());
+
+  // a missing or invalid cache is not used
+  REQUIRE_EQ(RdtscClock::load_cached_ticks_per_ns(calibration_cache_path), 0);
+
+  {
+    std::ofstream cache_file{calibration_cache_path};
+    cache_file << "invalid\n";
+  }
+  REQUIRE_EQ(RdtscClock::load_cached_ticks_per_ns(calibration_cache_path), 0);
+
+  // the stored value is loaded back exactly
+  double const ticks_per_ns{2.9999876543210123};
+  RdtscClock::store_cached_ticks_per_ns(calibration_cache_path, ticks_per_ns);
+  REQUIRE_EQ(RdtscClock::load_cached_ticks_per_ns(calibration_cache_path), ticks_per_ns);
+
+  std::remove(calibration_cache_path.data());
+}
+
+TEST_CASE("calibrate_with_calibration_cache")
+{
+  using quill::detail::RdtscClock;
+
+  std::string const calibration_cache_path = ::calibration_cache_path("quill_calibrate_calibration_cache.txt");
+  std::remove(calibration_cache_path.data());
+
+  // without a reported frequency or a cache the full calibration is stored in the cache
+  double const calibrated_ticks_per_ns = RdtscClock::calibrate_ticks_per_ns(0, calibration_cache_path);
+  REQUIRE_GT(calibrated_ticks_per_ns, 0);
+  REQUIRE_EQ(RdtscClock::load_cached_ticks_per_ns(calibration_cache_path), calibrated_ticks_per_ns);
+
+  // the cached value is used when it agrees with a quick measurement, otherwise it is replaced
+  // by a new calibration
+  double const cached_ticks_per_ns = RdtscClock::calibrate_ticks_per_ns(0, calibration_cache_path);
+  REQUIRE_EQ(cached_ticks_per_ns, doctest::Approx(calibrated_ticks_per_ns).epsilon(0.001));
+  REQUIRE_EQ(RdtscClock::load_cached_ticks_per_ns(calibration_cache_path), cached_ticks_per_ns);
+
+  // a wrong reported frequency and a wrong cache are both rejected
+  RdtscClock::store_cached_ticks_per_ns(calibration_cache_path, calibrated_ticks_per_ns * 1.001);
+  double const recalibrated_ticks_per_ns =
+    RdtscClock::calibrate_ticks_per_ns(calibrated_ticks_per_ns * 0.999, calibration_cache_path);
+  REQUIRE_EQ(recalibrated_ticks_per_ns, doctest::Approx(calibrated_ticks_per_ns).epsilon(0.0005));
+  REQUIRE_EQ(RdtscClock::load_cached_ticks_per_ns(calibration_cache_path), recalibrated_ticks_per_ns);
+
+  std::remove(calibration_cache_path.data());
+}
+
 TEST_CASE("wall_time")
 {
   quill::detail::RdtscClock tsc_clock{std::chrono::milliseconds{700}};
@@ -38,4 +126,61 @@ TEST_CASE("wall_time")
   }
 }
 
+TEST_CASE("select_ticks_per_ns")
+{
+  using quill::detail::RdtscClock;
+
+  // a cpu reported frequency within the measurement noise is accepted
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(3.0, 0, 3.00002), 3.0);
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(3.0, 2.5, 2.99998), 3.0);
+
+  // a cpu reported frequency that disagrees with the measurement falls back to the cache
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(3.0, 3.0003, 3.0003), 3.0003);
+
+  // a full calibration is needed when nothing agrees with the measurement, a nominal frequency
+  // that is 0.01% off drifts 100us per second
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(3.0, 0, 3.0003), 0);
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(3.0, 0, 2.9997), 0);
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(3.0, 2.5, 2.97), 0);
+  REQUIRE_EQ(RdtscClock::select_ticks_per_ns(0, 0, 3.0), 0);
+}
+
+TEST_CASE("drift_stats")
+{
+  std::chrono::milliseconds const resync_interval{20};
+  quill::detail::RdtscClock tsc_clock{resync_interval, std::string{}, std::chrono::microseconds{1}};
+
+  // the constructor resync has no previous base to measure a drift against
+  REQUIRE_EQ(tsc_clock.drift_stats().resync_count, 0);
+  REQUIRE_EQ(tsc_clock.drift_stats().resync_interval.count(),
+             doctest::Approx(std::chrono::nanoseconds{resync_interval}.count()).epsilon(0.01));
+
+  uint64_t successful_resyncs{0};
+  for (size_t i = 0; i < 10; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    successful_resyncs += tsc_clock.resync(10000) ? 1 : 0;
+  }
+
+  auto const drift_stats = tsc_clock.drift_stats();
+  REQUIRE_EQ(drift_stats.resync_count, successful_resyncs);
+  REQUIRE_EQ(drift_stats.failed_resync_count, 10 - successful_resyncs);
+  REQUIRE_GE(drift_stats.max_drift, drift_stats.avg_drift);
+  REQUIRE_GE(drift_stats.max_drift.count(), std::abs(drift_stats.last_drift.count()));
+
+  // the adapted interval stays within bounds, only a failed resync backs off beyond the initial one
+  REQUIRE_GE(drift_stats.resync_interval, std::chrono::nanoseconds{resync_interval} / 65);
+  if (drift_stats.failed_resync_count == 0)
+  {
+    REQUIRE_LE(drift_stats.resync_interval.count(),
+               doctest::Approx(std::chrono::nanoseconds{resync_interval}.count()).epsilon(0.01));
+  }
+  else
+  {
+    REQUIRE_LE(drift_stats.resync_interval, std::chrono::nanoseconds{resync_interval} * 1024);
+  }
+
+  check_wall_time_now(tsc_clock);
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -3,7 +3,18 @@
 #include "misc/TestUtilities.h"
 #include "quill/detail/misc/Common.h"
 #include "quill/detail/misc/FileUtilities.h"
+#include "quill/detail/misc/Compression.h"
 #include "quill/handlers/RotatingFileHandler.h"
+#include <chrono>
+#include <thread>
+
+#if defined(QUILL_HAS_ZLIB)
+  #include <zlib.h>
+#endif
+
+#if defined(__linux__)
+  #include <sys/stat.h>
+#endif
 
 TEST_SUITE_BEGIN("RotatingFileHandler");
 
@@ -1921,4 +1932,325 @@ TEST_CASE("rotation_scheme_index_dont_remove_unrelated_files")
   remove_file(filename_other);
 }
 
+/***/
+TEST_CASE("async_rotation_scheme_index_with_backup_limit")
+{
+  fs::path const filename = "async_rotation_scheme_index_with_backup_limit.log";
+  fs::path const filename_1 = "async_rotation_scheme_index_with_backup_limit.1.log";
+  fs::path const filename_2 = "async_rotation_scheme_index_with_backup_limit.2.log";
+  fs::path const filename_3 = "async_rotation_scheme_index_with_backup_limit.3.log";
+  fs::path const filename_next = "async_rotation_scheme_index_with_backup_limit.next.log";
+
+  {
+    FileEventNotifier file_event_notifier;
+    file_event_notifier.after_open = [](fs::path const&, FILE* f) { fputs("Header\n", f); };
+
+    auto rfh = RotatingFileHandler{filename,
+                                   []()
+                                   {
+                                     RotatingFileHandlerConfig cfg;
+                                     cfg.set_rotation_max_file_size(1024);
+                                     cfg.set_max_backup_files(2);
+                                     cfg.set_async_rotation(true);
+                                     cfg.set_open_mode('w');
+                                     return cfg;
+                                   }(),
+                                   std::move(file_event_notifier)};
+
+    // write some records to the file
+    for (size_t i = 0; i < 6; ++i)
+    {
+      std::string s{"Record [" + std::to_string(i) + "]\n"};
+      fmt_buffer_t formatted_log_message;
+      formatted_log_message.append(s.data(), s.data() + s.size());
+
+      // Add a big string to rotate the file
+      std::string f;
+      f.resize(1024, 'x');
+      f.back() = '\n';
+      formatted_log_message.append(f.data(), f.data() + f.size());
+
+      rfh.write(formatted_log_message, quill::TransitEvent{});
+    }
+  }
+
+  // the pending renames are completed on destruction
+  REQUIRE(fs::exists(filename));
+  REQUIRE(fs::exists(filename_1));
+  REQUIRE(fs::exists(filename_2));
+  REQUIRE_FALSE(fs::exists(filename_3));
+  REQUIRE_FALSE(fs::exists(filename_next));
+
+  std::vector<std::string> const file_contents = testing::file_contents(filename);
+  REQUIRE_EQ(file_contents[0], std::string{"Header"});
+  REQUIRE_EQ(file_contents[1], std::string{"Record [5]"});
+
+  std::vector<std::string> const file_contents_1 = testing::file_contents(filename_1);
+  REQUIRE_EQ(file_contents_1[0], std::string{"Header"});
+  REQUIRE_EQ(file_contents_1[1], std::string{"Record [4]"});
+
+  std::vector<std::string> const file_contents_2 = testing::file_contents(filename_2);
+  REQUIRE_EQ(file_contents_2[0], std::string{"Header"});
+  REQUIRE_EQ(file_contents_2[1], std::string{"Record [3]"});
+
+  for (auto const& entry : fs::directory_iterator(fs::current_path()))
+  {
+    // no temporary rotated file is left behind
+    REQUIRE_EQ(entry.path().filename().string().find("async_rotation_scheme_index_with_backup_limit.rotating"),
+               std::string::npos);
+  }
+
+  remove_file(filename);
+  remove_file(filename_1);
+  remove_file(filename_2);
+}
+
+/***/
+TEST_CASE("compression_requires_gzip_support")
+{
+  RotatingFileHandlerConfig cfg;
+
+  if (!is_gzip_supported())
+  {
+    REQUIRE_THROWS_AS(cfg.set_compression(RotatingFileHandlerConfig::Compression::Gzip), QuillError);
+  }
+
+  REQUIRE_THROWS_AS(cfg.set_compression_frame_size(0), QuillError);
+}
+
+#if defined(QUILL_HAS_ZLIB)
+/**
+ * Reads a gzip file, including files of concatenated gzip members
+ */
+std::vector<std::string> gzip_file_contents(fs::path const& filename)
+{
+  gzFile file = gzopen(filename.string().data(), "rb");
+  REQUIRE(file);
+
+  std::string contents;
+  char buffer[4096];
+  int read;
+  while ((read = gzread(file, buffer, sizeof(buffer))) > 0)
+  {
+    contents.append(buffer, static_cast<size_t>(read));
+  }
+  gzclose(file);
+
+  std::vector<std::string> lines;
+  std::istringstream stream{contents};
+  for (std::string line; std::getline(stream, line);)
+  {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+/***/
+void test_compress_rotated_files(bool async_rotation)
+{
+  std::string const prefix = async_rotation ? "async_compress_rotated_files" : "compress_rotated_files";
+  fs::path const filename = prefix + ".log";
+  fs::path const filename_1 = prefix + ".1.log.gz";
+  fs::path const filename_2 = prefix + ".2.log.gz";
+  fs::path const filename_3 = prefix + ".3.log.gz";
+
+  {
+    RotatingFileHandlerConfig cfg;
+    cfg.set_rotation_max_file_size(1024);
+    cfg.set_max_backup_files(2);
+    cfg.set_async_rotation(async_rotation);
+    cfg.set_compression(RotatingFileHandlerConfig::Compression::Gzip);
+    cfg.set_open_mode('w');
+
+    auto rfh = RotatingFileHandler{filename, cfg, FileEventNotifier{}};
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+      std::string s{"Record [" + std::to_string(i) + "]\n"};
+      s.append(1024, 'x');
+      s.append("\n");
+
+      fmt_buffer_t formatted_log_message;
+      formatted_log_message.append(s.data(), s.data() + s.size());
+      rfh.write(formatted_log_message, quill::TransitEvent{});
+    }
+  }
+
+  REQUIRE(fs::exists(filename));
+  REQUIRE(fs::exists(filename_1));
+  REQUIRE(fs::exists(filename_2));
+  REQUIRE_FALSE(fs::exists(filename_3));
+  REQUIRE_FALSE(fs::exists(prefix + ".1.log"));
+
+  REQUIRE_EQ(testing::file_contents(filename)[0], std::string{"Record [5]"});
+  REQUIRE_EQ(gzip_file_contents(filename_1)[0], std::string{"Record [4]"});
+  REQUIRE_EQ(gzip_file_contents(filename_2)[0], std::string{"Record [3]"});
+
+  remove_file(filename);
+  remove_file(filename_1);
+  remove_file(filename_2);
+}
+
+/***/
+TEST_CASE("compress_rotated_files")
+{
+  test_compress_rotated_files(false);
+}
+
+/***/
+TEST_CASE("async_rotation_compress_rotated_files")
+{
+  test_compress_rotated_files(true);
+}
+
+/***/
+TEST_CASE("gzip_stream_compression")
+{
+  fs::path const filename = "gzip_stream_compression.log.gz";
+  fs::path const filename_1 = "gzip_stream_compression.log.1.gz";
+
+  {
+    RotatingFileHandlerConfig cfg;
+    cfg.set_rotation_max_file_size(64 * 1024);
+    cfg.set_compression(RotatingFileHandlerConfig::Compression::GzipStream);
+    cfg.set_compression_frame_size(4096);
+    cfg.set_open_mode('w');
+
+    auto rfh = RotatingFileHandler{filename, cfg, FileEventNotifier{}};
+
+    for (size_t i = 0; i < 6000; ++i)
+    {
+      std::string const s{"Record [" + std::to_string(i) + "]\n"};
+      fmt_buffer_t formatted_log_message;
+      formatted_log_message.append(s.data(), s.data() + s.size());
+      rfh.write(formatted_log_message, quill::TransitEvent{});
+
+      if (i == 10)
+      {
+        // a flush cuts a frame
+        rfh.flush();
+      }
+    }
+  }
+
+  // the rotation is based on the uncompressed size
+  std::vector<std::string> file_contents_1 = gzip_file_contents(filename_1);
+  std::vector<std::string> const file_contents = gzip_file_contents(filename);
+  file_contents_1.insert(file_contents_1.end(), file_contents.begin(), file_contents.end());
+
+  REQUIRE_EQ(file_contents_1.size(), 6000);
+  for (size_t i = 0; i < 6000; ++i)
+  {
+    REQUIRE_EQ(file_contents_1[i], std::string{"Record [" + std::to_string(i) + "]"});
+  }
+
+  remove_file(filename);
+  remove_file(filename_1);
+}
+
+/***/
+TEST_CASE("gzip_stream_compression_idle_flush")
+{
+  fs::path const filename = "gzip_stream_compression_idle_flush.log.gz";
+
+  {
+    RotatingFileHandlerConfig cfg;
+    cfg.set_compression(RotatingFileHandlerConfig::Compression::GzipStream);
+    cfg.set_compression_frame_interval(std::chrono::milliseconds{50});
+    cfg.set_open_mode('w');
+
+    auto rfh = RotatingFileHandler{filename, cfg, FileEventNotifier{}};
+
+    auto write_records = [&rfh](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        std::string const s{"Record [" + std::to_string(i) + "]\n"};
+        fmt_buffer_t formatted_log_message;
+        formatted_log_message.append(s.data(), s.data() + s.size());
+        rfh.write(formatted_log_message, quill::TransitEvent{});
+      }
+    };
+
+    write_records(0, 10);
+
+    // a young frame is kept on the idle flush
+    rfh.idle_flush();
+    rfh.run_loop();
+    REQUIRE_EQ(quill::detail::file_size(filename), 0);
+
+    // the run loop writes the frame once it is older than the interval
+    std::this_thread::sleep_for(std::chrono::milliseconds{60});
+    rfh.run_loop();
+    REQUIRE_EQ(gzip_file_contents(filename).size(), 10);
+
+    // an explicit flush always writes the frame, the compressor is reused for the next member
+    write_records(10, 15);
+    rfh.flush();
+
+    std::vector<std::string> const file_contents = gzip_file_contents(filename);
+    REQUIRE_EQ(file_contents.size(), 15);
+    for (size_t i = 0; i < 15; ++i)
+    {
+      REQUIRE_EQ(file_contents[i], std::string{"Record [" + std::to_string(i) + "]"});
+    }
+  }
+
+  remove_file(filename);
+}
+#endif
+
+/***/
+TEST_CASE("rotation_with_preallocation")
+{
+  fs::path const filename = "rotation_with_preallocation.log";
+  fs::path const filename_1 = "rotation_with_preallocation.1.log";
+  size_t constexpr max_file_size = 64 * 1024;
+  std::string const s{"Record\n"};
+
+  {
+    RotatingFileHandlerConfig cfg;
+    cfg.set_rotation_max_file_size(max_file_size);
+    cfg.set_preallocate(true);
+    cfg.set_open_mode('w');
+
+    auto rfh = RotatingFileHandler{filename, cfg, FileEventNotifier{}};
+
+    fmt_buffer_t formatted_log_message;
+    formatted_log_message.append(s.data(), s.data() + s.size());
+    rfh.write(formatted_log_message, quill::TransitEvent{});
+    rfh.flush();
+
+    // the preallocation does not change the file size
+    REQUIRE_EQ(fs::file_size(filename), s.size());
+
+#if defined(__linux__)
+    struct stat st;
+    REQUIRE_EQ(::stat(filename.string().data(), &st), 0);
+
+    // the maximum file size is reserved
+    REQUIRE_GE(static_cast<size_t>(st.st_blocks) * 512, max_file_size);
+#endif
+
+    // rotate the file
+    for (size_t i = 0; i < (max_file_size / s.size()); ++i)
+    {
+      rfh.write(formatted_log_message, quill::TransitEvent{});
+    }
+  }
+
+  REQUIRE_EQ(fs::file_size(filename_1), (max_file_size / s.size()) * s.size());
+  REQUIRE_EQ(fs::file_size(filename), s.size());
+
+#if defined(__linux__)
+  // the unused blocks are released on close
+  struct stat st;
+  REQUIRE_EQ(::stat(filename.string().data(), &st), 0);
+  REQUIRE_LT(static_cast<size_t>(st.st_blocks) * 512, max_file_size);
+#endif
+
+  remove_file(filename);
+  remove_file(filename_1);
+}
+
 TEST_SUITE_END();
\ No newline at end of file
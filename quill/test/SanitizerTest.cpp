@@ -0,0 +1,124 @@
+#include "doctest/doctest.h"
+
+#include "quill/QuillError.h"
+#include "quill/Sanitizer.h"
+#include <string>
+#include <string_view>
+
+TEST_SUITE_BEGIN("Sanitizer");
+
+using namespace quill;
+
+namespace
+{
+/***/
+std::string sanitize(Sanitizer& sanitizer, std::string const& record)
+{
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(record.data(), record.data() + record.size());
+
+  fmtquill::detail::buffer<char> const& result = sanitizer.sanitize(formatted_log_message);
+  return std::string{result.data(), result.size()};
+}
+} // namespace
+
+/***/
+TEST_CASE("escape_control_characters")
+{
+  Sanitizer sanitizer{SanitizerConfig{}};
+
+  REQUIRE_EQ(sanitize(sanitizer, "line one\nfake record\n"), std::string{"line one\\nfake record\n"});
+  REQUIRE_EQ(sanitize(sanitizer, "a\rb\tc\x1b[31md\x7f\n"), std::string{"a\\rb\\tc\\x1B[31md\\x7F\n"});
+
+  // utf-8 is left alone
+  REQUIRE_EQ(sanitize(sanitizer, "caf\xc3\xa9\n"), std::string{"caf\xc3\xa9\n"});
+
+  // only the terminating newline is kept
+  REQUIRE_EQ(sanitize(sanitizer, "\n\n"), std::string{"\\n\n"});
+  REQUIRE_EQ(sanitize(sanitizer, ""), std::string{});
+}
+
+/***/
+TEST_CASE("clean_record_is_not_copied")
+{
+  SanitizerConfig cfg;
+  cfg.set_redacted_digit_run(13);
+  cfg.add_redacted_literal("secret");
+
+  Sanitizer sanitizer{cfg};
+
+  std::string const record{"12:00:00.123456789 [1234] main.cpp:10 LOG_INFO root a clean log message\n"};
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(record.data(), record.data() + record.size());
+
+  REQUIRE_EQ(&sanitizer.sanitize(formatted_log_message), &formatted_log_message);
+}
+
+/***/
+TEST_CASE("redact_literals")
+{
+  SanitizerConfig cfg;
+  cfg.add_redacted_literal("sk_live_abc123");
+  cfg.add_redacted_literal("hunter2");
+  cfg.set_redaction_mask("[redacted]");
+
+  Sanitizer sanitizer{cfg};
+
+  REQUIRE_EQ(sanitize(sanitizer, "key=sk_live_abc123 password=hunter2 hunter\n"),
+             std::string{"key=[redacted] password=[redacted] hunter\n"});
+
+  // a partial literal at the end of the message
+  REQUIRE_EQ(sanitize(sanitizer, "sk_live_abc\n"), std::string{"sk_live_abc\n"});
+
+  REQUIRE_THROWS_AS(cfg.add_redacted_literal(""), QuillError);
+}
+
+/***/
+TEST_CASE("redact_digit_runs")
+{
+  SanitizerConfig cfg;
+  cfg.set_redacted_digit_run(13);
+
+  Sanitizer sanitizer{cfg};
+
+  REQUIRE_EQ(sanitize(sanitizer, "card 4111111111111111 ok\n"), std::string{"card **** ok\n"});
+  REQUIRE_EQ(sanitize(sanitizer, "card 4111 1111 1111 1111 ok\n"), std::string{"card **** ok\n"});
+  REQUIRE_EQ(sanitize(sanitizer, "card 4111-1111-1111-1111\n"), std::string{"card ****\n"});
+
+  // short runs and runs broken by two separators are kept
+  REQUIRE_EQ(sanitize(sanitizer, "id 123456789012 port 8080\n"), std::string{"id 123456789012 port 8080\n"});
+  REQUIRE_EQ(sanitize(sanitizer, "1234567  1234567\n"), std::string{"1234567  1234567\n"});
+}
+
+/***/
+TEST_CASE("long_records")
+{
+  // longer than the simd width with work at every position of a vector
+  SanitizerConfig cfg;
+  cfg.set_redacted_digit_run(16);
+  cfg.add_redacted_literal("token");
+
+  Sanitizer sanitizer{cfg};
+
+  for (size_t offset = 0; offset < 70; ++offset)
+  {
+    std::string const padding(offset, 'a');
+    std::string const record = padding + "\x01" + padding + "token" + padding + "1234567812345678" + padding + "\n";
+    std::string const expected = padding + "\\x01" + padding + "****" + padding + "****" + padding + "\n";
+
+    REQUIRE_EQ(sanitize(sanitizer, record), expected);
+  }
+}
+
+/***/
+TEST_CASE("disabled_sanitizer")
+{
+  SanitizerConfig cfg;
+  cfg.set_escape_control_characters(false);
+
+  Sanitizer sanitizer{cfg};
+
+  REQUIRE_EQ(sanitize(sanitizer, "a\nb\n"), std::string{"a\nb\n"});
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,351 @@
+#include "doctest/doctest.h"
+
+#include "quill/detail/misc/Common.h"
+#include "quill/handlers/SocketHandler.h"
+#include <cstdio>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+  #include <arpa/inet.h>
+  #include <netinet/in.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+TEST_SUITE_BEGIN("SocketHandler");
+
+using namespace quill;
+
+#if !defined(_WIN32)
+namespace
+{
+/***/
+int bind_unix_socket(std::string const& path, int type)
+{
+  ::unlink(path.data());
+
+  int const fd = ::socket(AF_UNIX, type, 0);
+  REQUIRE_NE(fd, -1);
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.data());
+  REQUIRE_EQ(::bind(fd, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)), 0);
+
+  // never wait forever in the tests
+  timeval timeout{5, 0};
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  return fd;
+}
+
+/***/
+void write_record(SocketHandler& handler, std::string const& record)
+{
+  fmt_buffer_t formatted_log_message;
+  formatted_log_message.append(record.data(), record.data() + record.size());
+  handler.write(formatted_log_message, quill::TransitEvent{});
+}
+
+/***/
+std::vector<std::string> receive_datagrams(int fd, size_t expected_bytes)
+{
+  std::vector<std::string> datagrams;
+  size_t received{0};
+  char buffer[65536];
+
+  while (received < expected_bytes)
+  {
+    auto const res = ::recv(fd, buffer, sizeof(buffer), 0);
+    REQUIRE_GT(res, 0);
+    datagrams.emplace_back(buffer, static_cast<size_t>(res));
+    received += static_cast<size_t>(res);
+  }
+
+  return datagrams;
+}
+} // namespace
+
+/***/
+TEST_CASE("unix_stream_socket")
+{
+  std::string const path{"socket_handler_stream.sock"};
+  int const listener = bind_unix_socket(path, SOCK_STREAM);
+  REQUIRE_EQ(::listen(listener, 1), 0);
+
+  SocketHandlerConfig cfg;
+  cfg.set_socket_type(SocketHandlerConfig::SocketType::UnixStream);
+  cfg.set_address(path);
+  cfg.set_max_frame_size(1024);
+
+  std::string expected;
+
+  {
+    SocketHandler handler{cfg};
+    REQUIRE(handler.is_connected());
+
+    int const fd = ::accept(listener, nullptr, nullptr);
+    REQUIRE_NE(fd, -1);
+
+    for (size_t i = 0; i < 5000; ++i)
+    {
+      std::string const record{"Record [" + std::to_string(i) + "]\n"};
+      expected += record;
+      write_record(handler, record);
+
+      // the backend flushes when idle, the collector reads concurrently
+      if (i % 1000 == 0)
+      {
+        handler.flush();
+      }
+    }
+
+    handler.flush();
+
+    std::string received;
+    char buffer[65536];
+
+    while (received.size() < expected.size())
+    {
+      auto const res = ::recv(fd, buffer, sizeof(buffer), 0);
+      REQUIRE_GT(res, 0);
+      received.append(buffer, static_cast<size_t>(res));
+
+      // sends that would have blocked are retried on flush
+      handler.flush();
+    }
+
+    REQUIRE_EQ(received, expected);
+    REQUIRE_EQ(handler.dropped_messages(), 0);
+    ::close(fd);
+  }
+
+  ::close(listener);
+  ::unlink(path.data());
+}
+
+/***/
+TEST_CASE("unix_stream_socket_reconnect")
+{
+  std::string const path{"socket_handler_reconnect.sock"};
+  int listener = bind_unix_socket(path, SOCK_STREAM);
+  REQUIRE_EQ(::listen(listener, 1), 0);
+
+  SocketHandlerConfig cfg;
+  cfg.set_socket_type(SocketHandlerConfig::SocketType::UnixStream);
+  cfg.set_address(path);
+  cfg.set_max_frame_size(64 * 1024);
+
+  constexpr size_t record_size{1000};
+  constexpr size_t records{1000};
+
+  SocketHandler handler{cfg};
+  REQUIRE(handler.is_connected());
+
+  int fd = ::accept(listener, nullptr, nullptr);
+  REQUIRE_NE(fd, -1);
+
+  for (size_t i = 0; i < records; ++i)
+  {
+    std::string record{"Record [" + std::to_string(i) + "]"};
+    record.resize(record_size - 1, '.');
+    record += '\n';
+    write_record(handler, record);
+  }
+
+  // the collector goes away after receiving only a part of the records
+  size_t first_connection_bytes{0};
+  char buffer[65536];
+
+  while (true)
+  {
+    auto const res = ::recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (res <= 0)
+    {
+      break;
+    }
+    first_connection_bytes += static_cast<size_t>(res);
+  }
+
+  REQUIRE_LT(first_connection_bytes, records * record_size);
+
+  ::close(fd);
+  ::close(listener);
+
+  listener = bind_unix_socket(path, SOCK_STREAM);
+  REQUIRE_EQ(::listen(listener, 1), 0);
+
+  // wait for the reconnect interval
+  std::this_thread::sleep_for(std::chrono::milliseconds{1100});
+
+  // the first send fails on the lost connection, the second one reconnects
+  handler.flush();
+  handler.flush();
+  REQUIRE(handler.is_connected());
+
+  fd = ::accept(listener, nullptr, nullptr);
+  REQUIRE_NE(fd, -1);
+
+  // a record cut by the lost connection is dropped, the new connection starts at a record
+  bool const record_cut = (first_connection_bytes % record_size) != 0;
+  size_t const first_record = first_connection_bytes / record_size + (record_cut ? 1 : 0);
+  REQUIRE_EQ(handler.dropped_messages(), record_cut ? 1 : 0);
+
+  std::string received;
+  size_t const expected_bytes = (records - first_record) * record_size;
+
+  while (received.size() < expected_bytes)
+  {
+    handler.flush();
+
+    auto const res = ::recv(fd, buffer, sizeof(buffer), 0);
+    REQUIRE_GT(res, 0);
+    received.append(buffer, static_cast<size_t>(res));
+  }
+
+  REQUIRE_EQ(received.size(), expected_bytes);
+
+  for (size_t i = first_record; i < records; ++i)
+  {
+    std::string const prefix{"Record [" + std::to_string(i) + "]"};
+    REQUIRE_EQ(received.compare((i - first_record) * record_size, prefix.size(), prefix), 0);
+  }
+
+  ::close(fd);
+  ::close(listener);
+  ::unlink(path.data());
+}
+
+/***/
+TEST_CASE("unix_datagram_socket_frames")
+{
+  std::string const path{"socket_handler_datagram.sock"};
+  int const receiver = bind_unix_socket(path, SOCK_DGRAM);
+
+  SocketHandlerConfig cfg;
+  cfg.set_socket_type(SocketHandlerConfig::SocketType::UnixDatagram);
+  cfg.set_address(path);
+  cfg.set_max_frame_size(256);
+
+  std::string expected;
+
+  {
+    SocketHandler handler{cfg};
+    REQUIRE(handler.is_connected());
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+      std::string const record{"Record [" + std::to_string(i) + "]\n"};
+      expected += record;
+      write_record(handler, record);
+    }
+
+    // bigger than a datagram
+    write_record(handler, std::string(300, 'x'));
+    REQUIRE_EQ(handler.dropped_messages(), 1);
+
+    handler.flush();
+  }
+
+  std::vector<std::string> const datagrams = receive_datagrams(receiver, expected.size());
+
+  // the records are packed into frames and never split
+  REQUIRE_LT(datagrams.size(), 20);
+
+  std::string received;
+  for (auto const& datagram : datagrams)
+  {
+    REQUIRE_LE(datagram.size(), 256);
+    REQUIRE_EQ(datagram.back(), '\n');
+    received += datagram;
+  }
+
+  REQUIRE_EQ(received, expected);
+
+  ::close(receiver);
+  ::unlink(path.data());
+}
+
+/***/
+TEST_CASE("udp_socket")
+{
+  int const receiver = ::socket(AF_INET, SOCK_DGRAM, 0);
+  REQUIRE_NE(receiver, -1);
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = 0;
+  ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+  REQUIRE_EQ(::bind(receiver, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)), 0);
+
+  socklen_t addr_len = sizeof(addr);
+  REQUIRE_EQ(::getsockname(receiver, reinterpret_cast<sockaddr*>(&addr), &addr_len), 0);
+
+  timeval timeout{5, 0};
+  ::setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  SocketHandlerConfig cfg;
+  cfg.set_socket_type(SocketHandlerConfig::SocketType::Udp);
+  cfg.set_address("127.0.0.1");
+  cfg.set_port(ntohs(addr.sin_port));
+  cfg.set_max_frame_size(512);
+
+  std::string expected;
+
+  {
+    SocketHandler handler{cfg};
+    REQUIRE(handler.is_connected());
+
+    for (size_t i = 0; i < 200; ++i)
+    {
+      std::string const record{"Record [" + std::to_string(i) + "]\n"};
+      expected += record;
+      write_record(handler, record);
+    }
+
+    handler.flush();
+  }
+
+  std::string received;
+  for (auto const& datagram : receive_datagrams(receiver, expected.size()))
+  {
+    REQUIRE_LE(datagram.size(), 512);
+    received += datagram;
+  }
+
+  REQUIRE_EQ(received, expected);
+
+  ::close(receiver);
+}
+
+/***/
+TEST_CASE("drop_when_not_connected")
+{
+  std::string const path{"socket_handler_no_listener.sock"};
+  ::unlink(path.data());
+
+  SocketHandlerConfig cfg;
+  cfg.set_socket_type(SocketHandlerConfig::SocketType::UnixStream);
+  cfg.set_address(path);
+  cfg.set_buffer_size(1024);
+
+  SocketHandler handler{cfg};
+  REQUIRE_FALSE(handler.is_connected());
+
+  for (size_t i = 0; i < 100; ++i)
+  {
+    // 20 bytes each, 51 records fit in the buffer
+    write_record(handler, std::string(19, 'a') + "\n");
+  }
+
+  handler.flush();
+
+  REQUIRE_EQ(handler.dropped_messages(), 49);
+}
+#endif
+
+TEST_SUITE_END();
@@ -4,6 +4,7 @@
 #include "quill/detail/ThreadContext.h"
 #include "quill/detail/ThreadContextCollection.h"
 #include <array>
+#include <string>
 #include <thread>
 
 TEST_SUITE_BEGIN("ThreadContextCollection");
@@ -192,4 +193,56 @@ TEST_CASE("add_remove_thread_context_multithreaded_dont_wait_for_threads_to_join
   }
 }
 
+/***/
+TEST_CASE("reuse_thread_context_of_exited_thread")
+{
+  Config cfg;
+  ThreadContextCollection thread_context_collection{cfg};
+
+  ThreadContext* first_thread_context{nullptr};
+  std::string first_thread_id;
+
+  std::thread first_thread(
+    [&]()
+    {
+      first_thread_context = thread_context_collection.local_thread_context<QUILL_QUEUE_TYPE>();
+      first_thread_id = first_thread_context->thread_id();
+
+      // counted but never reported by the backend thread
+      first_thread_context->increment_message_failure_counter();
+      first_thread_context->increment_shed_message_counter();
+    });
+
+  first_thread.join();
+
+  // the backend thread sees the exited thread and pools its context
+  REQUIRE_EQ(thread_context_collection.backend_thread_contexts_cache().size(), 1);
+  thread_context_collection.clear_invalid_and_empty_thread_contexts();
+  REQUIRE(thread_context_collection.backend_thread_contexts_cache().empty());
+
+  ThreadContext* second_thread_context{nullptr};
+  std::string second_thread_id;
+
+  std::thread second_thread(
+    [&]()
+    {
+      second_thread_context = thread_context_collection.local_thread_context<QUILL_QUEUE_TYPE>();
+      second_thread_id = second_thread_context->thread_id();
+      REQUIRE(second_thread_context->is_valid());
+    });
+
+  second_thread.join();
+
+  // the new thread got the pooled context with its own thread id
+  REQUIRE_EQ(second_thread_context, first_thread_context);
+  REQUIRE_NE(second_thread_id, first_thread_id);
+  REQUIRE_EQ(second_thread_id, std::string{second_thread_context->thread_id()});
+  REQUIRE_EQ(thread_context_collection.backend_thread_contexts_cache().size(), 1);
+  REQUIRE(second_thread_context->spsc_queue<QUILL_QUEUE_TYPE>().empty());
+
+  // the counters of the exited thread are not reported for the new thread
+  REQUIRE_EQ(second_thread_context->get_and_reset_message_failure_counter(), 0);
+  REQUIRE_EQ(second_thread_context->get_and_reset_shed_message_counter(), 0);
+}
+
 TEST_SUITE_END();
\ No newline at end of file
@@ -180,4 +180,65 @@ TEST_CASE("format_string_with_nanosecond_precision")
   }
 }
 
+/***/
+TEST_CASE("format_string_epoch")
+{
+  const std::chrono::nanoseconds timestamp{1587161887987654321};
+
+  {
+    TimestampFormatter ts_formatter{"%Qepoch_ms"};
+    REQUIRE_EQ(ts_formatter.format_timestamp(timestamp), std::string_view{"1587161887987"});
+  }
+
+  {
+    TimestampFormatter ts_formatter{"%Qepoch_us"};
+    REQUIRE_EQ(ts_formatter.format_timestamp(timestamp), std::string_view{"1587161887987654"});
+  }
+
+  {
+    TimestampFormatter ts_formatter{"%Qepoch_ns"};
+    REQUIRE_EQ(ts_formatter.format_timestamp(timestamp), std::string_view{"1587161887987654321"});
+  }
+
+#if !defined(QUILL_NO_EXCEPTIONS)
+  // can not be combined with other specifiers
+  REQUIRE_THROWS_AS(TimestampFormatter ts_formatter{"%H %Qepoch_ns"}, quill::QuillError);
+  REQUIRE_THROWS_AS(TimestampFormatter ts_formatter{"%Qiso8601_ms %Qms"}, quill::QuillError);
+#endif
+}
+
+/***/
+TEST_CASE("format_string_iso8601")
+{
+  {
+    TimestampFormatter ts_formatter{"%Qiso8601_ms"};
+    REQUIRE_EQ(ts_formatter.format_timestamp(std::chrono::nanoseconds{1587161887987654321}),
+               std::string_view{"2020-04-17T22:18:07.987Z"});
+  }
+
+  {
+    TimestampFormatter ts_formatter{"%Qiso8601_us", quill::Timezone::LocalTime};
+    REQUIRE_EQ(ts_formatter.format_timestamp(std::chrono::nanoseconds{1587161887987654321}),
+               std::string_view{"2020-04-17T22:18:07.987654Z"});
+  }
+
+  {
+    TimestampFormatter ts_formatter{"%Qiso8601_ns"};
+    REQUIRE_EQ(ts_formatter.format_timestamp(std::chrono::nanoseconds{1587161887000000009}),
+               std::string_view{"2020-04-17T22:18:07.000000009Z"});
+
+    // same day, only the time is patched
+    REQUIRE_EQ(ts_formatter.format_timestamp(std::chrono::nanoseconds{1587167999999999999}),
+               std::string_view{"2020-04-17T23:59:59.999999999Z"});
+
+    // next day, the date is recalculated
+    REQUIRE_EQ(ts_formatter.format_timestamp(std::chrono::nanoseconds{1587168000000000000}),
+               std::string_view{"2020-04-18T00:00:00.000000000Z"});
+
+    // going back in time
+    REQUIRE_EQ(ts_formatter.format_timestamp(std::chrono::nanoseconds{1577836799123456789}),
+               std::string_view{"2019-12-31T23:59:59.123456789Z"});
+  }
+}
+
 TEST_SUITE_END();
\ No newline at end of file